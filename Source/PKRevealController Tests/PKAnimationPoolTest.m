@@ -0,0 +1,212 @@
+//
+//  PKAnimationPoolTest.m
+//  PKRevealController
+//
+//  Copyright (c) 2015 zuui.org (Philip Kluz). All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+#import <objc/runtime.h>
+
+#import "PKAnimationPool.h"
+#import "PKTimingCurve.h"
+
+/// The objects a keyframe transition with one segment hands to Core Animation: the start and end values and their two key times.
+static const NSUInteger kPKAnimationPoolTestBoxedValuesPerTransition = 4;
+
+static NSUInteger PKAnimationPoolTestKeyframeAnimationCount = 0;
+static NSUInteger PKAnimationPoolTestTimingFunctionCount = 0;
+
+@interface PKSequentialAnimation (PKAnimationPoolTest)
+
+- (void)animationDidStop:(CAAnimation *)anim finished:(BOOL)flag;
+
+@end
+
+@implementation CAKeyframeAnimation (PKAnimationPoolTest)
+
++ (instancetype)pk_countedAnimation
+{
+    PKAnimationPoolTestKeyframeAnimationCount++;
+    return [self pk_countedAnimation];
+}
+
+@end
+
+@implementation CAMediaTimingFunction (PKAnimationPoolTest)
+
++ (instancetype)pk_countedFunctionWithName:(NSString *)name
+{
+    PKAnimationPoolTestTimingFunctionCount++;
+    return [self pk_countedFunctionWithName:name];
+}
+
++ (instancetype)pk_countedFunctionWithControlPoints:(float)c1x :(float)c1y :(float)c2x :(float)c2y
+{
+    PKAnimationPoolTestTimingFunctionCount++;
+    return [self pk_countedFunctionWithControlPoints:c1x :c1y :c2x :c2y];
+}
+
+@end
+
+/// Exchanges two class methods of a class. An inherited method is copied onto the class first, such that its superclasses are not affected.
+static void PKAnimationPoolTestExchangeClassMethods(Class class, SEL original, SEL replacement)
+{
+    Method originalMethod = class_getClassMethod(class, original);
+    class_addMethod(object_getClass(class), original, method_getImplementation(originalMethod), method_getTypeEncoding(originalMethod));
+    method_exchangeImplementations(class_getClassMethod(class, original), class_getClassMethod(class, replacement));
+}
+
+static void PKAnimationPoolTestExchangeCountingMethods(void)
+{
+    PKAnimationPoolTestExchangeClassMethods([CAKeyframeAnimation class], @selector(animation), @selector(pk_countedAnimation));
+    PKAnimationPoolTestExchangeClassMethods([CAMediaTimingFunction class], @selector(functionWithName:), @selector(pk_countedFunctionWithName:));
+    PKAnimationPoolTestExchangeClassMethods([CAMediaTimingFunction class], @selector(functionWithControlPoints::::), @selector(pk_countedFunctionWithControlPoints::::));
+}
+
+@interface PKAnimationPoolTest : XCTestCase
+
+@property CALayer *layer;
+@property PKAnimationPool *pool;
+
+@end
+
+@implementation PKAnimationPoolTest
+
++ (void)setUp {
+    [super setUp];
+    PKAnimationPoolTestExchangeCountingMethods();
+}
+
++ (void)tearDown {
+    // Exchanging again restores the original implementations.
+    PKAnimationPoolTestExchangeCountingMethods();
+    [super tearDown];
+}
+
+- (void)setUp {
+    [super setUp];
+    
+    self.layer = [CALayer layer];
+    self.layer.position = CGPointMake(160.0, 0.0);
+    self.pool = [PKAnimationPool poolWithCapacity:2];
+}
+
+- (void)tearDown {
+    [self.layer removeAllAnimations];
+    [super tearDown];
+}
+
+#pragma mark - Reuse
+- (void)testThatOpenCloseCyclesReusePooledAnimations
+{
+    // given
+    NSArray *open = @[[NSValue valueWithCGPoint:CGPointMake(420.0, 0.0)]];
+    NSArray *close = @[[NSValue valueWithCGPoint:CGPointMake(160.0, 0.0)]];
+    NSMutableSet *keys = [NSMutableSet set];
+    __block NSUInteger completionCount = 0;
+    
+    // when
+    for (NSUInteger cycle = 0; cycle < 20; cycle++)
+    {
+        PKSequentialAnimation *animation = [self.pool sequentialAnimationForKeyPath:@"position"
+                                                                             values:((cycle % 2) ? close : open)
+                                                                           duration:1.0];
+        animation.mode = PKSequentialAnimationModeKeyframe;
+        animation.completionHandler = ^(BOOL finished)
+        {
+            completionCount++;
+        };
+        
+        [animation startAnimationOnLayer:self.layer];
+        XCTAssertTrue(animation.isInUse);
+        
+        NSString *key = [self.layer.animationKeys firstObject];
+        [keys addObject:key];
+        [animation animationDidStop:[self.layer animationForKey:key] finished:YES];
+        
+        XCTAssertFalse(animation.isInUse);
+    }
+    
+    // then
+    XCTAssertEqual(self.pool.allocationCount, 2);
+    XCTAssertEqual([keys count], 1);
+    XCTAssertEqual(completionCount, 20);
+}
+
+- (void)testThatOpenCloseCyclesDoNotAllocateInSteadyState
+{
+    // given
+    NSArray *open = @[[NSValue valueWithCGPoint:CGPointMake(420.0, 0.0)]];
+    NSArray *close = @[[NSValue valueWithCGPoint:CGPointMake(160.0, 0.0)]];
+    PKTimingCurve *timingCurve = [PKTimingCurve easeInEaseOutCurve];
+    NSHashTable *addedAnimations = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    NSUInteger keyframeAnimationCount = 0;
+    NSUInteger timingFunctionCount = 0;
+    
+    // when
+    for (NSUInteger cycle = 0; cycle < 24; cycle++)
+    {
+        // The first cycle with and the first cycle without a timing curve prepare the animation, 20 steady state cycles follow.
+        if (cycle == 4)
+        {
+            keyframeAnimationCount = PKAnimationPoolTestKeyframeAnimationCount;
+            timingFunctionCount = PKAnimationPoolTestTimingFunctionCount;
+        }
+        
+        PKSequentialAnimation *animation = [self.pool sequentialAnimationForKeyPath:@"position"
+                                                                             values:((cycle % 2) ? close : open)
+                                                                           duration:1.0];
+        animation.mode = PKSequentialAnimationModeKeyframe;
+        animation.timingCurve = (cycle % 4 < 2) ? timingCurve : nil;
+        
+        [animation startAnimationOnLayer:self.layer];
+        
+        NSString *key = [self.layer.animationKeys firstObject];
+        CAKeyframeAnimation *addedAnimation = (CAKeyframeAnimation *)[self.layer animationForKey:key];
+        
+        XCTAssertEqual([self.layer.animationKeys count], 1);
+        XCTAssertLessThanOrEqual([addedAnimation.values count] + [addedAnimation.keyTimes count], kPKAnimationPoolTestBoxedValuesPerTransition);
+        [addedAnimations addObject:addedAnimation];
+        
+        [animation animationDidStop:addedAnimation finished:YES];
+    }
+    
+    // then
+    XCTAssertEqual(PKAnimationPoolTestKeyframeAnimationCount, keyframeAnimationCount);
+    XCTAssertEqual(PKAnimationPoolTestTimingFunctionCount, timingFunctionCount);
+    XCTAssertEqual(self.pool.allocationCount, 2);
+    
+    // Core Animation copies every added animation, one per transition.
+    XCTAssertEqual([addedAnimations count], 24);
+}
+
+- (void)testThatAnimationsInUseAreNotHandedOutTwice
+{
+    // given
+    NSArray *values = @[[NSValue valueWithCGPoint:CGPointMake(420.0, 0.0)]];
+    
+    // when
+    PKSequentialAnimation *first = [self.pool sequentialAnimationForKeyPath:@"position" values:values duration:1.0];
+    PKSequentialAnimation *second = [self.pool sequentialAnimationForKeyPath:@"position" values:values duration:1.0];
+    PKSequentialAnimation *third = [self.pool sequentialAnimationForKeyPath:@"position" values:values duration:1.0];
+    
+    // then
+    XCTAssertNotEqual(first, second);
+    XCTAssertNotEqual(second, third);
+    XCTAssertNotEqual(first, third);
+    XCTAssertEqual(self.pool.allocationCount, 3);
+}
+
+#pragma mark - Timing functions
+- (void)testThatTimingFunctionsAreShared
+{
+    XCTAssertEqual([PKAnimationPool timingFunctionWithName:kCAMediaTimingFunctionEaseIn],
+                   [PKAnimationPool timingFunctionWithName:kCAMediaTimingFunctionEaseIn]);
+    XCTAssertNotEqual([PKAnimationPool timingFunctionWithName:kCAMediaTimingFunctionEaseIn],
+                      [PKAnimationPool timingFunctionWithName:kCAMediaTimingFunctionEaseOut]);
+}
+
+@end
@@ -0,0 +1,98 @@
+//
+//  PKFrameUpdateSchedulerTest.m
+//  PKRevealController
+//
+//  Copyright (c) 2015 zuui.org (Philip Kluz). All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+#import "PKFrameUpdateScheduler.h"
+
+@interface PKFrameUpdateSchedulerTest : XCTestCase
+
+@property PKFrameUpdateScheduler *scheduler;
+@property NSMutableArray *updates;
+
+@end
+
+@implementation PKFrameUpdateSchedulerTest
+
+- (void)setUp {
+    [super setUp];
+    
+    NSMutableArray *updates = [NSMutableArray array];
+    self.updates = updates;
+    self.scheduler = [PKFrameUpdateScheduler schedulerWithHandler:^(NSUInteger flags)
+    {
+        [updates addObject:@(flags)];
+    }];
+}
+
+- (void)tearDown {
+    [super tearDown];
+}
+
+#pragma mark - Coalescing
+- (void)testThatRequestsAreCoalescedIntoOneUpdatePerRunLoopIteration
+{
+    // given
+    [self.scheduler setNeedsUpdate:1];
+    [self.scheduler setNeedsUpdate:2];
+    [self.scheduler setNeedsUpdate:1];
+    
+    // then
+    XCTAssertEqual([self.updates count], 0);
+    XCTAssertEqual(self.scheduler.pendingFlags, 3);
+    
+    // when
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+    
+    // then
+    XCTAssertEqualObjects(self.updates, @[@3]);
+    XCTAssertEqual(self.scheduler.requestCount, 3);
+    XCTAssertEqual(self.scheduler.updateCount, 1);
+    XCTAssertEqual(self.scheduler.elidedCount, 2);
+}
+
+- (void)testThatRequestsWithoutFlagsAreOnlyCounted
+{
+    // when
+    [self.scheduler setNeedsUpdate:0];
+    [self.scheduler flush];
+    
+    // then
+    XCTAssertEqual([self.updates count], 0);
+    XCTAssertEqual(self.scheduler.elidedCount, 1);
+}
+
+#pragma mark - Flushing
+- (void)testThatFlushPerformsPendingUpdateOnce
+{
+    // given
+    [self.scheduler setNeedsUpdate:2];
+    
+    // when
+    [self.scheduler flush];
+    [self.scheduler flush];
+    
+    // then
+    XCTAssertEqualObjects(self.updates, @[@2]);
+    XCTAssertEqual(self.scheduler.pendingFlags, 0);
+}
+
+- (void)testThatCancelDiscardsPendingUpdate
+{
+    // given
+    [self.scheduler setNeedsUpdate:1];
+    
+    // when
+    [self.scheduler cancel];
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+    
+    // then
+    XCTAssertEqual([self.updates count], 0);
+}
+
+@end
@@ -0,0 +1,97 @@
+//
+//  PKInteractiveAnimatorTest.m
+//  PKRevealController
+//
+//  Copyright (c) 2015 zuui.org (Philip Kluz). All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+#import "PKInteractiveAnimator.h"
+
+@interface PKInteractiveAnimatorTest : XCTestCase
+
+@property CALayer *layer;
+@property PKInteractiveAnimator *animator;
+
+@end
+
+@implementation PKInteractiveAnimatorTest
+
+- (void)setUp {
+    [super setUp];
+    
+    self.layer = [CALayer layer];
+    self.layer.position = CGPointMake(160.0, 240.0);
+    self.animator = [PKInteractiveAnimator animatorForLayer:self.layer];
+}
+
+- (void)tearDown {
+    [self.animator interruptAnimation];
+    [super tearDown];
+}
+
+#pragma mark - Interruption
+- (void)testThatInterruptionKeepsPositionAndReportsUnfinished
+{
+    // given
+    __block BOOL completed = NO;
+    __block BOOL didFinish = YES;
+    
+    [self.animator animateToPosition:CGPointMake(420.0, 240.0) velocity:800.0 duration:0.3 completion:^(BOOL finished)
+    {
+        completed = YES;
+        didFinish = finished;
+    }];
+    
+    // when
+    CGPoint position = [self.animator interruptAnimation];
+    
+    // then
+    XCTAssertTrue(completed);
+    XCTAssertFalse(didFinish);
+    XCTAssertFalse(self.animator.isAnimating);
+    XCTAssertEqualWithAccuracy(position.x, 160.0, 0.001);
+    XCTAssertEqualWithAccuracy(self.layer.position.x, 160.0, 0.001);
+    XCTAssertEqual([self.layer.animationKeys count], 0);
+}
+
+- (void)testThatRetargetingInterruptsRunningAnimation
+{
+    // given
+    __block BOOL didFinishFirst = YES;
+    
+    [self.animator animateToPosition:CGPointMake(420.0, 240.0) velocity:0.0 duration:0.3 completion:^(BOOL finished)
+    {
+        didFinishFirst = finished;
+    }];
+    
+    // when
+    [self.animator animateToPosition:CGPointMake(-100.0, 240.0) velocity:0.0 duration:0.3 completion:nil];
+    
+    // then
+    XCTAssertFalse(didFinishFirst);
+    XCTAssertTrue(self.animator.isAnimating);
+}
+
+#pragma mark - Settling
+- (void)testThatAnimationSettlesAtTarget
+{
+    // given
+    XCTestExpectation *expectation = [self expectationWithDescription:@"settled"];
+    
+    // when
+    [self.animator animateToPosition:CGPointMake(420.0, 240.0) velocity:1200.0 duration:0.1 completion:^(BOOL finished)
+    {
+        XCTAssertTrue(finished);
+        [expectation fulfill];
+    }];
+    
+    // then
+    [self waitForExpectationsWithTimeout:1.0 handler:nil];
+    XCTAssertEqualWithAccuracy(self.layer.position.x, 420.0, 0.001);
+    XCTAssertEqualWithAccuracy(self.animator.velocity, 0.0, 0.001);
+}
+
+@end
@@ -0,0 +1,134 @@
+//
+//  PKLogRingTests.c
+//  PKRevealController
+//
+//  Headless tests of the lock-free log ring used by PKLog.
+//
+
+#include "PKLogRing.h"
+#include "PKRevealCoreTestSupport.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#define PKLogRingTestRecordCount 20000
+
+static void PKWriteRecord(PKLogRing *ring, uint32_t line)
+{
+    PKLogRecord *record = PKLogRingBeginWrite(ring);
+    
+    if (record)
+    {
+        record->line = line;
+        snprintf(record->message, PKLogRingMessageLength, "message %u", line);
+        PKLogRingCommitWrite(ring);
+    }
+}
+
+#pragma mark - Single Thread
+
+static void testRingPreservesOrder(void)
+{
+    static PKLogRing ring;
+    PKLogRecord record;
+    
+    PKLogRingInitialize(&ring);
+    PKAssertFalse(PKLogRingRead(&ring, &record));
+    
+    PKWriteRecord(&ring, 1);
+    PKWriteRecord(&ring, 2);
+    
+    PKAssertTrue(PKLogRingRead(&ring, &record));
+    PKAssertEqual(record.line, 1);
+    PKAssertTrue(strcmp(record.message, "message 1") == 0);
+    PKAssertTrue(PKLogRingRead(&ring, &record));
+    PKAssertEqual(record.line, 2);
+    PKAssertFalse(PKLogRingRead(&ring, &record));
+}
+
+static void testFullRingDropsInsteadOfBlocking(void)
+{
+    static PKLogRing ring;
+    PKLogRecord record;
+    
+    PKLogRingInitialize(&ring);
+    
+    for (uint32_t line = 0; line < PKLogRingCapacity + 10; line++)
+    {
+        PKWriteRecord(&ring, line);
+    }
+    
+    PKAssertEqual(PKLogRingTakeDroppedCount(&ring), 10);
+    PKAssertEqual(PKLogRingTakeDroppedCount(&ring), 0);
+    
+    uint32_t count = 0;
+    
+    while (PKLogRingRead(&ring, &record))
+    {
+        PKAssertEqual(record.line, count);
+        count++;
+    }
+    
+    PKAssertEqual(count, PKLogRingCapacity);
+}
+
+#pragma mark - Concurrency
+
+static void *PKProduceRecords(void *ring)
+{
+    for (uint32_t line = 0; line < PKLogRingTestRecordCount; line++)
+    {
+        PKLogRecord *record;
+        
+        while ((record = PKLogRingBeginWrite((PKLogRing *)ring)) == NULL)
+        {
+            // Wait until the consumer made room; the test must not lose records.
+            sched_yield();
+        }
+        
+        record->line = line;
+        PKLogRingCommitWrite((PKLogRing *)ring);
+    }
+    
+    return NULL;
+}
+
+static void testConcurrentProducerAndConsumer(void)
+{
+    static PKLogRing ring;
+    PKLogRecord record;
+    pthread_t producer;
+    
+    PKLogRingInitialize(&ring);
+    pthread_create(&producer, NULL, PKProduceRecords, &ring);
+    
+    uint32_t expectedLine = 0;
+    bool isOrdered = true;
+    
+    while (expectedLine < PKLogRingTestRecordCount)
+    {
+        if (PKLogRingRead(&ring, &record))
+        {
+            isOrdered = isOrdered && (record.line == expectedLine);
+            expectedLine++;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    
+    pthread_join(producer, NULL);
+    
+    PKAssertTrue(isOrdered);
+    PKAssertFalse(PKLogRingRead(&ring, &record));
+}
+
+int main(void)
+{
+    PKRunTest(testRingPreservesOrder);
+    PKRunTest(testFullRingDropsInsteadOfBlocking);
+    PKRunTest(testConcurrentProducerAndConsumer);
+    
+    return PKTestResult();
+}
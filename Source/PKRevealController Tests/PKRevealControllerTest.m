@@ -11,6 +11,11 @@
 #import <OCMock/OCMock.h>
 
 #import "PKRevealController.h"
+#import "PKRevealControllerRootView.h"
+#import "PKRevealCoreTrace.h"
+#import "PKRevealControllerTelemetry.h"
+#import "PKTimingCurve.h"
+#import "PKTrace.h"
 
 @interface PKRevealController (PKRevealControllerTest)
 
@@ -25,12 +30,29 @@
 - (CGFloat)rightViewMinWidth;
 - (CGFloat)rightViewMaxWidth;
 
+- (UIView *)leftView;
 - (CALayer *)frontViewLayer;
+- (PKTimingCurve *)animationTimingCurve;
 
 - (void)didRecognizeTapGesture:(UITapGestureRecognizer *)recognizer;
 
 @end
 
+@interface PKRevealControllerTestDelegate : NSObject <PKRevealing>
+
+@property NSMutableArray *states;
+
+@end
+
+@implementation PKRevealControllerTestDelegate
+
+- (void)revealController:(PKRevealController *)revealController didChangeToState:(PKRevealControllerState)state
+{
+    [self.states addObject:@(state)];
+}
+
+@end
+
 @interface PKRevealControllerTest : XCTestCase
 
 @property PKRevealController *revealController;
@@ -396,6 +418,20 @@
     XCTAssertEqualWithAccuracy(self.revealController.frontViewLayer.position.x - initialPosition, 200.0, 0.001);
 }
 
+- (void)testThatCenterPointsFollowBoundsChanges
+{
+    // given - min width:100, max width:200
+    [self testThatMinMaxWidthConfigurationIsSavedForLeftSideController];
+    
+    // when
+    self.revealController.view.bounds = CGRectMake(0.0, 0.0, 500.0, 400.0);
+    [self.revealController.view layoutIfNeeded];
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    
+    // then
+    XCTAssertEqualWithAccuracy(self.revealController.frontViewLayer.position.x, 350.0, 0.001);
+}
+
 #pragma mark - Retrieving reveal controller from managed controllers
 - (void)testRetrievingRevealControllerForManagedControllers
 {
@@ -469,6 +505,55 @@
     XCTAssertEqual(self.revealController.state, PKRevealControllerShowsFrontViewController);
 }
 
+#pragma mark - Delegate
+- (void)testThatDelegateOnlyReceivesImplementedCallbacks
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:NO];
+    
+    PKRevealControllerTestDelegate *delegate = [PKRevealControllerTestDelegate new];
+    delegate.states = [NSMutableArray array];
+    self.revealController.delegate = delegate;
+    
+    // when
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    
+    // then
+    XCTAssertEqualObjects(delegate.states, @[@(PKRevealControllerShowsLeftViewController)]);
+    
+    // when
+    self.revealController.delegate = nil;
+    [self.revealController showViewController:self.revealController.frontViewController animated:NO completion:nil];
+    
+    // then
+    XCTAssertEqual([delegate.states count], 1);
+}
+
+- (void)testThatTapGestureOnlyBeginsWhileSideControllerIsShown
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:NO];
+    UITapGestureRecognizer *recognizer = self.revealController.revealResetTapGestureRecognizer;
+    
+    // then
+    XCTAssertNotNil(recognizer.view);
+    XCTAssertFalse([self.revealController gestureRecognizerShouldBegin:recognizer]);
+    
+    // when
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    
+    // then
+    XCTAssertNotNil(recognizer.view);
+    XCTAssertTrue([self.revealController gestureRecognizerShouldBegin:recognizer]);
+    
+    // when
+    self.revealController.recognizesResetTapOnFrontView = NO;
+    
+    // then
+    XCTAssertNotNil(recognizer.view);
+    XCTAssertFalse([self.revealController gestureRecognizerShouldBegin:recognizer]);
+}
+
 - (void)testRemovingTapGestureWhileSideControllerIsShown
 {
     // given
@@ -578,6 +663,351 @@
 
 
 
+#pragma mark - Lazy Loading
+- (void)testThatRearViewControllersAreLoadedLazily
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    
+    // then
+    XCTAssertTrue([self.revealController.frontViewController isViewLoaded]);
+    XCTAssertFalse([self.revealController.leftViewController isViewLoaded]);
+    XCTAssertFalse([self.revealController.rightViewController isViewLoaded]);
+    
+    // when
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    
+    // then
+    XCTAssertTrue([self.revealController.leftViewController isViewLoaded]);
+    XCTAssertEqualObjects(self.revealController.leftViewController.parentViewController, self.revealController);
+    XCTAssertFalse([self.revealController.rightViewController isViewLoaded]);
+}
+
+- (void)testThatWarmUpLoadsRearViewControllersWithoutAttachingThem
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    
+    // when
+    [self.revealController warmUpRearViewControllers];
+    
+    // then
+    XCTAssertTrue([self.revealController.leftViewController isViewLoaded]);
+    XCTAssertTrue([self.revealController.rightViewController isViewLoaded]);
+    XCTAssertNil(self.revealController.leftViewController.parentViewController);
+    XCTAssertNil(self.revealController.rightViewController.parentViewController);
+}
+
+#pragma mark - Rear Containment
+- (void)testThatHiddenRearViewControllersAreDetachedByDefault
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    
+    // when
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    [self.revealController showViewController:self.revealController.frontViewController animated:NO completion:nil];
+    
+    // then
+    XCTAssertNil(self.revealController.leftViewController.parentViewController);
+    XCTAssertEqual(self.revealController.rearAttachCount, 1);
+    XCTAssertEqual(self.revealController.rearDetachCount, 1);
+}
+
+- (void)testThatKeepAttachedPolicyAvoidsContainmentChurn
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    self.revealController.rearContainmentPolicy = PKRevealControllerRearContainmentPolicyKeepAttached;
+    
+    // when
+    for (NSUInteger index = 0; index < 3; index++)
+    {
+        [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+        [self.revealController showViewController:self.revealController.frontViewController animated:NO completion:nil];
+    }
+    
+    // then
+    XCTAssertEqualObjects(self.revealController.leftViewController.parentViewController, self.revealController);
+    XCTAssertEqual(self.revealController.rearAttachCount, 1);
+    XCTAssertEqual(self.revealController.rearDetachCount, 0);
+}
+
+- (void)testThatMemoryWarningsDetachHiddenRearViewControllers
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    self.revealController.rearContainmentPolicy = PKRevealControllerRearContainmentPolicyKeepAttached;
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    [self.revealController showViewController:self.revealController.frontViewController animated:NO completion:nil];
+    
+    // when
+    [self.revealController didReceiveMemoryWarning];
+    
+    // then
+    XCTAssertNil(self.revealController.leftViewController.parentViewController);
+    XCTAssertEqual(self.revealController.rearDetachCount, 1);
+}
+
+- (void)testThatPendingRearDetachDoesNotRetainController
+{
+    __weak PKRevealController *weakRevealController = nil;
+    
+    @autoreleasepool
+    {
+        // given
+        [self defaultInitializerWithSideControllersLeft:YES right:YES];
+        self.revealController.rearContainmentPolicy = PKRevealControllerRearContainmentPolicyDetachAfterTimeout;
+        self.revealController.rearDetachTimeout = 60.0;
+        
+        // when
+        [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+        [self.revealController showViewController:self.revealController.frontViewController animated:NO completion:nil];
+        weakRevealController = self.revealController;
+        self.revealController = nil;
+    }
+    
+    // then
+    XCTAssertNil(weakRevealController);
+}
+
+#pragma mark - Gesture Trace
+- (void)testThatStateChangesAreRecordedIntoGestureTrace
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    self.revealController.recordsGestureTrace = YES;
+    
+    // when
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    
+    // then
+    NSData *trace = [self.revealController gestureTrace];
+    PKRevealCoreTraceHeader header;
+    PKRevealCoreTraceSample sample;
+    
+    XCTAssertEqual(PKRevealCoreTraceDecode(trace.bytes, trace.length, &header, &sample, 1), 1);
+    XCTAssertEqual(header.initialState, PKRevealCoreStateFront);
+    XCTAssertTrue(header.hasLeft && header.hasRight);
+    XCTAssertEqual(sample.kind, PKRevealCoreTraceSampleKindStateChange);
+    XCTAssertEqual(sample.state, PKRevealCoreStateLeft);
+    
+    // when
+    [self.revealController resetGestureTrace];
+    
+    // then
+    XCTAssertNil([self.revealController gestureTrace]);
+}
+
+#pragma mark - Overdraw dampening
+- (void)testThatCustomDampeningValuesSelectCustomDampening
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    XCTAssertEqual(self.revealController.overdrawDampening, PKRevealControllerOverdrawDampeningArctangent);
+    
+    // when
+    [self.revealController setOverdrawDampeningValues:@[@0.0, @0.6, @1.0] extent:2.0];
+    
+    // then
+    XCTAssertEqual(self.revealController.overdrawDampening, PKRevealControllerOverdrawDampeningCustom);
+    
+    // when
+    self.revealController.overdrawDampening = PKRevealControllerOverdrawDampeningRubberBand;
+    
+    // then
+    XCTAssertEqual(self.revealController.overdrawDampening, PKRevealControllerOverdrawDampeningRubberBand);
+}
+
+- (void)testThatInvalidCustomDampeningValuesAreRejected
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    
+    // when
+    [self.revealController setOverdrawDampeningValues:@[@0.0, @0.8, @0.4] extent:2.0];
+    [self.revealController setOverdrawDampeningValues:@[@0.0, @(NAN)] extent:2.0];
+    [self.revealController setOverdrawDampeningValues:@[@0.0, @1.0] extent:0.0];
+    
+    // then
+    XCTAssertEqual(self.revealController.overdrawDampening, PKRevealControllerOverdrawDampeningArctangent);
+}
+
+#pragma mark - Timing curves
+- (void)testThatAnimationCurveIsHonored
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    
+    // then
+    XCTAssertEqual(self.revealController.animationCurve, UIViewAnimationCurveEaseInOut);
+    XCTAssertEqual([self.revealController animationTimingCurve], [PKTimingCurve easeInEaseOutCurve]);
+    
+    // when
+    self.revealController.animationCurve = UIViewAnimationCurveEaseIn;
+    
+    // then
+    XCTAssertEqual([self.revealController animationTimingCurve], [PKTimingCurve easeInCurve]);
+    
+    // when
+    PKTimingCurve *curve = [PKTimingCurve curveWithControlPoint1:CGPointMake(0.3, 0.0) controlPoint2:CGPointMake(0.1, 1.0)];
+    self.revealController.timingCurve = curve;
+    
+    // then
+    XCTAssertEqual([self.revealController animationTimingCurve], curve);
+}
+
+#pragma mark - Reveal effects
+- (void)testThatScaleRevealShrinksFrontView
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    self.revealController.animationType = PKRevealControllerAnimationTypeScale;
+    
+    // when
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    
+    // then
+    CATransform3D transform = self.revealController.frontViewLayer.transform;
+    XCTAssertEqualWithAccuracy(transform.m11, 0.85, 0.001);
+    XCTAssertEqualWithAccuracy(transform.m22, 0.85, 0.001);
+    XCTAssertTrue(CATransform3DIsIdentity([self.revealController leftView].layer.transform));
+}
+
+- (void)testThatParallaxRevealMovesRearViewAlong
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    self.revealController.animationType = PKRevealControllerAnimationTypeParallax;
+    
+    // when
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    
+    // then
+    XCTAssertEqualWithAccuracy([self.revealController leftView].layer.transform.m41, 0.0, 0.001);
+    XCTAssertTrue(CATransform3DIsIdentity(self.revealController.frontViewLayer.transform));
+    
+    // when
+    [self.revealController showViewController:self.revealController.frontViewController animated:NO completion:nil];
+    
+    // then
+    XCTAssertEqualWithAccuracy([self.revealController leftView].layer.transform.m41, -260.0 * 0.3, 0.001);
+    
+    // when
+    self.revealController.animationType = PKRevealControllerAnimationTypeStatic;
+    
+    // then
+    XCTAssertTrue(CATransform3DIsIdentity([self.revealController leftView].layer.transform));
+}
+
+#pragma mark - Interruption
+- (void)testThatRetargetedTransitionKeepsFrontViewMoving
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    self.revealController.animationTiming = PKRevealControllerAnimationTimingSpring;
+    PKRevealControllerRootView *rootView = (PKRevealControllerRootView *)self.revealController.view;
+    
+    [self.revealController showViewController:self.revealController.leftViewController animated:YES completion:nil];
+    XCTAssertFalse(rootView.routesTouches);
+    
+    // when
+    [self.revealController showViewController:self.revealController.rightViewController animated:YES completion:nil];
+    
+    // then
+    XCTAssertFalse(rootView.routesTouches);
+}
+
+#pragma mark - Hit testing
+- (void)testThatTouchesAreRoutedByState
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:NO];
+    
+    // when
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    UIView *rearHit = [self.revealController.view hitTest:CGPointMake(100.0, 100.0) withEvent:nil];
+    UIView *frontHit = [self.revealController.view hitTest:CGPointMake(300.0, 100.0) withEvent:nil];
+    
+    // then
+    XCTAssertTrue([rearHit isDescendantOfView:[self.revealController leftView]]);
+    XCTAssertNotNil(frontHit);
+    XCTAssertFalse([frontHit isDescendantOfView:[self.revealController leftView]]);
+    
+    // when
+    [self.revealController showViewController:self.revealController.frontViewController animated:NO completion:nil];
+    
+    // then
+    XCTAssertFalse([[self.revealController.view hitTest:CGPointMake(100.0, 100.0) withEvent:nil] isDescendantOfView:[self.revealController leftView]]);
+}
+
+- (void)testThatTouchesMissingTheRoutedContainerGoToTheRootView
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:NO];
+    PKRevealControllerRootView *rootView = (PKRevealControllerRootView *)self.revealController.view;
+    
+    // when
+    rootView.frontView.userInteractionEnabled = NO;
+    UIView *hit = [rootView hitTest:CGPointMake(100.0, 100.0) withEvent:nil];
+    
+    // then
+    XCTAssertEqual(hit, rootView);
+}
+
+#pragma mark - Telemetry
+- (void)testThatAnimatedTransitionsAreAggregatedIntoTelemetry
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    self.revealController.collectsTelemetry = YES;
+    
+    // when
+    XCTestExpectation *expectation = [self expectationWithDescription:@"show left view animated finished"];
+    [self.revealController showViewController:self.revealController.leftViewController animated:YES completion:^(BOOL finished) {
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:1.0 handler:nil];
+    
+    // then
+    PKRevealControllerTelemetry *telemetry = [self.revealController telemetrySnapshot];
+    
+    XCTAssertEqual(telemetry.transitionCount, 1);
+    XCTAssertEqual([telemetry transitionCountFromState:PKRevealControllerShowsFrontViewController toState:PKRevealControllerShowsLeftViewController], 1);
+    XCTAssertEqual([telemetry durationHistogramFromState:PKRevealControllerShowsFrontViewController toState:PKRevealControllerShowsLeftViewController].count, [PKRevealControllerTelemetry histogramBucketUpperBounds].count);
+    
+    // when
+    [self.revealController resetTelemetry];
+    
+    // then
+    XCTAssertEqual([self.revealController telemetrySnapshot].transitionCount, 0);
+}
+
+#pragma mark - Tracing
+- (void)testThatStateChangesAndContainmentAreTraced
+{
+    // given
+    [self defaultInitializerWithSideControllersLeft:YES right:YES];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"PKRevealControllerTest.json"];
+    PKTraceStart(64);
+    
+    // when
+    [self.revealController showViewController:self.revealController.leftViewController animated:NO completion:nil];
+    PKTraceStop();
+    
+    // then
+    NSError *error = nil;
+    XCTAssertTrue(PKTraceWriteToFile(path, &error));
+    XCTAssertNil(error);
+    
+    NSDictionary *trace = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfFile:path] options:0 error:nil];
+    NSArray *names = [trace[@"traceEvents"] valueForKey:@"name"];
+    
+    XCTAssertTrue([names containsObject:@"state"]);
+    XCTAssertTrue([names containsObject:@"attach"]);
+}
+
 #pragma mark - Helpers
 - (void)defaultInitializerWithSideControllersLeft:(BOOL)useLeft right:(BOOL)useRight
 {
@@ -606,19 +1036,27 @@
     XCTAssertNotNil(self.revealController.revealResetTapGestureRecognizer);
     
     XCTAssertEqual(self.revealController.state, PKRevealControllerShowsFrontViewController);
-    XCTAssertEqual(self.revealController.animationCurve, UIViewAnimationCurveLinear);
+    XCTAssertEqual(self.revealController.animationCurve, UIViewAnimationCurveEaseInOut);
     XCTAssertEqual(self.revealController.animationType, PKRevealControllerAnimationTypeStatic);
+    XCTAssertEqual(self.revealController.animationTiming, PKRevealControllerAnimationTimingFixed);
     
     XCTAssertFalse(self.revealController.isPresentationModeActive);
     
+    XCTAssertFalse(self.revealController.projectsMomentum);
     XCTAssertTrue(self.revealController.allowsOverdraw);
     XCTAssertTrue(self.revealController.disablesFrontViewInteraction);
     XCTAssertTrue(self.revealController.recognizesPanningOnFrontView);
     XCTAssertTrue(self.revealController.recognizesResetTapOnFrontView);
+    XCTAssertEqual(self.revealController.revealPanRegion, PKRevealControllerPanRegionFrontView);
+    XCTAssertEqualWithAccuracy(self.revealController.revealPanEdgeInsets.left, 30.0, 0.001);
+    XCTAssertEqualWithAccuracy(self.revealController.revealPanEdgeInsets.right, 30.0, 0.001);
     XCTAssertTrue(self.revealController.recognizesResetTapOnFrontViewInPresentationMode);
     
     XCTAssertEqualWithAccuracy(self.revealController.animationDuration, 0.185, 0.0001);
+    XCTAssertEqualWithAccuracy(self.revealController.parallaxRatio, 0.3, 0.0001);
+    XCTAssertEqualWithAccuracy(self.revealController.frontViewScale, 0.85, 0.0001);
     XCTAssertEqualWithAccuracy(self.revealController.quickSwipeVelocity, 800, 0.0001);
+    XCTAssertEqualWithAccuracy(self.revealController.decelerationRate, 0.998, 0.0001);
     XCTAssertEqualWithAccuracy([self.revealController leftViewMinWidth], 260.0, 0.001);
     XCTAssertEqualWithAccuracy([self.revealController leftViewMaxWidth], 300.0, 0.001);
 }
@@ -0,0 +1,157 @@
+//
+//  PKRevealControllerViewTest.m
+//  PKRevealController
+//
+//  Copyright (c) 2015 zuui.org (Philip Kluz). All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+#import "PKRevealControllerView.h"
+
+@interface PKRevealControllerViewTest : XCTestCase
+
+@property PKRevealControllerView *containerView;
+@property UIViewController *viewController;
+
+@end
+
+@implementation PKRevealControllerViewTest
+
+- (void)setUp {
+    [super setUp];
+    
+    self.containerView = [[PKRevealControllerView alloc] initWithFrame:CGRectMake(0.0, 0.0, 320.0, 480.0)];
+    self.viewController = [UIViewController new];
+    self.containerView.viewController = self.viewController;
+    [self.containerView addSubview:self.viewController.view];
+}
+
+- (void)tearDown {
+    [super tearDown];
+}
+
+#pragma mark - Shadow
+- (void)testThatShadowPathIsReusedForSameSize
+{
+    // given
+    self.containerView.shadow = YES;
+    CGPathRef shadowPath = self.containerView.layer.shadowPath;
+    
+    // when
+    [self.containerView updateShadowWithAnimationDuration:0.0];
+    
+    // then
+    XCTAssertTrue(self.containerView.hasShadow);
+    XCTAssertTrue(self.containerView.layer.shadowPath == shadowPath);
+    XCTAssertNil([self.containerView.layer animationForKey:@"shadowTransitionAnimation"]);
+}
+
+- (void)testThatShadowPathCacheKeepsRecentSizesOnly
+{
+    // given
+    self.containerView.shadow = YES;
+    CGPathRef shadowPath = self.containerView.layer.shadowPath;
+    
+    // when
+    for (CGFloat width = 100.0; width < 200.0; width += 10.0)
+    {
+        self.containerView.bounds = CGRectMake(0.0, 0.0, width, 100.0);
+        [self.containerView updateShadowWithAnimationDuration:0.0];
+    }
+    
+    CGPathRef recentShadowPath = self.containerView.layer.shadowPath;
+    self.containerView.bounds = CGRectMake(0.0, 0.0, 180.0, 100.0);
+    [self.containerView updateShadowWithAnimationDuration:0.0];
+    self.containerView.bounds = CGRectMake(0.0, 0.0, 190.0, 100.0);
+    [self.containerView updateShadowWithAnimationDuration:0.0];
+    
+    // then
+    XCTAssertEqual([[self.containerView valueForKey:@"shadowPaths"] count], 2);
+    XCTAssertTrue(self.containerView.layer.shadowPath == recentShadowPath);
+    XCTAssertTrue(self.containerView.layer.shadowPath != shadowPath);
+}
+
+- (void)testThatGradientShadowDoesNotUseLayerShadow
+{
+    // when
+    self.containerView.shadowStyle = PKRevealControllerShadowStyleGradient;
+    self.containerView.shadow = YES;
+    
+    // then
+    XCTAssertEqualWithAccuracy(self.containerView.layer.shadowOpacity, 0.0, 0.0001);
+    XCTAssertTrue(self.containerView.layer.shadowPath == NULL);
+    XCTAssertFalse(self.containerView.layer.masksToBounds);
+    XCTAssertEqual([self.containerView.layer.sublayers count], 3);
+}
+
+#pragma mark - Hit testing
+- (void)testThatTouchesReachContainedViewWhileItIsInteractive
+{
+    // when
+    UIView *view = [self.containerView hitTest:CGPointMake(10.0, 10.0) withEvent:nil];
+    
+    // then
+    XCTAssertTrue([view isDescendantOfView:self.viewController.view]);
+}
+
+- (void)testThatContainerTakesTouchesWhileContainedViewIgnoresThem
+{
+    // given
+    [self.containerView setUserInteractionForContainedViewEnabled:NO];
+    
+    // when
+    UIView *view = [self.containerView hitTest:CGPointMake(10.0, 10.0) withEvent:nil];
+    
+    // then
+    XCTAssertEqual(view, self.containerView);
+    XCTAssertNil([self.containerView hitTest:CGPointMake(400.0, 10.0) withEvent:nil]);
+}
+
+#pragma mark - Snapshots
+- (void)testThatSnapshottingIsOptIn
+{
+    // when
+    [self.containerView beginSnapshotting];
+    
+    // then
+    XCTAssertFalse(self.containerView.isShowingSnapshot);
+    XCTAssertFalse(self.viewController.view.hidden);
+}
+
+- (void)testThatSnapshotReplacesContainedViewUntilEnded
+{
+    // given
+    self.containerView.usesSnapshots = YES;
+    
+    // when
+    [self.containerView beginSnapshotting];
+    
+    // then
+    XCTAssertTrue(self.containerView.isShowingSnapshot);
+    XCTAssertTrue(self.viewController.view.hidden);
+    
+    // when
+    [self.containerView endSnapshotting];
+    
+    // then
+    XCTAssertFalse(self.containerView.isShowingSnapshot);
+    XCTAssertFalse(self.viewController.view.hidden);
+}
+
+- (void)testThatInvalidationRestoresContainedView
+{
+    // given
+    self.containerView.usesSnapshots = YES;
+    [self.containerView beginSnapshotting];
+    
+    // when
+    [self.containerView invalidateSnapshot];
+    
+    // then
+    XCTAssertFalse(self.containerView.isShowingSnapshot);
+    XCTAssertFalse(self.viewController.view.hidden);
+}
+
+@end
@@ -0,0 +1,90 @@
+//
+//  PKRevealCoreBenchmark.c
+//  PKRevealController
+//
+//  Microbenchmark of the reveal core hot path, i.e. the work done per pan event and on release.
+//  Usage: PKRevealCoreBenchmark [iterations]
+//
+
+#include "PKRevealCore.h"
+#include "PKRevealCoreCurve.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double PKBenchmarkNow(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + ((double)time.tv_nsec / 1e9);
+}
+
+// Prevents the compiler from discarding the benchmarked computations.
+static volatile double PKBenchmarkSink;
+
+static void PKBenchmarkReport(const char *name, double seconds, long iterations)
+{
+    printf("%-28s %10.2f ns/op\n", name, (seconds / (double)iterations) * 1e9);
+}
+
+int main(int argc, const char *argv[])
+{
+    long iterations = (argc > 1) ? atol(argv[1]) : 10000000;
+    
+    PKRevealCoreCurve curve = PKRevealCoreCurveMake(PKRevealCoreCurveControlPointsEaseInEaseOut);
+    PKRevealCoreGeometry geometry = PKRevealCoreGeometryMake(160.0,
+                                                             PKRevealCoreWidthRangeMake(260.0, 300.0),
+                                                             PKRevealCoreWidthRangeMake(260.0, 300.0),
+                                                             true,
+                                                             true,
+                                                             NULL);
+    double sink = 0.0;
+    double start = 0.0;
+    
+    // Sweep the finger across the whole range, including overdraw on both sides.
+    start = PKBenchmarkNow();
+    for (long i = 0; i < iterations; i++)
+    {
+        double proposedX = -300.0 + (double)(i % 900);
+        sink += PKRevealCoreFrontViewPositionForPan(&geometry, proposedX, sink);
+    }
+    PKBenchmarkReport("pan position", PKBenchmarkNow() - start, iterations);
+    
+    start = PKBenchmarkNow();
+    for (long i = 0; i < iterations; i++)
+    {
+        sink += PKRevealCoreStateForPosition(&geometry, -300.0 + (double)(i % 900));
+    }
+    PKBenchmarkReport("state for position", PKBenchmarkNow() - start, iterations);
+    
+    start = PKBenchmarkNow();
+    for (long i = 0; i < iterations; i++)
+    {
+        double velocity = -1500.0 + (double)(i % 3000);
+        sink += PKRevealCoreStateForPanRelease(&geometry, PKRevealCoreStateFront, -300.0 + (double)(i % 900), velocity, 800.0);
+    }
+    PKBenchmarkReport("release decision", PKBenchmarkNow() - start, iterations);
+    
+    start = PKBenchmarkNow();
+    for (long i = 0; i < iterations; i++)
+    {
+        PKRevealCoreState from = (PKRevealCoreState)(1 + (i % PKRevealCoreStateCount));
+        PKRevealCoreState to = (PKRevealCoreState)(1 + ((i / PKRevealCoreStateCount) % PKRevealCoreStateCount));
+        PKRevealCoreWaypoints waypoints = PKRevealCorePlanRoute(&geometry, from, to);
+        sink += waypoints.positions[waypoints.count - 1];
+    }
+    PKBenchmarkReport("route planning", PKBenchmarkNow() - start, iterations);
+    
+    // One lookup per frame of a display-link-driven animation.
+    start = PKBenchmarkNow();
+    for (long i = 0; i < iterations; i++)
+    {
+        sink += PKRevealCoreCurveValue(&curve, (double)(i % 1000) / 1000.0);
+    }
+    PKBenchmarkReport("curve evaluation", PKBenchmarkNow() - start, iterations);
+    
+    PKBenchmarkSink = sink;
+    
+    return 0;
+}
@@ -0,0 +1,135 @@
+//
+//  PKRevealCoreCurveTests.c
+//  PKRevealController
+//
+//  Headless tests of the timing curve lookup tables.
+//
+
+#include "PKRevealCoreCurve.h"
+#include "PKRevealCoreTestSupport.h"
+
+static double PKCurveTestBezier(double p1, double p2, double t)
+{
+    double u = 1.0 - t;
+    return 3.0 * u * u * t * p1 + 3.0 * u * t * t * p2 + t * t * t;
+}
+
+#pragma mark - Evaluation
+
+static void testLinearCurve(void)
+{
+    PKRevealCoreCurve curve = PKRevealCoreCurveMake(PKRevealCoreCurveControlPointsLinear);
+    
+    for (int step = 0; step <= 20; step++)
+    {
+        double time = step / 20.0;
+        PKAssertEqualWithAccuracy(PKRevealCoreCurveValue(&curve, time), time, 1e-6);
+        PKAssertEqualWithAccuracy(PKRevealCoreCurveSlope(&curve, time), 1.0, 1e-4);
+    }
+}
+
+static void testCurveMatchesBezier(void)
+{
+    PKRevealCoreCurve curve = PKRevealCoreCurveMake(0.25, 0.1, 0.25, 1.0);
+    
+    // Walks the curve parametrically, which requires no solving, and compares against the table.
+    for (int step = 0; step <= 100; step++)
+    {
+        double t = step / 100.0;
+        double time = PKCurveTestBezier(curve.x1, curve.x2, t);
+        double value = PKCurveTestBezier(curve.y1, curve.y2, t);
+        
+        PKAssertEqualWithAccuracy(PKRevealCoreCurveValue(&curve, time), value, 1e-3);
+    }
+}
+
+static void testCurveClampsTime(void)
+{
+    PKRevealCoreCurve curve = PKRevealCoreCurveMake(PKRevealCoreCurveControlPointsEaseInEaseOut);
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreCurveValue(&curve, -1.0), 0.0, 0.0);
+    PKAssertEqualWithAccuracy(PKRevealCoreCurveValue(&curve, 2.0), 1.0, 0.0);
+    PKAssertEqualWithAccuracy(PKRevealCoreCurveValue(&curve, 0.5), 0.5, 1e-6);
+    PKAssertEqualWithAccuracy(PKRevealCoreCurveValue(&curve, 0.25) + PKRevealCoreCurveValue(&curve, 0.75), 1.0, 1e-6);
+}
+
+static void testSlopeAtEnds(void)
+{
+    PKRevealCoreCurve easeIn = PKRevealCoreCurveMake(PKRevealCoreCurveControlPointsEaseIn);
+    PKRevealCoreCurve easeOut = PKRevealCoreCurveMake(PKRevealCoreCurveControlPointsEaseOut);
+    
+    PKAssertTrue(PKRevealCoreCurveSlope(&easeIn, 0.0) < 0.05);
+    PKAssertTrue(PKRevealCoreCurveSlope(&easeIn, 1.0) > 1.0);
+    PKAssertTrue(PKRevealCoreCurveSlope(&easeOut, 0.0) > 1.0);
+    PKAssertTrue(PKRevealCoreCurveSlope(&easeOut, 1.0) < 0.05);
+}
+
+#pragma mark - Inversion
+
+static void testTimeInvertsValue(void)
+{
+    PKRevealCoreCurve curve = PKRevealCoreCurveMake(PKRevealCoreCurveControlPointsEaseInEaseOut);
+    
+    for (int step = 0; step <= 20; step++)
+    {
+        double time = step / 20.0;
+        PKAssertEqualWithAccuracy(PKRevealCoreCurveTime(&curve, PKRevealCoreCurveValue(&curve, time)), time, 1e-3);
+    }
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreCurveTime(&curve, -0.5), 0.0, 0.0);
+    PKAssertEqualWithAccuracy(PKRevealCoreCurveTime(&curve, 1.5), 1.0, 0.0);
+}
+
+#pragma mark - Segments
+
+static void testSegmentsFollowCurve(void)
+{
+    PKRevealCoreCurve curve = PKRevealCoreCurveMake(PKRevealCoreCurveControlPointsEaseInEaseOut);
+    double boundaries[] = { 0.0, 0.4, 1.0 };
+    
+    for (int index = 0; index < 2; index++)
+    {
+        double startTime = boundaries[index];
+        double endTime = boundaries[index + 1];
+        double startValue = PKRevealCoreCurveValue(&curve, startTime);
+        double endValue = PKRevealCoreCurveValue(&curve, endTime);
+        double controlPoints[4];
+        
+        PKRevealCoreCurveSegment(&curve, startTime, endTime, controlPoints);
+        
+        PKRevealCoreCurve segment = PKRevealCoreCurveMake(controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3]);
+        
+        for (int step = 0; step <= 10; step++)
+        {
+            double fraction = step / 10.0;
+            double expected = PKRevealCoreCurveValue(&curve, startTime + fraction * (endTime - startTime));
+            double actual = startValue + PKRevealCoreCurveValue(&segment, fraction) * (endValue - startValue);
+            
+            PKAssertEqualWithAccuracy(actual, expected, 1e-3);
+        }
+    }
+}
+
+static void testEmptySegmentIsLinear(void)
+{
+    PKRevealCoreCurve curve = PKRevealCoreCurveMake(PKRevealCoreCurveControlPointsEaseIn);
+    double controlPoints[4];
+    
+    PKRevealCoreCurveSegment(&curve, 0.5, 0.5, controlPoints);
+    
+    PKAssertEqualWithAccuracy(controlPoints[0], controlPoints[1], 0.0);
+    PKAssertEqualWithAccuracy(controlPoints[2], controlPoints[3], 0.0);
+}
+
+int main(void)
+{
+    PKRunTest(testLinearCurve);
+    PKRunTest(testCurveMatchesBezier);
+    PKRunTest(testCurveClampsTime);
+    PKRunTest(testSlopeAtEnds);
+    PKRunTest(testTimeInvertsValue);
+    PKRunTest(testSegmentsFollowCurve);
+    PKRunTest(testEmptySegmentIsLinear);
+    
+    return PKTestResult();
+}
@@ -0,0 +1,157 @@
+//
+//  PKRevealCoreDampeningTests.c
+//  PKRevealController
+//
+//  Headless tests of the overdraw dampening curves.
+//
+
+#include "PKRevealCoreDampening.h"
+#include <math.h>
+#include "PKRevealCoreTestSupport.h"
+
+static const PKRevealCoreDampeningCurve PKDampeningTestCurves[] =
+{
+    PKRevealCoreDampeningCurveArctangent,
+    PKRevealCoreDampeningCurveRubberBand,
+    PKRevealCoreDampeningCurveExponential
+};
+
+#define PKDampeningTestCurveCount (sizeof(PKDampeningTestCurves) / sizeof(PKDampeningTestCurves[0]))
+
+#pragma mark - Curves
+
+static void testTablesMatchCurves(void)
+{
+    double overdraws[100];
+    double expected[100];
+    
+    for (size_t index = 0; index < 100; index++)
+    {
+        overdraws[index] = (double)index * 0.1;
+    }
+    
+    for (size_t curve = 0; curve < PKDampeningTestCurveCount; curve++)
+    {
+        PKRevealCoreDampening dampening = PKRevealCoreDampeningMake(PKDampeningTestCurves[curve], PKRevealCoreDampeningDefaultLimit);
+        PKRevealCoreDampeningEvaluate(PKDampeningTestCurves[curve], PKRevealCoreDampeningDefaultLimit, overdraws, expected, 100);
+        
+        for (size_t index = 0; index < 100; index++)
+        {
+            PKAssertEqualWithAccuracy(PKRevealCoreDampeningValue(&dampening, overdraws[index]), expected[index], 1e-4);
+        }
+    }
+}
+
+static void testCurvesAreMonotonicAndBounded(void)
+{
+    for (size_t curve = 0; curve < PKDampeningTestCurveCount; curve++)
+    {
+        PKRevealCoreDampening dampening = PKRevealCoreDampeningMake(PKDampeningTestCurves[curve], PKRevealCoreDampeningDefaultLimit);
+        double previous = 0.0;
+        
+        PKAssertEqualWithAccuracy(PKRevealCoreDampeningValue(&dampening, 0.0), 0.0, 0.0);
+        
+        for (int step = 1; step <= 200; step++)
+        {
+            double value = PKRevealCoreDampeningValue(&dampening, step * 0.05);
+            
+            PKAssertTrue(value > previous);
+            PKAssertTrue(value < PKRevealCoreDampeningDefaultLimit);
+            previous = value;
+        }
+    }
+}
+
+static void testArctangentMatchesLegacyCurve(void)
+{
+    PKRevealCoreDampening dampening = PKRevealCoreDampeningMake(PKRevealCoreDampeningCurveArctangent, PKRevealCoreDampeningDefaultLimit);
+    
+    // The constant the dampening was hardcoded to before it became configurable.
+    PKAssertEqualWithAccuracy(PKRevealCoreDampeningValue(&dampening, 1.0), (2.5 / M_PI) * atan(1.0), 1e-5);
+    PKAssertEqualWithAccuracy(PKRevealCoreDampeningValue(&dampening, 20.0), (2.5 / M_PI) * atan(20.0), 1e-9);
+}
+
+#pragma mark - Inversion
+
+static void testInverseIsExact(void)
+{
+    for (size_t curve = 0; curve < PKDampeningTestCurveCount; curve++)
+    {
+        PKRevealCoreDampening dampening = PKRevealCoreDampeningMake(PKDampeningTestCurves[curve], PKRevealCoreDampeningDefaultLimit);
+        
+        for (int step = 0; step <= 200; step++)
+        {
+            double overdraw = step * 0.025;
+            double value = PKRevealCoreDampeningValue(&dampening, overdraw);
+            
+            PKAssertEqualWithAccuracy(PKRevealCoreDampeningValue(&dampening, PKRevealCoreDampeningInverse(&dampening, value)), value, 1e-12);
+            PKAssertEqualWithAccuracy(PKRevealCoreDampeningInverse(&dampening, value), overdraw, 1e-9);
+        }
+    }
+}
+
+static void testInverseIsFiniteAtLimit(void)
+{
+    PKRevealCoreDampening dampening = PKRevealCoreDampeningMake(PKRevealCoreDampeningCurveRubberBand, 1.0);
+    
+    PKAssertTrue(isfinite(PKRevealCoreDampeningInverse(&dampening, 1.0)));
+    PKAssertTrue(isfinite(PKRevealCoreDampeningInverse(&dampening, 5.0)));
+    PKAssertEqualWithAccuracy(PKRevealCoreDampeningInverse(&dampening, -1.0), 0.0, 0.0);
+}
+
+#pragma mark - Tables
+
+static void testUserSuppliedTable(void)
+{
+    const double values[] = { 0.0, 0.5, 0.75, 0.8 };
+    PKRevealCoreDampening dampening = PKRevealCoreDampeningMakeTable(values, 4, 3.0);
+    
+    // The values are resampled, which rounds the corners at the supplied samples slightly.
+    PKAssertEqual(dampening.curve, PKRevealCoreDampeningCurveTable);
+    PKAssertEqualWithAccuracy(PKRevealCoreDampeningValue(&dampening, 1.0), 0.5, 1e-3);
+    PKAssertEqualWithAccuracy(PKRevealCoreDampeningValue(&dampening, 1.5), 0.625, 1e-9);
+    PKAssertEqualWithAccuracy(PKRevealCoreDampeningValue(&dampening, 10.0), 0.8, 0.0);
+    PKAssertEqualWithAccuracy(PKRevealCoreDampeningInverse(&dampening, 0.75), 2.0, 1e-2);
+    PKAssertEqualWithAccuracy(PKRevealCoreDampeningValue(&dampening, PKRevealCoreDampeningInverse(&dampening, 0.75)), 0.75, 1e-12);
+    PKAssertEqualWithAccuracy(PKRevealCoreDampeningInverse(&dampening, 0.9), 3.0, 0.0);
+}
+
+static void testInvalidTableFallsBackToArctangent(void)
+{
+    const double values[] = { 0.0 };
+    PKRevealCoreDampening dampening = PKRevealCoreDampeningMakeTable(values, 1, 1.0);
+    
+    PKAssertEqual(dampening.curve, PKRevealCoreDampeningCurveArctangent);
+}
+
+static void testTablesMustBeFiniteAndNonDecreasing(void)
+{
+    const double plateau[] = { 0.0, 0.5, 0.5, 0.8 };
+    const double decreasing[] = { 0.0, 0.6, 0.4, 0.8 };
+    const double infinite[] = { 0.0, 0.5, INFINITY };
+    const double notANumber[] = { 0.0, NAN, 0.8 };
+    
+    PKAssertTrue(PKRevealCoreDampeningIsValidTable(plateau, 4, 3.0));
+    PKAssertFalse(PKRevealCoreDampeningIsValidTable(plateau, 4, INFINITY));
+    PKAssertFalse(PKRevealCoreDampeningIsValidTable(plateau, 4, 0.0));
+    PKAssertFalse(PKRevealCoreDampeningIsValidTable(decreasing, 4, 3.0));
+    PKAssertFalse(PKRevealCoreDampeningIsValidTable(infinite, 3, 2.0));
+    PKAssertFalse(PKRevealCoreDampeningIsValidTable(notANumber, 3, 2.0));
+    
+    PKAssertEqual(PKRevealCoreDampeningMakeTable(decreasing, 4, 3.0).curve, PKRevealCoreDampeningCurveArctangent);
+    PKAssertEqual(PKRevealCoreDampeningMakeTable(notANumber, 3, 2.0).curve, PKRevealCoreDampeningCurveArctangent);
+}
+
+int main(void)
+{
+    PKRunTest(testTablesMatchCurves);
+    PKRunTest(testCurvesAreMonotonicAndBounded);
+    PKRunTest(testArctangentMatchesLegacyCurve);
+    PKRunTest(testInverseIsExact);
+    PKRunTest(testInverseIsFiniteAtLimit);
+    PKRunTest(testUserSuppliedTable);
+    PKRunTest(testInvalidTableFallsBackToArctangent);
+    PKRunTest(testTablesMustBeFiniteAndNonDecreasing);
+    
+    return PKTestResult();
+}
@@ -0,0 +1,106 @@
+//
+//  PKRevealCoreReplay.c
+//  PKRevealController
+//
+//  Replays a gesture trace recorded by PKRevealController (see -gestureTrace) with a simulated clock.
+//  Usage: PKRevealCoreReplay <trace> [frames per second] [--positions]
+//
+
+#include "PKRevealCoreTrace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint8_t *PKReplayReadFile(const char *path, size_t *length)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t *bytes = NULL;
+    
+    if (!file)
+    {
+        return NULL;
+    }
+    
+    if (fseek(file, 0, SEEK_END) == 0)
+    {
+        long size = ftell(file);
+        
+        if (size > 0 && fseek(file, 0, SEEK_SET) == 0)
+        {
+            bytes = malloc((size_t)size);
+            *length = bytes ? fread(bytes, 1, (size_t)size, file) : 0;
+        }
+    }
+    
+    fclose(file);
+    
+    return bytes;
+}
+
+int main(int argc, const char *argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <trace> [frames per second] [--positions]\n", argv[0]);
+        return 2;
+    }
+    
+    double framesPerSecond = 60.0;
+    int printsPositions = 0;
+    
+    for (int index = 2; index < argc; index++)
+    {
+        if (strcmp(argv[index], "--positions") == 0)
+        {
+            printsPositions = 1;
+        }
+        else
+        {
+            framesPerSecond = atof(argv[index]);
+        }
+    }
+    
+    size_t length = 0;
+    uint8_t *bytes = PKReplayReadFile(argv[1], &length);
+    PKRevealCoreTraceHeader header;
+    long sampleCount = bytes ? PKRevealCoreTraceDecode(bytes, length, &header, NULL, 0) : -1;
+    
+    if (sampleCount < 0 || framesPerSecond <= 0.0)
+    {
+        fprintf(stderr, "%s: not a valid gesture trace\n", argv[1]);
+        free(bytes);
+        return 1;
+    }
+    
+    PKRevealCoreTraceSample *samples = malloc(sizeof(PKRevealCoreTraceSample) * (size_t)(sampleCount + 1));
+    PKRevealCoreTraceDecode(bytes, length, &header, samples, (size_t)sampleCount);
+    
+    // Replay once to learn the frame count, then again to collect the positions.
+    PKRevealCoreReplayResult result;
+    PKRevealCoreReplay(&header, samples, (size_t)sampleCount, 1.0 / framesPerSecond, NULL, 0, &result);
+    
+    double *positions = malloc(sizeof(double) * result.frameCount);
+    PKRevealCoreReplay(&header, samples, (size_t)sampleCount, 1.0 / framesPerSecond, positions, result.frameCount, &result);
+    
+    if (printsPositions)
+    {
+        for (size_t frame = 0; frame < result.frameCount; frame++)
+        {
+            printf("%zu %.3f\n", frame, positions[frame]);
+        }
+    }
+    
+    printf("samples                  %ld\n", sampleCount);
+    printf("frames                   %zu\n", result.frameCount);
+    printf("total duration           %.3f s\n", result.totalDuration);
+    printf("settle duration          %.3f s\n", result.settleDuration);
+    printf("maximum frame distance   %.2f pt\n", result.maximumFrameDistance);
+    printf("final state              %d\n", (int)result.finalState);
+    
+    free(positions);
+    free(samples);
+    free(bytes);
+    
+    return 0;
+}
@@ -0,0 +1,140 @@
+//
+//  PKRevealCoreTelemetryTests.c
+//  PKRevealController
+//
+//  Headless tests of transition tracking and telemetry aggregation.
+//
+
+#include "PKRevealCoreTelemetry.h"
+#include "PKRevealCoreTestSupport.h"
+
+#define PKTelemetryTestFrameDuration (1.0 / 60.0)
+
+#pragma mark - Histogram
+
+static void testHistogramBuckets(void)
+{
+    PKRevealCoreHistogram histogram = { { 0 }, 0, 0.0, 0.0 };
+    
+    PKRevealCoreHistogramAdd(&histogram, 0.5);
+    PKRevealCoreHistogramAdd(&histogram, 1.0);
+    PKRevealCoreHistogramAdd(&histogram, 3.0);
+    PKRevealCoreHistogramAdd(&histogram, 16.0);
+    PKRevealCoreHistogramAdd(&histogram, 1e9);
+    
+    PKAssertEqual(histogram.counts[0], 1);
+    PKAssertEqual(histogram.counts[1], 1);
+    PKAssertEqual(histogram.counts[2], 1);
+    PKAssertEqual(histogram.counts[5], 1);
+    PKAssertEqual(histogram.counts[PKRevealCoreHistogramBucketCount - 1], 1);
+    PKAssertEqual(histogram.count, 5);
+    PKAssertEqualWithAccuracy(histogram.maximum, 1e9, 0.0);
+    PKAssertEqualWithAccuracy(PKRevealCoreHistogramBucketUpperBound(5), 32.0, 0.0);
+    PKAssertTrue(isinf(PKRevealCoreHistogramBucketUpperBound(PKRevealCoreHistogramBucketCount - 1)));
+}
+
+static void testHistogramPercentile(void)
+{
+    PKRevealCoreHistogram histogram = { { 0 }, 0, 0.0, 0.0 };
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreHistogramPercentile(&histogram, 0.5), 0.0, 0.0);
+    
+    for (int index = 0; index < 9; index++)
+    {
+        PKRevealCoreHistogramAdd(&histogram, 10.0);
+    }
+    
+    PKRevealCoreHistogramAdd(&histogram, 100.0);
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreHistogramPercentile(&histogram, 0.5), 16.0, 0.0);
+    PKAssertEqualWithAccuracy(PKRevealCoreHistogramPercentile(&histogram, 0.9), 16.0, 0.0);
+    PKAssertEqualWithAccuracy(PKRevealCoreHistogramPercentile(&histogram, 0.99), 128.0, 0.0);
+}
+
+#pragma mark - Tracking
+
+static void testTrackerMeasuresLatencyAndDroppedFrames(void)
+{
+    PKRevealCoreTransitionTracker tracker;
+    PKRevealCoreTransitionSample sample;
+    double time = 1.0;
+    
+    PKRevealCoreTransitionTrackerBegin(&tracker, PKRevealCoreStateFront, time, 160.0, true);
+    
+    // The first frame does not move yet, the second one does.
+    PKRevealCoreTransitionTrackerFrame(&tracker, time + PKTelemetryTestFrameDuration, PKTelemetryTestFrameDuration, 160.0);
+    PKRevealCoreTransitionTrackerFrame(&tracker, time + (2 * PKTelemetryTestFrameDuration), PKTelemetryTestFrameDuration, 170.0);
+    
+    // Skip two deadlines.
+    PKRevealCoreTransitionTrackerFrame(&tracker, time + (5 * PKTelemetryTestFrameDuration), PKTelemetryTestFrameDuration, 200.0);
+    PKRevealCoreTransitionTrackerFrame(&tracker, time + (6 * PKTelemetryTestFrameDuration), PKTelemetryTestFrameDuration, 210.0);
+    
+    PKAssertTrue(PKRevealCoreTransitionTrackerEnd(&tracker, PKRevealCoreStateLeft, time + 0.25, &sample));
+    PKAssertFalse(PKRevealCoreTransitionTrackerEnd(&tracker, PKRevealCoreStateLeft, time + 0.25, &sample));
+    
+    PKAssertEqual(sample.fromState, PKRevealCoreStateFront);
+    PKAssertEqual(sample.toState, PKRevealCoreStateLeft);
+    PKAssertTrue(sample.isInteractive);
+    PKAssertEqualWithAccuracy(sample.latency, 2 * PKTelemetryTestFrameDuration, 1e-9);
+    PKAssertEqual(sample.droppedFrameCount, 2);
+    PKAssertEqual(sample.frameCount, 4);
+    PKAssertEqualWithAccuracy(sample.duration, 0.25, 1e-9);
+}
+
+static void testTrackerWithoutMovementHasNoLatency(void)
+{
+    PKRevealCoreTransitionTracker tracker;
+    PKRevealCoreTransitionSample sample;
+    
+    PKRevealCoreTransitionTrackerBegin(&tracker, PKRevealCoreStateLeft, 0.0, 420.0, false);
+    PKRevealCoreTransitionTrackerFrame(&tracker, PKTelemetryTestFrameDuration, PKTelemetryTestFrameDuration, 420.0);
+    PKAssertTrue(PKRevealCoreTransitionTrackerEnd(&tracker, PKRevealCoreStateLeft, 0.1, &sample));
+    
+    PKAssertTrue(sample.latency < 0.0);
+    PKAssertEqual(sample.droppedFrameCount, 0);
+}
+
+#pragma mark - Aggregation
+
+static void testTelemetryAggregatesPerStatePair(void)
+{
+    static PKRevealCoreTelemetry telemetry;
+    PKRevealCoreTransitionSample smooth = { PKRevealCoreStateFront, PKRevealCoreStateLeft, true, 0.008, 0, 12, 0.2 };
+    PKRevealCoreTransitionSample janky = { PKRevealCoreStateFront, PKRevealCoreStateLeft, false, 0.040, 3, 9, 0.2 };
+    PKRevealCoreTransitionSample back = { PKRevealCoreStateLeft, PKRevealCoreStateFront, false, -1.0, 0, 0, 0.0 };
+    
+    PKRevealCoreTelemetryReset(&telemetry);
+    PKRevealCoreTelemetryRecord(&telemetry, &smooth);
+    PKRevealCoreTelemetryRecord(&telemetry, &janky);
+    PKRevealCoreTelemetryRecord(&telemetry, &back);
+    
+    const PKRevealCoreTransitionStatistics *statistics = PKRevealCoreTelemetryStatistics(&telemetry, PKRevealCoreStateFront, PKRevealCoreStateLeft);
+    
+    PKAssertEqual(statistics->transitionCount, 2);
+    PKAssertEqual(statistics->interactiveCount, 1);
+    PKAssertEqual(statistics->jankyCount, 1);
+    PKAssertEqual(statistics->latency.counts[4], 1);
+    PKAssertEqual(statistics->latency.counts[6], 1);
+    PKAssertEqual(statistics->droppedFrames.counts[0], 1);
+    PKAssertEqual(statistics->droppedFrames.counts[2], 1);
+    PKAssertEqual(statistics->duration.count, 2);
+    
+    statistics = PKRevealCoreTelemetryStatistics(&telemetry, PKRevealCoreStateLeft, PKRevealCoreStateFront);
+    
+    PKAssertEqual(statistics->transitionCount, 1);
+    PKAssertEqual(statistics->latency.count, 0);
+    
+    PKRevealCoreTelemetryReset(&telemetry);
+    PKAssertEqual(PKRevealCoreTelemetryStatistics(&telemetry, PKRevealCoreStateFront, PKRevealCoreStateLeft)->transitionCount, 0);
+}
+
+int main(void)
+{
+    PKRunTest(testHistogramBuckets);
+    PKRunTest(testHistogramPercentile);
+    PKRunTest(testTrackerMeasuresLatencyAndDroppedFrames);
+    PKRunTest(testTrackerWithoutMovementHasNoLatency);
+    PKRunTest(testTelemetryAggregatesPerStatePair);
+    
+    return PKTestResult();
+}
@@ -0,0 +1,61 @@
+//
+//  PKRevealCoreTestSupport.h
+//  PKRevealController
+//
+//  Minimal XCTest-style assertions for the headless reveal core tests.
+//
+
+#ifndef PKRevealCoreTestSupport_h
+#define PKRevealCoreTestSupport_h
+
+#include <math.h>
+#include <stdio.h>
+
+static int PKTestFailureCount = 0;
+static int PKTestCount = 0;
+
+#define PKAssertTrue(expression) \
+    do { \
+        if (!(expression)) \
+        { \
+            fprintf(stderr, "%s:%d: PKAssertTrue failed: %s\n", __FILE__, __LINE__, #expression); \
+            PKTestFailureCount++; \
+        } \
+    } while (0)
+
+#define PKAssertFalse(expression) PKAssertTrue(!(expression))
+
+#define PKAssertEqual(a, b) \
+    do { \
+        long long _a = (long long)(a); \
+        long long _b = (long long)(b); \
+        if (_a != _b) \
+        { \
+            fprintf(stderr, "%s:%d: PKAssertEqual failed: %s (%lld) != %s (%lld)\n", __FILE__, __LINE__, #a, _a, #b, _b); \
+            PKTestFailureCount++; \
+        } \
+    } while (0)
+
+#define PKAssertEqualWithAccuracy(a, b, accuracy) \
+    do { \
+        double _a = (double)(a); \
+        double _b = (double)(b); \
+        if (!(fabs(_a - _b) <= (accuracy))) \
+        { \
+            fprintf(stderr, "%s:%d: PKAssertEqualWithAccuracy failed: %s (%f) != %s (%f)\n", __FILE__, __LINE__, #a, _a, #b, _b); \
+            PKTestFailureCount++; \
+        } \
+    } while (0)
+
+#define PKRunTest(test) \
+    do { \
+        int _failures = PKTestFailureCount; \
+        PKTestCount++; \
+        test(); \
+        printf("%s %s\n", (_failures == PKTestFailureCount) ? "[PASS]" : "[FAIL]", #test); \
+    } while (0)
+
+#define PKTestResult() \
+    (printf("%d tests, %d failures\n", PKTestCount, PKTestFailureCount), (PKTestFailureCount == 0) ? 0 : 1)
+
+#endif
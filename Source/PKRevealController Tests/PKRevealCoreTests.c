@@ -0,0 +1,568 @@
+//
+//  PKRevealCoreTests.c
+//  PKRevealController
+//
+//  Headless tests of the reveal core gesture math.
+//
+
+#include "PKRevealCore.h"
+#include <math.h>
+#include "PKRevealCoreTestSupport.h"
+
+static PKRevealCoreGeometry PKDefaultGeometry(bool hasLeft, bool hasRight)
+{
+    // 320pt wide container, default width ranges [260, 300].
+    return PKRevealCoreGeometryMake(160.0,
+                                    PKRevealCoreWidthRangeMake(260.0, 300.0),
+                                    PKRevealCoreWidthRangeMake(260.0, 300.0),
+                                    hasLeft,
+                                    hasRight,
+                                    NULL);
+}
+
+#pragma mark - Geometry
+
+static void testGeometryAnchors(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreGeometryAnchor(&geometry, PKRevealCoreStateLeftPresentation), 460.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreGeometryAnchor(&geometry, PKRevealCoreStateLeft), 420.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreGeometryAnchor(&geometry, PKRevealCoreStateFront), 160.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreGeometryAnchor(&geometry, PKRevealCoreStateRight), -100.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreGeometryAnchor(&geometry, PKRevealCoreStateRightPresentation), -140.0, 0.001);
+    
+    PKAssertEqualWithAccuracy(geometry.leftSnapThreshold, 290.0, 0.001);
+    PKAssertEqualWithAccuracy(geometry.rightSnapThreshold, 30.0, 0.001);
+}
+
+#pragma mark - Dampening
+
+static void testDampeningIsIdentityAtMinimumWidth(void)
+{
+    PKRevealCoreDampening dampening = PKRevealCoreDampeningMake(PKRevealCoreDampeningCurveArctangent, PKRevealCoreDampeningDefaultLimit);
+    PKRevealCoreWidthRange range = PKRevealCoreWidthRangeMake(260.0, 300.0);
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreDampenedValue(&dampening, 260.0, range), 260.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreDampenedValue(&dampening, -260.0, range), -260.0, 0.001);
+}
+
+static void testDampeningApproachesLimitAsymptotically(void)
+{
+    PKRevealCoreDampening dampening = PKRevealCoreDampeningMake(PKRevealCoreDampeningCurveArctangent, PKRevealCoreDampeningDefaultLimit);
+    PKRevealCoreWidthRange range = PKRevealCoreWidthRangeMake(260.0, 300.0);
+    
+    // (2.5 / pi) * atan(1) = 0.625
+    PKAssertEqualWithAccuracy(PKRevealCoreDampenedValue(&dampening, 300.0, range), 285.0, 0.001);
+    PKAssertTrue(PKRevealCoreDampenedValue(&dampening, 10000.0, range) < 310.0);
+    PKAssertTrue(PKRevealCoreDampenedValue(&dampening, 400.0, range) > PKRevealCoreDampenedValue(&dampening, 350.0, range));
+}
+
+#pragma mark - Panning
+
+static void testPanIsClampedWithoutLeftView(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(false, true);
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreFrontViewPositionForPan(&geometry, 250.0, 160.0), 160.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreFrontViewPositionForPan(&geometry, 100.0, 160.0), 100.0, 0.001);
+}
+
+static void testPanIsClampedWithoutRightView(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, false);
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreFrontViewPositionForPan(&geometry, 50.0, 160.0), 160.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreFrontViewPositionForPan(&geometry, 200.0, 160.0), 200.0, 0.001);
+}
+
+static void testPanIsDampenedBeyondMinimumWidth(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    double x = PKRevealCoreFrontViewPositionForPan(&geometry, 460.0, 420.0);
+    PKAssertEqualWithAccuracy(x, 445.0, 0.001);
+    
+    x = PKRevealCoreFrontViewPositionForPan(&geometry, -140.0, -100.0);
+    PKAssertEqualWithAccuracy(x, -125.0, 0.001);
+}
+
+static void testPanIsUndampenedWithinMinimumWidth(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreFrontViewPositionForPan(&geometry, 300.0, 160.0), 300.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreFrontViewPositionForPan(&geometry, 0.0, 160.0), 0.0, 0.001);
+}
+
+static void testPanResumedDuringOverdrawDoesNotJump(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    double x = PKRevealCoreFrontViewPositionForPan(&geometry, 450.0, 420.0);
+    
+    // A new pan begins at the dampened position. Without moving the finger, the front view stays put.
+    double origin = PKRevealCorePanOrigin(&geometry, x);
+    PKAssertEqualWithAccuracy(origin, 450.0, 1e-6);
+    PKAssertEqualWithAccuracy(PKRevealCoreFrontViewPositionForPan(&geometry, PKRevealCoreProposedPanPosition(origin, 0.0, 0.0), x), x, 1e-9);
+    
+    x = PKRevealCoreFrontViewPositionForPan(&geometry, -150.0, -100.0);
+    PKAssertEqualWithAccuracy(PKRevealCorePanOrigin(&geometry, x), -150.0, 1e-6);
+    PKAssertEqualWithAccuracy(PKRevealCorePanOrigin(&geometry, 300.0), 300.0, 0.0);
+}
+
+static void testEdgePanTouchesWhileFocused(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKAssertTrue(PKRevealCoreIsEdgePanTouch(&geometry, PKRevealCoreStateFront, 10.0, 320.0, 20.0, 30.0));
+    PKAssertFalse(PKRevealCoreIsEdgePanTouch(&geometry, PKRevealCoreStateFront, 25.0, 320.0, 20.0, 30.0));
+    PKAssertFalse(PKRevealCoreIsEdgePanTouch(&geometry, PKRevealCoreStateFront, 160.0, 320.0, 20.0, 30.0));
+    PKAssertTrue(PKRevealCoreIsEdgePanTouch(&geometry, PKRevealCoreStateFront, 295.0, 320.0, 20.0, 30.0));
+    
+    geometry = PKDefaultGeometry(true, false);
+    PKAssertFalse(PKRevealCoreIsEdgePanTouch(&geometry, PKRevealCoreStateFront, 310.0, 320.0, 20.0, 30.0));
+}
+
+static void testEdgePanTouchesWhileRevealed(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKAssertTrue(PKRevealCoreIsEdgePanTouch(&geometry, PKRevealCoreStateLeft, 160.0, 320.0, 20.0, 30.0));
+    PKAssertTrue(PKRevealCoreIsEdgePanTouch(&geometry, PKRevealCoreStateRightPresentation, 160.0, 320.0, 20.0, 30.0));
+}
+
+#pragma mark - States
+
+static void testStateForPosition(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKAssertEqual(PKRevealCoreStateForPosition(&geometry, 160.0), PKRevealCoreStateFront);
+    PKAssertEqual(PKRevealCoreStateForPosition(&geometry, 161.0), PKRevealCoreStateLeft);
+    PKAssertEqual(PKRevealCoreStateForPosition(&geometry, 460.0), PKRevealCoreStateLeftPresentation);
+    PKAssertEqual(PKRevealCoreStateForPosition(&geometry, 159.0), PKRevealCoreStateRight);
+    PKAssertEqual(PKRevealCoreStateForPosition(&geometry, -140.0), PKRevealCoreStateRightPresentation);
+}
+
+static void testRoutesPassFrontViewBetweenOppositeSides(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKRevealCoreWaypoints waypoints = PKRevealCorePlanRoute(&geometry, PKRevealCoreStateLeft, PKRevealCoreStateRight);
+    PKAssertEqual(waypoints.count, 2);
+    PKAssertEqualWithAccuracy(waypoints.positions[0], 160.0, 0.001);
+    PKAssertEqualWithAccuracy(waypoints.positions[1], -100.0, 0.001);
+    
+    waypoints = PKRevealCorePlanRoute(&geometry, PKRevealCoreStateRightPresentation, PKRevealCoreStateLeftPresentation);
+    PKAssertEqual(waypoints.count, 2);
+    PKAssertEqualWithAccuracy(waypoints.positions[1], 460.0, 0.001);
+}
+
+static void testRoutesAreDirectOnTheSameSide(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKAssertEqual(PKRevealCorePlanRoute(&geometry, PKRevealCoreStateLeft, PKRevealCoreStateLeftPresentation).count, 1);
+    PKAssertEqual(PKRevealCorePlanRoute(&geometry, PKRevealCoreStateFront, PKRevealCoreStateRight).count, 1);
+    PKAssertEqual(PKRevealCorePlanRoute(&geometry, PKRevealCoreStateRight, PKRevealCoreStateFront).count, 1);
+    
+    PKRevealCoreWaypoints waypoints = PKRevealCorePlanRoute(&geometry, PKRevealCoreStateLeft, PKRevealCoreStateLeft);
+    PKAssertEqual(waypoints.count, 1);
+    PKAssertEqualWithAccuracy(waypoints.positions[0], 420.0, 0.001);
+}
+
+static void testRouteTableMatchesSides(void)
+{
+    for (int from = PKRevealCoreStateLeftPresentation; from <= PKRevealCoreStateRightPresentation; from++)
+    {
+        for (int to = PKRevealCoreStateLeftPresentation; to <= PKRevealCoreStateRightPresentation; to++)
+        {
+            const PKRevealCoreRoute *route = PKRevealCoreRouteForTransition((PKRevealCoreState)from, (PKRevealCoreState)to);
+            bool isOpposite = ((from < PKRevealCoreStateFront && to > PKRevealCoreStateFront) ||
+                               (from > PKRevealCoreStateFront && to < PKRevealCoreStateFront));
+            
+            PKAssertEqual(route->count, isOpposite ? 2 : 1);
+            PKAssertEqual(route->waypoints[route->count - 1], to);
+        }
+    }
+}
+
+#pragma mark - Reveal Effects
+
+static void testRevealProgressPerSide(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKRevealCoreRevealProgress front = PKRevealCoreRevealProgressForPosition(&geometry, 160.0);
+    PKAssertEqualWithAccuracy(front.left, 0.0, 0.001);
+    PKAssertEqualWithAccuracy(front.right, 0.0, 0.001);
+    
+    PKRevealCoreRevealProgress left = PKRevealCoreRevealProgressForPosition(&geometry, 225.0);
+    PKAssertEqualWithAccuracy(left.left, 0.25, 0.001);
+    PKAssertEqualWithAccuracy(left.right, 0.0, 0.001);
+    
+    PKRevealCoreRevealProgress right = PKRevealCoreRevealProgressForPosition(&geometry, 30.0);
+    PKAssertEqualWithAccuracy(right.left, 0.0, 0.001);
+    PKAssertEqualWithAccuracy(right.right, 0.5, 0.001);
+    
+    PKRevealCoreRevealProgress overdraw = PKRevealCoreRevealProgressForPosition(&geometry, 450.0);
+    PKAssertEqualWithAccuracy(overdraw.left, 1.0, 0.001);
+}
+
+static void testRevealTransformAtAnchors(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    PKRevealCoreRevealEffect effect = PKRevealCoreRevealEffectMake(0.3, 0.85);
+    
+    PKRevealCoreRevealTransform front = PKRevealCoreRevealTransformForPosition(&geometry, effect, 160.0);
+    PKAssertEqualWithAccuracy(front.frontScale, 1.0, 0.001);
+    PKAssertEqualWithAccuracy(front.leftTranslation, -78.0, 0.001);
+    PKAssertEqualWithAccuracy(front.rightTranslation, 78.0, 0.001);
+    
+    PKRevealCoreRevealTransform left = PKRevealCoreRevealTransformForPosition(&geometry, effect, 420.0);
+    PKAssertEqualWithAccuracy(left.frontScale, 0.85, 0.001);
+    PKAssertEqualWithAccuracy(left.leftTranslation, 0.0, 0.001);
+    
+    PKRevealCoreRevealTransform right = PKRevealCoreRevealTransformForPosition(&geometry, effect, -100.0);
+    PKAssertEqualWithAccuracy(right.frontScale, 0.85, 0.001);
+    PKAssertEqualWithAccuracy(right.rightTranslation, 0.0, 0.001);
+}
+
+static void testRevealTransformIsLinearBetweenAnchors(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    PKRevealCoreRevealEffect effect = PKRevealCoreRevealEffectMake(0.3, 0.85);
+    
+    PKRevealCoreRevealTransform halfway = PKRevealCoreRevealTransformForPosition(&geometry, effect, 290.0);
+    PKAssertEqualWithAccuracy(halfway.frontScale, 0.925, 0.001);
+    PKAssertEqualWithAccuracy(halfway.leftTranslation, -39.0, 0.001);
+    
+}
+
+static void testRevealTransformRestsDuringOverdraw(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    PKRevealCoreRevealEffect effect = PKRevealCoreRevealEffectMake(0.3, 0.85);
+    
+    // Beyond the minimum width the front view keeps its scale and the rear views stay at rest.
+    PKRevealCoreRevealTransform left = PKRevealCoreRevealTransformForPosition(&geometry, effect, 450.0);
+    PKAssertEqualWithAccuracy(left.frontScale, 0.85, 0.001);
+    PKAssertEqualWithAccuracy(left.leftTranslation, 0.0, 0.001);
+    
+    PKRevealCoreRevealTransform right = PKRevealCoreRevealTransformForPosition(&geometry, effect, -150.0);
+    PKAssertEqualWithAccuracy(right.frontScale, 0.85, 0.001);
+    PKAssertEqualWithAccuracy(right.rightTranslation, 0.0, 0.001);
+}
+
+static void testRevealKeyframesSplitRouteAtAnchors(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    PKRevealCoreWaypoints waypoints = PKRevealCorePlanRoute(&geometry, PKRevealCoreStateLeft, PKRevealCoreStateRight);
+    
+    PKRevealCoreRevealKeyframes keyframes = PKRevealCoreRevealKeyframesForRoute(&geometry, 450.0, &waypoints);
+    
+    PKAssertEqual(keyframes.count, 4);
+    PKAssertEqualWithAccuracy(keyframes.positions[1], 420.0, 0.001);
+    PKAssertEqualWithAccuracy(keyframes.positions[2], 160.0, 0.001);
+    PKAssertEqualWithAccuracy(keyframes.positions[3], -100.0, 0.001);
+    PKAssertEqualWithAccuracy(keyframes.keyTimes[0], 0.0, 0.001);
+    PKAssertEqualWithAccuracy(keyframes.keyTimes[1], 30.0 / 550.0, 0.001);
+    PKAssertEqualWithAccuracy(keyframes.keyTimes[2], 290.0 / 550.0, 0.001);
+    PKAssertEqualWithAccuracy(keyframes.keyTimes[3], 1.0, 0.001);
+}
+
+static void testRevealKeyframesWithoutDistance(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    PKRevealCoreWaypoints waypoints = PKRevealCorePlanRoute(&geometry, PKRevealCoreStateFront, PKRevealCoreStateFront);
+    
+    PKRevealCoreRevealKeyframes keyframes = PKRevealCoreRevealKeyframesForRoute(&geometry, 160.0, &waypoints);
+    
+    PKAssertEqual(keyframes.count, 2);
+    PKAssertEqualWithAccuracy(keyframes.keyTimes[1], 1.0, 0.001);
+}
+
+static void testRouteVelocityFollowsSegmentDirection(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    PKRevealCoreCurve linear = PKRevealCoreCurveMake(PKRevealCoreCurveControlPointsLinear);
+    PKRevealCoreWaypoints toRight = PKRevealCorePlanRoute(&geometry, PKRevealCoreStateLeft, PKRevealCoreStateRight);
+    PKRevealCoreWaypoints toLeft = PKRevealCorePlanRoute(&geometry, PKRevealCoreStateFront, PKRevealCoreStateLeft);
+    
+    // 520 points in 0.52 seconds, passing the center on the way.
+    PKAssertEqualWithAccuracy(PKRevealCoreRouteVelocity(420.0, &toRight, &linear, 0.52, 0.1), -1000.0, 0.1);
+    PKAssertEqualWithAccuracy(PKRevealCoreRouteVelocity(420.0, &toRight, &linear, 0.52, 0.4), -1000.0, 0.1);
+    PKAssertEqualWithAccuracy(PKRevealCoreRouteVelocity(160.0, &toLeft, &linear, 0.26, 0.1), 1000.0, 0.1);
+    
+    // An overdrawn front view first moves back to the left view's anchor.
+    PKAssertTrue(PKRevealCoreRouteVelocity(450.0, &toLeft, &linear, 0.3, 0.01) < 0.0);
+}
+
+static void testRouteVelocityFollowsTimingCurve(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    PKRevealCoreCurve easeInEaseOut = PKRevealCoreCurveMake(PKRevealCoreCurveControlPointsEaseInEaseOut);
+    PKRevealCoreWaypoints waypoints = PKRevealCorePlanRoute(&geometry, PKRevealCoreStateFront, PKRevealCoreStateLeft);
+    
+    PKAssertTrue(fabs(PKRevealCoreRouteVelocity(160.0, &waypoints, &easeInEaseOut, 0.26, 0.0)) < 50.0);
+    PKAssertTrue(PKRevealCoreRouteVelocity(160.0, &waypoints, &easeInEaseOut, 0.26, 0.13) > 1000.0);
+    PKAssertEqualWithAccuracy(PKRevealCoreRouteVelocity(160.0, &waypoints, &easeInEaseOut, 0.26, 0.26), 0.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreRouteVelocity(160.0, &waypoints, &easeInEaseOut, 0.0, 0.0), 0.0, 0.001);
+}
+
+#pragma mark - Release
+
+static void testSnapUsesHalfOfMinimumWidth(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKAssertEqual(PKRevealCoreSnapState(&geometry, 291.0), PKRevealCoreStateLeft);
+    PKAssertEqual(PKRevealCoreSnapState(&geometry, 289.0), PKRevealCoreStateFront);
+    PKAssertEqual(PKRevealCoreSnapState(&geometry, 29.0), PKRevealCoreStateRight);
+    PKAssertEqual(PKRevealCoreSnapState(&geometry, 31.0), PKRevealCoreStateFront);
+}
+
+static void testQuickSwipes(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKAssertTrue(PKRevealCoreShouldMoveLeftwards(-801.0, 800.0));
+    PKAssertFalse(PKRevealCoreShouldMoveLeftwards(-799.0, 800.0));
+    PKAssertTrue(PKRevealCoreShouldMoveRightwards(801.0, 800.0));
+    PKAssertFalse(PKRevealCoreShouldMoveRightwards(-801.0, 800.0));
+    
+    PKAssertEqual(PKRevealCoreStateForPanRelease(&geometry, PKRevealCoreStateFront, 170.0, 1000.0, 800.0), PKRevealCoreStateLeft);
+    PKAssertEqual(PKRevealCoreStateForPanRelease(&geometry, PKRevealCoreStateFront, 150.0, -1000.0, 800.0), PKRevealCoreStateRight);
+    PKAssertEqual(PKRevealCoreStateForPanRelease(&geometry, PKRevealCoreStateLeft, 400.0, -1000.0, 800.0), PKRevealCoreStateFront);
+    PKAssertEqual(PKRevealCoreStateForPanRelease(&geometry, PKRevealCoreStateLeftPresentation, 440.0, 1000.0, 800.0), PKRevealCoreStateLeftPresentation);
+    
+    geometry = PKDefaultGeometry(true, false);
+    PKAssertEqual(PKRevealCoreStateForPanRelease(&geometry, PKRevealCoreStateFront, 160.0, -1000.0, 800.0), PKRevealCoreStateFront);
+}
+
+static void testSlowReleaseSnaps(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    PKAssertEqual(PKRevealCoreStateForPanRelease(&geometry, PKRevealCoreStateLeft, 300.0, 100.0, 800.0), PKRevealCoreStateLeft);
+    PKAssertEqual(PKRevealCoreStateForPanRelease(&geometry, PKRevealCoreStateLeft, 250.0, 100.0, 800.0), PKRevealCoreStateFront);
+}
+
+#pragma mark - Momentum Projection
+
+static void testProjectionFollowsScrollViewDeceleration(void)
+{
+    // 0.8pt per millisecond * 0.998 / 0.002 = 399.2pt
+    PKAssertEqualWithAccuracy(PKRevealCoreProjectedPosition(160.0, 800.0, PKRevealCoreDecelerationRateNormal), 559.2, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreProjectedPosition(160.0, 0.0, PKRevealCoreDecelerationRateNormal), 160.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreProjectedPosition(160.0, 800.0, 1.0), 160.0, 0.001);
+}
+
+static void testProjectionPicksNearestAnchor(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, true);
+    
+    // A slow release settles close to where the view is.
+    PKAssertEqual(PKRevealCoreStateForProjectedRelease(&geometry, 300.0, 0.0, PKRevealCoreDecelerationRateNormal, true), PKRevealCoreStateLeft);
+    PKAssertEqual(PKRevealCoreStateForProjectedRelease(&geometry, 200.0, 0.0, PKRevealCoreDecelerationRateNormal, true), PKRevealCoreStateFront);
+    
+    // A flick from the left view reaches the right view in one go.
+    PKAssertEqual(PKRevealCoreStateForProjectedRelease(&geometry, 420.0, -1200.0, PKRevealCoreDecelerationRateNormal, false), PKRevealCoreStateRight);
+    
+    // A hard flick reaches presentation mode if allowed.
+    PKAssertEqual(PKRevealCoreStateForProjectedRelease(&geometry, 430.0, 400.0, PKRevealCoreDecelerationRateFast, true), PKRevealCoreStateLeftPresentation);
+    PKAssertEqual(PKRevealCoreStateForProjectedRelease(&geometry, 430.0, 400.0, PKRevealCoreDecelerationRateFast, false), PKRevealCoreStateLeft);
+}
+
+static void testProjectionSkipsMissingSides(void)
+{
+    PKRevealCoreGeometry geometry = PKDefaultGeometry(true, false);
+    
+    PKAssertEqual(PKRevealCoreStateForProjectedRelease(&geometry, 160.0, -2000.0, PKRevealCoreDecelerationRateNormal, true), PKRevealCoreStateFront);
+}
+
+#pragma mark - Motion
+
+static void testMotionStartsWithHandedOffVelocity(void)
+{
+    PKRevealCoreMotion motion = PKRevealCoreMotionMake(300.0, 420.0, 200.0, 0.5);
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreMotionPosition(&motion, 0.0), 300.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreMotionVelocity(&motion, 0.0), 200.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreMotionPosition(&motion, 0.5), 420.0, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreMotionVelocity(&motion, 0.5), 0.0, 0.001);
+    PKAssertTrue(PKRevealCoreMotionIsFinished(&motion, 0.5));
+}
+
+static void testMotionNeverOvershoots(void)
+{
+    PKRevealCoreMotion motion = PKRevealCoreMotionMake(300.0, 420.0, 5000.0, 0.5);
+    double previous = motion.from;
+    
+    PKAssertEqualWithAccuracy(motion.velocity, 720.0, 0.001);
+    
+    for (int frame = 1; frame <= 30; frame++)
+    {
+        double position = PKRevealCoreMotionPosition(&motion, frame / 60.0);
+        PKAssertTrue(position >= previous);
+        PKAssertTrue(position <= 420.0 + 0.001);
+        previous = position;
+    }
+}
+
+static void testMotionRetargetingIsContinuous(void)
+{
+    PKRevealCoreMotion motion = PKRevealCoreMotionMake(160.0, 420.0, 0.0, 0.5);
+    double position = PKRevealCoreMotionPosition(&motion, 0.2);
+    double velocity = PKRevealCoreMotionVelocity(&motion, 0.2);
+    
+    PKRevealCoreMotion retargeted = PKRevealCoreMotionMake(position, 160.0, velocity, 0.5);
+    
+    PKAssertEqualWithAccuracy(PKRevealCoreMotionPosition(&retargeted, 0.0), position, 0.001);
+    PKAssertEqualWithAccuracy(PKRevealCoreMotionVelocity(&retargeted, 0.0), velocity, 0.001);
+}
+
+/// Samples the unbounded motion to find the last time it was further than the resting distance from its target.
+static double PKLastTimeOutsideRestingDistance(const PKRevealCoreMotion *motion, double restingDistance)
+{
+    PKRevealCoreMotion unbounded = *motion;
+    unbounded.duration = 10.0;
+    double last = 0.0;
+    
+    for (double time = 0.0; time < 5.0; time += 0.0005)
+    {
+        if (fabs(PKRevealCoreMotionPosition(&unbounded, time) - motion->to) > restingDistance)
+        {
+            last = time;
+        }
+    }
+    
+    return last;
+}
+
+static void testSpringMotionStartsWithHandedOffVelocity(void)
+{
+    PKRevealCoreSpring springs[3] = {
+        PKRevealCoreSpringMake(1.0, 600.0, 30.0),
+        PKRevealCoreSpringMake(1.0, 600.0, 2.0 * sqrt(600.0)),
+        PKRevealCoreSpringMake(1.0, 600.0, 80.0)
+    };
+    
+    for (int index = 0; index < 3; index++)
+    {
+        PKRevealCoreMotion motion = PKRevealCoreMotionMakeSpring(300.0, 420.0, 500.0, springs[index], 0.5);
+        
+        PKAssertEqualWithAccuracy(PKRevealCoreMotionPosition(&motion, 1e-9), 300.0, 0.001);
+        PKAssertEqualWithAccuracy(PKRevealCoreMotionVelocity(&motion, 1e-9), 500.0, 0.01);
+        PKAssertEqualWithAccuracy(PKRevealCoreMotionPosition(&motion, motion.duration), 420.0, 0.001);
+    }
+}
+
+static void testSpringSettlingTimeBoundsOscillation(void)
+{
+    PKRevealCoreSpring springs[3] = {
+        PKRevealCoreSpringMake(1.0, 600.0, 30.0),
+        PKRevealCoreSpringMake(1.0, 600.0, 2.0 * sqrt(600.0)),
+        PKRevealCoreSpringMake(1.0, 600.0, 80.0)
+    };
+    
+    for (int index = 0; index < 3; index++)
+    {
+        PKRevealCoreMotion motion = PKRevealCoreMotionMakeSpring(160.0, 420.0, -300.0, springs[index], 0.5);
+        double settled = PKLastTimeOutsideRestingDistance(&motion, 0.5);
+        
+        // The envelope bound must not cut the oscillation short, nor run much longer than it.
+        PKAssertTrue(motion.duration >= settled);
+        PKAssertTrue(motion.duration <= settled * 1.5 + 0.05);
+    }
+}
+
+static void testSpringSettlingTimeScalesWithDistanceAndVelocity(void)
+{
+    PKRevealCoreSpring spring = PKRevealCoreSpringMake(1.0, 600.0, 2.0 * sqrt(600.0));
+    
+    PKRevealCoreMotion shortMotion = PKRevealCoreMotionMakeSpring(400.0, 420.0, 0.0, spring, 0.5);
+    PKRevealCoreMotion longMotion = PKRevealCoreMotionMakeSpring(160.0, 420.0, 0.0, spring, 0.5);
+    PKRevealCoreMotion thrownMotion = PKRevealCoreMotionMakeSpring(160.0, 420.0, -2000.0, spring, 0.5);
+    PKRevealCoreMotion restingMotion = PKRevealCoreMotionMakeSpring(420.0, 420.0, 0.0, spring, 0.5);
+    
+    PKAssertTrue(shortMotion.duration < longMotion.duration);
+    PKAssertTrue(longMotion.duration < thrownMotion.duration);
+    PKAssertEqualWithAccuracy(restingMotion.duration, 0.0, 0.0001);
+}
+
+static void testDegenerateSpringsAreClamped(void)
+{
+    PKRevealCoreSpring springs[4] = {
+        PKRevealCoreSpringMake(0.0, 600.0, 60.0),
+        PKRevealCoreSpringMake(1.0, 0.0, 60.0),
+        PKRevealCoreSpringMake(1.0, 600.0, 0.0),
+        PKRevealCoreSpringMake(NAN, -5.0, NAN)
+    };
+    
+    for (int index = 0; index < 4; index++)
+    {
+        PKRevealCoreSpring clamped = PKRevealCoreSpringClamped(springs[index]);
+        PKAssertTrue(clamped.mass >= PKRevealCoreSpringMinimumMass);
+        PKAssertTrue(clamped.stiffness >= PKRevealCoreSpringMinimumStiffness);
+        PKAssertTrue(clamped.damping > 0.0);
+        
+        // The motion must come to rest at its target in finite, non-zero time.
+        PKRevealCoreMotion motion = PKRevealCoreMotionMakeSpring(160.0, 420.0, 0.0, springs[index], 0.5);
+        PKAssertTrue(isfinite(motion.duration));
+        PKAssertTrue(motion.duration > 0.0);
+        PKAssertEqualWithAccuracy(PKRevealCoreMotionPosition(&motion, motion.duration + 1.0), 420.0, 0.001);
+        PKAssertTrue(PKRevealCoreMotionIsFinished(&motion, motion.duration + 1.0));
+    }
+}
+
+static void testValidSpringsAreNotClamped(void)
+{
+    PKRevealCoreSpring spring = PKRevealCoreSpringClamped(PKRevealCoreSpringMake(1.0, 900.0, 60.0));
+    
+    PKAssertEqualWithAccuracy(spring.mass, 1.0, 0.0001);
+    PKAssertEqualWithAccuracy(spring.stiffness, 900.0, 0.0001);
+    PKAssertEqualWithAccuracy(spring.damping, 60.0, 0.0001);
+}
+
+int main(void)
+{
+    PKRunTest(testGeometryAnchors);
+    PKRunTest(testDampeningIsIdentityAtMinimumWidth);
+    PKRunTest(testDampeningApproachesLimitAsymptotically);
+    PKRunTest(testPanIsClampedWithoutLeftView);
+    PKRunTest(testPanIsClampedWithoutRightView);
+    PKRunTest(testPanIsDampenedBeyondMinimumWidth);
+    PKRunTest(testPanIsUndampenedWithinMinimumWidth);
+    PKRunTest(testPanResumedDuringOverdrawDoesNotJump);
+    PKRunTest(testEdgePanTouchesWhileFocused);
+    PKRunTest(testEdgePanTouchesWhileRevealed);
+    PKRunTest(testStateForPosition);
+    PKRunTest(testRoutesPassFrontViewBetweenOppositeSides);
+    PKRunTest(testRoutesAreDirectOnTheSameSide);
+    PKRunTest(testRouteTableMatchesSides);
+    PKRunTest(testRevealProgressPerSide);
+    PKRunTest(testRevealTransformAtAnchors);
+    PKRunTest(testRevealTransformIsLinearBetweenAnchors);
+    PKRunTest(testRevealTransformRestsDuringOverdraw);
+    PKRunTest(testRevealKeyframesSplitRouteAtAnchors);
+    PKRunTest(testRevealKeyframesWithoutDistance);
+    PKRunTest(testRouteVelocityFollowsSegmentDirection);
+    PKRunTest(testRouteVelocityFollowsTimingCurve);
+    PKRunTest(testSnapUsesHalfOfMinimumWidth);
+    PKRunTest(testQuickSwipes);
+    PKRunTest(testSlowReleaseSnaps);
+    PKRunTest(testProjectionFollowsScrollViewDeceleration);
+    PKRunTest(testProjectionPicksNearestAnchor);
+    PKRunTest(testProjectionSkipsMissingSides);
+    PKRunTest(testMotionStartsWithHandedOffVelocity);
+    PKRunTest(testMotionNeverOvershoots);
+    PKRunTest(testMotionRetargetingIsContinuous);
+    PKRunTest(testSpringMotionStartsWithHandedOffVelocity);
+    PKRunTest(testSpringSettlingTimeBoundsOscillation);
+    PKRunTest(testSpringSettlingTimeScalesWithDistanceAndVelocity);
+    PKRunTest(testDegenerateSpringsAreClamped);
+    PKRunTest(testValidSpringsAreNotClamped);
+    
+    return PKTestResult();
+}
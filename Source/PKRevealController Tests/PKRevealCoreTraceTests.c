@@ -0,0 +1,282 @@
+//
+//  PKRevealCoreTraceTests.c
+//  PKRevealController
+//
+//  Headless tests of gesture trace encoding and deterministic replay.
+//
+
+#include "PKRevealCoreTrace.h"
+#include "PKRevealCoreTestSupport.h"
+#include <math.h>
+#include <string.h>
+
+#define PKTraceTestSampleCount 13
+#define PKTraceTestFrameCapacity 512
+
+static PKRevealCoreTraceHeader PKTraceTestHeader(void)
+{
+    PKRevealCoreTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    
+    header.leftRange = PKRevealCoreWidthRangeMake(260.0, 300.0);
+    header.rightRange = PKRevealCoreWidthRangeMake(260.0, 300.0);
+    header.midX = 160.0;
+    header.initialPosition = 160.0;
+    header.quickSwipeVelocity = 800.0;
+    header.decelerationRate = PKRevealCoreDecelerationRateNormal;
+    header.animationDuration = 0.185;
+    header.spring = PKRevealCoreSpringMake(1.0, 300.0, 30.0);
+    header.initialState = PKRevealCoreStateFront;
+    header.hasLeft = true;
+    header.hasRight = true;
+    
+    return header;
+}
+
+/// A short rightward flick: ten pan updates 1/60s apart, then a quick release.
+static size_t PKTraceTestFlick(PKRevealCoreTraceSample *samples)
+{
+    size_t count = 0;
+    
+    samples[count++] = (PKRevealCoreTraceSample){ 10.0, 0.0f, 0.0f, PKRevealCoreTraceSampleKindPanBegan, PKRevealCoreStateFront };
+    
+    for (int index = 1; index <= 10; index++)
+    {
+        samples[count++] = (PKRevealCoreTraceSample){ 10.0 + (index / 60.0), 12.0f * index, 720.0f, PKRevealCoreTraceSampleKindPanChanged, PKRevealCoreStateFront };
+    }
+    
+    samples[count++] = (PKRevealCoreTraceSample){ 10.0 + (11 / 60.0), 120.0f, 900.0f, PKRevealCoreTraceSampleKindPanEnded, PKRevealCoreStateFront };
+    samples[count++] = (PKRevealCoreTraceSample){ 10.5, 0.0f, 0.0f, PKRevealCoreTraceSampleKindStateChange, PKRevealCoreStateLeft };
+    
+    return count;
+}
+
+/// A slow pan far beyond the left view's minimum width, released without velocity.
+static size_t PKTraceTestOverdraw(PKRevealCoreTraceSample *samples)
+{
+    size_t count = 0;
+    
+    samples[count++] = (PKRevealCoreTraceSample){ 10.0, 0.0f, 0.0f, PKRevealCoreTraceSampleKindPanBegan, PKRevealCoreStateFront };
+    
+    for (int index = 1; index <= 10; index++)
+    {
+        samples[count++] = (PKRevealCoreTraceSample){ 10.0 + (index / 60.0), 36.0f * index, 0.0f, PKRevealCoreTraceSampleKindPanChanged, PKRevealCoreStateFront };
+    }
+    
+    samples[count++] = (PKRevealCoreTraceSample){ 10.0 + (11 / 60.0), 360.0f, 0.0f, PKRevealCoreTraceSampleKindPanEnded, PKRevealCoreStateFront };
+    
+    return count;
+}
+
+/// Encodes and decodes a trace, then replays the decoded trace.
+static void PKTraceTestReplayRoundTrip(const PKRevealCoreTraceHeader *header,
+                                       const PKRevealCoreTraceSample *samples,
+                                       size_t count,
+                                       double *positions,
+                                       PKRevealCoreReplayResult *result)
+{
+    uint8_t bytes[PKRevealCoreTraceHeaderSize + PKRevealCoreTraceDampeningTableSize + (PKTraceTestSampleCount * PKRevealCoreTraceSampleSize)];
+    size_t headerLength = PKRevealCoreTraceHeaderLength(header);
+    
+    PKRevealCoreTraceEncodeHeader(header, bytes);
+    
+    for (size_t index = 0; index < count; index++)
+    {
+        PKRevealCoreTraceEncodeSample(&samples[index], bytes + headerLength + (index * PKRevealCoreTraceSampleSize));
+    }
+    
+    PKRevealCoreTraceHeader decodedHeader;
+    PKRevealCoreTraceSample decodedSamples[PKTraceTestSampleCount];
+    long decodedCount = PKRevealCoreTraceDecode(bytes, headerLength + (count * PKRevealCoreTraceSampleSize), &decodedHeader, decodedSamples, PKTraceTestSampleCount);
+    
+    PKAssertEqual(decodedCount, count);
+    PKAssertEqual(decodedHeader.dampening.curve, header->dampening.curve);
+    
+    PKRevealCoreReplay(&decodedHeader, decodedSamples, count, 1.0 / 60.0, positions, PKTraceTestFrameCapacity, result);
+}
+
+#pragma mark - Encoding
+
+static void testTraceRoundTrip(void)
+{
+    PKRevealCoreTraceHeader header = PKTraceTestHeader();
+    PKRevealCoreTraceSample samples[PKTraceTestSampleCount];
+    size_t count = PKTraceTestFlick(samples);
+    uint8_t bytes[PKRevealCoreTraceHeaderSize + (PKTraceTestSampleCount * PKRevealCoreTraceSampleSize)];
+    
+    header.usesSpring = true;
+    header.projectsMomentum = true;
+    
+    PKRevealCoreTraceEncodeHeader(&header, bytes);
+    
+    for (size_t index = 0; index < count; index++)
+    {
+        PKRevealCoreTraceEncodeSample(&samples[index], bytes + PKRevealCoreTraceHeaderSize + (index * PKRevealCoreTraceSampleSize));
+    }
+    
+    PKRevealCoreTraceHeader decodedHeader;
+    PKRevealCoreTraceSample decodedSamples[PKTraceTestSampleCount];
+    long decodedCount = PKRevealCoreTraceDecode(bytes, sizeof(bytes), &decodedHeader, decodedSamples, PKTraceTestSampleCount);
+    
+    PKAssertEqual(decodedCount, count);
+    PKAssertEqual(decodedHeader.initialState, PKRevealCoreStateFront);
+    PKAssertTrue(decodedHeader.hasLeft && decodedHeader.hasRight);
+    PKAssertTrue(decodedHeader.usesSpring && decodedHeader.projectsMomentum);
+    PKAssertFalse(decodedHeader.includesPresentationModes);
+    PKAssertEqualWithAccuracy(decodedHeader.leftRange.maximum, 300.0, 0.0);
+    PKAssertEqualWithAccuracy(decodedHeader.spring.damping, 30.0, 0.0);
+    PKAssertEqualWithAccuracy(decodedHeader.decelerationRate, PKRevealCoreDecelerationRateNormal, 0.0);
+    
+    for (size_t index = 0; index < count; index++)
+    {
+        PKAssertEqualWithAccuracy(decodedSamples[index].time, samples[index].time, 0.0);
+        PKAssertEqualWithAccuracy(decodedSamples[index].translation, samples[index].translation, 0.0);
+        PKAssertEqualWithAccuracy(decodedSamples[index].velocity, samples[index].velocity, 0.0);
+        PKAssertEqual(decodedSamples[index].kind, samples[index].kind);
+        PKAssertEqual(decodedSamples[index].state, samples[index].state);
+    }
+}
+
+static void testMalformedTracesAreRejected(void)
+{
+    PKRevealCoreTraceHeader header = PKTraceTestHeader();
+    uint8_t bytes[PKRevealCoreTraceHeaderSize + PKRevealCoreTraceSampleSize];
+    
+    PKRevealCoreTraceEncodeHeader(&header, bytes);
+    memset(bytes + PKRevealCoreTraceHeaderSize, 0, PKRevealCoreTraceSampleSize);
+    
+    PKAssertEqual(PKRevealCoreTraceDecode(bytes, sizeof(bytes), &header, NULL, 0), 1);
+    PKAssertEqual(PKRevealCoreTraceDecode(bytes, sizeof(bytes) - 1, &header, NULL, 0), -1);
+    PKAssertEqual(PKRevealCoreTraceDecode(bytes, PKRevealCoreTraceHeaderSize - 1, &header, NULL, 0), -1);
+    
+    bytes[0] = 'X';
+    PKAssertEqual(PKRevealCoreTraceDecode(bytes, sizeof(bytes), &header, NULL, 0), -1);
+    
+    // Unknown dampening curves, and tables that are cut off, are rejected too.
+    PKRevealCoreTraceEncodeHeader(&header, bytes);
+    bytes[12] = 9;
+    PKAssertEqual(PKRevealCoreTraceDecode(bytes, sizeof(bytes), &header, NULL, 0), -1);
+    
+    bytes[12] = (uint8_t)PKRevealCoreDampeningCurveTable;
+    PKAssertEqual(PKRevealCoreTraceDecode(bytes, sizeof(bytes), &header, NULL, 0), -1);
+}
+
+#pragma mark - Replay
+
+static void testFlickReplaysToLeftView(void)
+{
+    PKRevealCoreTraceHeader header = PKTraceTestHeader();
+    PKRevealCoreTraceSample samples[PKTraceTestSampleCount];
+    size_t count = PKTraceTestFlick(samples);
+    double positions[PKTraceTestFrameCapacity];
+    PKRevealCoreReplayResult result;
+    
+    PKRevealCoreReplay(&header, samples, count, 1.0 / 60.0, positions, PKTraceTestFrameCapacity, &result);
+    
+    PKAssertEqual(result.finalState, PKRevealCoreStateLeft);
+    PKAssertEqualWithAccuracy(positions[0], 160.0, 0.0);
+    PKAssertEqualWithAccuracy(positions[10], 280.0, 0.0001);
+    PKAssertEqualWithAccuracy(positions[result.frameCount - 1], 420.0, 0.0001);
+    PKAssertEqualWithAccuracy(result.settleDuration, 0.185, 1.0 / 60.0);
+    PKAssertTrue(result.maximumFrameDistance < 40.0);
+}
+
+static void testSpringReplayComesToRest(void)
+{
+    PKRevealCoreTraceHeader header = PKTraceTestHeader();
+    PKRevealCoreTraceSample samples[PKTraceTestSampleCount];
+    size_t count = PKTraceTestFlick(samples);
+    double positions[PKTraceTestFrameCapacity];
+    PKRevealCoreReplayResult result;
+    
+    header.usesSpring = true;
+    header.projectsMomentum = true;
+    
+    PKRevealCoreReplay(&header, samples, count, 1.0 / 60.0, positions, PKTraceTestFrameCapacity, &result);
+    
+    PKAssertEqual(result.finalState, PKRevealCoreStateLeft);
+    PKAssertTrue(result.frameCount < PKTraceTestFrameCapacity);
+    PKAssertEqualWithAccuracy(positions[result.frameCount - 1], 420.0, 0.5);
+}
+
+static void testReplayIsDeterministic(void)
+{
+    PKRevealCoreTraceHeader header = PKTraceTestHeader();
+    PKRevealCoreTraceSample samples[PKTraceTestSampleCount];
+    size_t count = PKTraceTestFlick(samples);
+    double first[PKTraceTestFrameCapacity];
+    double second[PKTraceTestFrameCapacity];
+    PKRevealCoreReplayResult firstResult;
+    PKRevealCoreReplayResult secondResult;
+    
+    header.usesSpring = true;
+    
+    PKRevealCoreReplay(&header, samples, count, 1.0 / 120.0, first, PKTraceTestFrameCapacity, &firstResult);
+    PKRevealCoreReplay(&header, samples, count, 1.0 / 120.0, second, PKTraceTestFrameCapacity, &secondResult);
+    
+    PKAssertEqual(firstResult.frameCount, secondResult.frameCount);
+    PKAssertTrue(memcmp(first, second, sizeof(double) * firstResult.frameCount) == 0);
+}
+
+static void testDampeningCurveIsReplayed(void)
+{
+    PKRevealCoreTraceHeader header = PKTraceTestHeader();
+    PKRevealCoreTraceSample samples[PKTraceTestSampleCount];
+    size_t count = PKTraceTestOverdraw(samples);
+    double arctangent[PKTraceTestFrameCapacity];
+    double rubberBand[PKTraceTestFrameCapacity];
+    double recorded[PKTraceTestFrameCapacity];
+    PKRevealCoreReplayResult arctangentResult;
+    PKRevealCoreReplayResult rubberBandResult;
+    PKRevealCoreReplayResult recordedResult;
+    
+    header.dampening = PKRevealCoreDampeningMake(PKRevealCoreDampeningCurveArctangent, PKRevealCoreDampeningDefaultLimit);
+    PKRevealCoreReplay(&header, samples, count, 1.0 / 60.0, arctangent, PKTraceTestFrameCapacity, &arctangentResult);
+    
+    header.dampening = PKRevealCoreDampeningMake(PKRevealCoreDampeningCurveRubberBand, PKRevealCoreDampeningDefaultLimit);
+    PKRevealCoreReplay(&header, samples, count, 1.0 / 60.0, recorded, PKTraceTestFrameCapacity, &recordedResult);
+    PKTraceTestReplayRoundTrip(&header, samples, count, rubberBand, &rubberBandResult);
+    
+    // The curve survives the round trip, and the pan positions depend on it.
+    PKAssertEqual(rubberBandResult.frameCount, recordedResult.frameCount);
+    PKAssertTrue(memcmp(rubberBand, recorded, sizeof(double) * recordedResult.frameCount) == 0);
+    PKAssertTrue(fabs(rubberBand[10] - arctangent[10]) > 1.0);
+}
+
+static void testCustomDampeningTableIsReplayed(void)
+{
+    PKRevealCoreTraceHeader header = PKTraceTestHeader();
+    PKRevealCoreTraceSample samples[PKTraceTestSampleCount];
+    size_t count = PKTraceTestOverdraw(samples);
+    const double values[] = { 0.0, 0.2, 0.3, 0.35 };
+    double replayed[PKTraceTestFrameCapacity];
+    double recorded[PKTraceTestFrameCapacity];
+    PKRevealCoreReplayResult replayedResult;
+    PKRevealCoreReplayResult recordedResult;
+    
+    header.dampening = PKRevealCoreDampeningMakeTable(values, 4, 3.0);
+    
+    PKRevealCoreReplay(&header, samples, count, 1.0 / 60.0, recorded, PKTraceTestFrameCapacity, &recordedResult);
+    PKTraceTestReplayRoundTrip(&header, samples, count, replayed, &replayedResult);
+    
+    PKAssertEqual(PKRevealCoreTraceHeaderLength(&header), PKRevealCoreTraceHeaderSize + PKRevealCoreTraceDampeningTableSize);
+    PKAssertEqual(replayedResult.frameCount, recordedResult.frameCount);
+    PKAssertEqual(replayedResult.finalState, recordedResult.finalState);
+    PKAssertTrue(memcmp(replayed, recorded, sizeof(double) * recordedResult.frameCount) == 0);
+    
+    // The table holds the front view within 0.35 of the width range, i.e. 14 points, beyond the minimum width.
+    PKAssertTrue(replayed[10] <= 420.0 + 14.0 + 0.001);
+}
+
+int main(void)
+{
+    PKRunTest(testTraceRoundTrip);
+    PKRunTest(testMalformedTracesAreRejected);
+    PKRunTest(testFlickReplaysToLeftView);
+    PKRunTest(testSpringReplayComesToRest);
+    PKRunTest(testReplayIsDeterministic);
+    PKRunTest(testDampeningCurveIsReplayed);
+    PKRunTest(testCustomDampeningTableIsReplayed);
+    
+    return PKTestResult();
+}
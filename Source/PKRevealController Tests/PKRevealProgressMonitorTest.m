@@ -0,0 +1,152 @@
+//
+//  PKRevealProgressMonitorTest.m
+//  PKRevealController
+//
+//  Copyright (c) 2015 zuui.org (Philip Kluz). All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+#import "PKRevealProgressMonitor.h"
+
+@interface PKRevealProgressMonitorTest : XCTestCase
+
+@property CALayer *layer;
+@property PKRevealProgressMonitor *monitor;
+
+@end
+
+@implementation PKRevealProgressMonitorTest
+
+- (void)setUp {
+    [super setUp];
+    
+    self.layer = [CALayer layer];
+    self.layer.position = CGPointMake(160.0, 240.0);
+    self.monitor = [PKRevealProgressMonitor monitorForLayer:self.layer];
+    
+    // 320pt wide container, default width ranges [260, 300].
+    self.monitor.progressForPosition = ^PKRevealCoreRevealProgress(CGFloat position)
+    {
+        PKRevealCoreGeometry geometry = PKRevealCoreGeometryMake(160.0,
+                                                                 PKRevealCoreWidthRangeMake(260.0, 300.0),
+                                                                 PKRevealCoreWidthRangeMake(260.0, 300.0),
+                                                                 true,
+                                                                 true,
+                                                                 NULL);
+        return PKRevealCoreRevealProgressForPosition(&geometry, position);
+    };
+}
+
+- (void)tearDown {
+    [self.monitor endMonitoring];
+    [super tearDown];
+}
+
+#pragma mark - Coalescing
+- (void)testThatPanUpdatesAreCoalescedUntilTheNextFrame
+{
+    // given
+    __block NSUInteger calls = 0;
+    __block CGFloat leftProgress = 0.0;
+    
+    [self.monitor addObserverForEvents:PKRevealProgressEventAll usingBlock:^(PKRevealCoreRevealProgress progress, PKRevealProgressEvents events)
+    {
+        calls++;
+        leftProgress = progress.left;
+        XCTAssertTrue(events & PKRevealProgressEventInteractive);
+        XCTAssertTrue(events & PKRevealProgressEventLeft);
+    }];
+    [self.monitor beginMonitoring];
+    
+    // when
+    [self.monitor setNeedsUpdateWithInteractivePosition:190.0];
+    [self.monitor setNeedsUpdateWithInteractivePosition:225.0];
+    
+    // then
+    XCTAssertEqual(calls, 0);
+    
+    // when
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    
+    // then
+    XCTAssertEqual(calls, 1);
+    XCTAssertEqualWithAccuracy(leftProgress, 0.25, 0.001);
+}
+
+#pragma mark - Event mask
+- (void)testThatObserversOnlyReceiveMatchingEvents
+{
+    // given
+    __block NSUInteger leftCalls = 0;
+    __block NSUInteger rightCalls = 0;
+    
+    [self.monitor addObserverForEvents:(PKRevealProgressEventLeft | PKRevealProgressEventAutomatic) usingBlock:^(PKRevealCoreRevealProgress progress, PKRevealProgressEvents events)
+    {
+        leftCalls++;
+    }];
+    [self.monitor addObserverForEvents:(PKRevealProgressEventRight | PKRevealProgressEventAutomatic) usingBlock:^(PKRevealCoreRevealProgress progress, PKRevealProgressEvents events)
+    {
+        rightCalls++;
+    }];
+    
+    // when
+    self.layer.position = CGPointMake(420.0, 240.0);
+    [self.monitor update];
+    
+    // then
+    XCTAssertEqual(leftCalls, 1);
+    XCTAssertEqual(rightCalls, 0);
+    XCTAssertEqualWithAccuracy(self.monitor.progress.left, 1.0, 0.001);
+    
+    // when
+    [self.monitor update];
+    
+    // then
+    XCTAssertEqual(leftCalls, 1);
+}
+
+- (void)testThatRemovedObserversAreNotCalled
+{
+    // given
+    __block NSUInteger calls = 0;
+    
+    id observer = [self.monitor addObserverForEvents:PKRevealProgressEventAll usingBlock:^(PKRevealCoreRevealProgress progress, PKRevealProgressEvents events)
+    {
+        calls++;
+    }];
+    
+    // when
+    [self.monitor removeObserver:observer];
+    self.layer.position = CGPointMake(420.0, 240.0);
+    [self.monitor update];
+    
+    // then
+    XCTAssertEqual(calls, 0);
+    XCTAssertFalse(self.monitor.hasObservers);
+}
+
+#pragma mark - Monitoring
+- (void)testThatEndingReportsPendingPanUpdate
+{
+    // given
+    __block CGFloat rightProgress = 0.0;
+    
+    [self.monitor addObserverForEvents:PKRevealProgressEventAll usingBlock:^(PKRevealCoreRevealProgress progress, PKRevealProgressEvents events)
+    {
+        rightProgress = progress.right;
+    }];
+    [self.monitor beginMonitoring];
+    [self.monitor setNeedsUpdateWithInteractivePosition:30.0];
+    
+    // when
+    self.layer.position = CGPointMake(30.0, 240.0);
+    [self.monitor endMonitoring];
+    
+    // then
+    XCTAssertEqualWithAccuracy(rightProgress, 0.5, 0.001);
+    XCTAssertFalse(self.monitor.isMonitoring);
+}
+
+@end
@@ -0,0 +1,139 @@
+//
+//  PKSequentialAnimationTest.m
+//  PKRevealController
+//
+//  Copyright (c) 2015 zuui.org (Philip Kluz). All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+#import "PKSequentialAnimation.h"
+
+@interface PKSequentialAnimationTest : XCTestCase
+
+@property CALayer *layer;
+
+@end
+
+@implementation PKSequentialAnimationTest
+
+- (void)setUp {
+    [super setUp];
+    
+    self.layer = [CALayer layer];
+    self.layer.position = CGPointMake(420.0, 0.0);
+}
+
+- (void)tearDown {
+    [self.layer removeAllAnimations];
+    [super tearDown];
+}
+
+#pragma mark - Keyframe mode
+- (void)testKeyframeModeCommitsSingleAnimation
+{
+    // given - left view to right view, passing the front view
+    PKSequentialAnimation *animation = [PKSequentialAnimation animationForKeyPath:@"position"
+                                                                           values:@[[NSValue valueWithCGPoint:CGPointMake(160.0, 0.0)],
+                                                                                    [NSValue valueWithCGPoint:CGPointMake(-140.0, 0.0)]]
+                                                                         duration:1.0];
+    animation.mode = PKSequentialAnimationModeKeyframe;
+    
+    // when
+    [animation startAnimationOnLayer:self.layer];
+    
+    // then
+    XCTAssertEqual([self.layer.animationKeys count], 1);
+    
+    CAKeyframeAnimation *keyframeAnimation = (CAKeyframeAnimation *)[self.layer animationForKey:[self.layer.animationKeys firstObject]];
+    XCTAssertTrue([keyframeAnimation isKindOfClass:[CAKeyframeAnimation class]]);
+    XCTAssertEqual([keyframeAnimation.values count], 3);
+    XCTAssertEqual([keyframeAnimation.timingFunctions count], 2);
+    XCTAssertEqualWithAccuracy(keyframeAnimation.duration, 1.0, 0.0001);
+    XCTAssertEqualWithAccuracy(self.layer.position.x, -140.0, 0.001);
+}
+
+- (void)testKeyframeTimesAreProportionalToSegmentLength
+{
+    // given
+    PKSequentialAnimation *animation = [PKSequentialAnimation animationForKeyPath:@"position"
+                                                                           values:@[[NSValue valueWithCGPoint:CGPointMake(160.0, 0.0)],
+                                                                                    [NSValue valueWithCGPoint:CGPointMake(-140.0, 0.0)]]
+                                                                         duration:1.0];
+    animation.mode = PKSequentialAnimationModeKeyframe;
+    
+    // when
+    [animation startAnimationOnLayer:self.layer];
+    
+    // then - 260pt of 560pt are covered by the first segment
+    CAKeyframeAnimation *keyframeAnimation = (CAKeyframeAnimation *)[self.layer animationForKey:[self.layer.animationKeys firstObject]];
+    XCTAssertEqualWithAccuracy([keyframeAnimation.keyTimes[0] doubleValue], 0.0, 0.0001);
+    XCTAssertEqualWithAccuracy([keyframeAnimation.keyTimes[1] doubleValue], 260.0 / 560.0, 0.0001);
+    XCTAssertEqualWithAccuracy([keyframeAnimation.keyTimes[2] doubleValue], 1.0, 0.0001);
+}
+
+- (void)testStopAnimationRemovesKeyframeAnimation
+{
+    // given
+    PKSequentialAnimation *animation = [PKSequentialAnimation animationForKeyPath:@"position"
+                                                                           values:@[[NSValue valueWithCGPoint:CGPointMake(160.0, 0.0)]]
+                                                                         duration:1.0];
+    animation.mode = PKSequentialAnimationModeKeyframe;
+    [animation startAnimationOnLayer:self.layer];
+    
+    // when
+    [animation stopAnimation];
+    
+    // then
+    XCTAssertEqual([self.layer.animationKeys count], 0);
+}
+
+#pragma mark - Timing curves
+- (void)testKeyframeModeAppliesTimingCurveToWholeAnimation
+{
+    // given
+    PKTimingCurve *curve = [PKTimingCurve curveWithControlPoint1:CGPointMake(0.2, 0.0) controlPoint2:CGPointMake(0.0, 1.0)];
+    PKSequentialAnimation *animation = [PKSequentialAnimation animationForKeyPath:@"position"
+                                                                           values:@[[NSValue valueWithCGPoint:CGPointMake(160.0, 0.0)],
+                                                                                    [NSValue valueWithCGPoint:CGPointMake(-140.0, 0.0)]]
+                                                                         duration:1.0];
+    animation.mode = PKSequentialAnimationModeKeyframe;
+    animation.timingCurve = curve;
+    
+    // when
+    [animation startAnimationOnLayer:self.layer];
+    
+    // then
+    CAKeyframeAnimation *keyframeAnimation = (CAKeyframeAnimation *)[self.layer animationForKey:[self.layer.animationKeys firstObject]];
+    XCTAssertEqualObjects(keyframeAnimation.timingFunction, curve.timingFunction);
+    XCTAssertNil(keyframeAnimation.timingFunctions);
+}
+
+- (void)testChainedModeSplitsTimingCurveAcrossSegments
+{
+    // given
+    PKSequentialAnimation *animation = [PKSequentialAnimation animationForKeyPath:@"position"
+                                                                           values:@[[NSValue valueWithCGPoint:CGPointMake(160.0, 0.0)],
+                                                                                    [NSValue valueWithCGPoint:CGPointMake(-140.0, 0.0)]]
+                                                                         duration:1.0];
+    animation.timingCurve = [PKTimingCurve linearCurve];
+    
+    // when
+    [animation startAnimationOnLayer:self.layer];
+    
+    // then - with a linear curve, each segment's duration is proportional to its length
+    CAAnimation *firstSegment = [self.layer animationForKey:[self.layer.animationKeys firstObject]];
+    XCTAssertEqualWithAccuracy(firstSegment.duration, 260.0 / 560.0, 0.01);
+}
+
+- (void)testTimingCurveValues
+{
+    PKTimingCurve *curve = [PKTimingCurve easeInEaseOutCurve];
+    
+    XCTAssertEqualWithAccuracy([curve valueAtTime:0.5], 0.5, 0.0001);
+    XCTAssertEqualWithAccuracy([curve timeForValue:[curve valueAtTime:0.3]], 0.3, 0.001);
+    XCTAssertEqual([PKTimingCurve easeInEaseOutCurve], curve);
+}
+
+@end
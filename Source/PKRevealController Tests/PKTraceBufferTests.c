@@ -0,0 +1,127 @@
+//
+//  PKTraceBufferTests.c
+//  PKRevealController
+//
+//  Headless tests of the trace event buffer and its Chrome trace event JSON export.
+//
+
+#include "PKTraceBuffer.h"
+#include "PKRevealCoreTestSupport.h"
+#include <stdlib.h>
+#include <string.h>
+
+static char *PKWriteJSON(PKTraceBuffer *buffer, size_t *writtenCount)
+{
+    FILE *file = tmpfile();
+    
+    *writtenCount = PKTraceBufferWriteJSON(buffer, file, 42);
+    
+    long length = ftell(file);
+    char *json = calloc((size_t)length + 1, 1);
+    
+    rewind(file);
+    fread(json, 1, (size_t)length, file);
+    fclose(file);
+    
+    return json;
+}
+
+static PKTraceEvent PKInstantEvent(const char *name)
+{
+    PKTraceEvent event;
+    memset(&event, 0, sizeof(event));
+    
+    event.phase = PKTraceEventPhaseInstant;
+    event.category = "PKRevealController";
+    event.name = name;
+    event.timestamp = 1.5;
+    event.threadID = 7;
+    
+    return event;
+}
+
+#pragma mark - Recording
+
+static void testFullBufferDropsEvents(void)
+{
+    PKTraceBuffer buffer;
+    PKTraceEvent event = PKInstantEvent("state");
+    
+    PKAssertTrue(PKTraceBufferInitialize(&buffer, 2));
+    PKAssertTrue(PKTraceBufferAppend(&buffer, &event));
+    PKAssertTrue(PKTraceBufferAppend(&buffer, &event));
+    PKAssertFalse(PKTraceBufferAppend(&buffer, &event));
+    PKAssertEqual(buffer.droppedCount, 1);
+    
+    PKTraceBufferReset(&buffer);
+    PKAssertTrue(PKTraceBufferAppend(&buffer, &event));
+    PKAssertEqual(buffer.droppedCount, 0);
+    
+    PKTraceBufferDestroy(&buffer);
+}
+
+#pragma mark - Export
+
+static void testEventsAreWrittenAsChromeTraceJSON(void)
+{
+    PKTraceBuffer buffer;
+    PKTraceEvent state = PKInstantEvent("state");
+    PKTraceEvent begin = PKInstantEvent("pan");
+    PKTraceEvent end = PKInstantEvent("pan");
+    size_t writtenCount = 0;
+    
+    state.argumentNames[0] = "from";
+    state.arguments[0] = 3;
+    state.argumentNames[1] = "to";
+    state.arguments[1] = 2;
+    begin.phase = PKTraceEventPhaseAsyncBegin;
+    begin.identifier = 0xabc;
+    end.phase = PKTraceEventPhaseAsyncEnd;
+    end.identifier = 0xabc;
+    end.timestamp = 2.0;
+    
+    PKTraceBufferInitialize(&buffer, 8);
+    PKTraceBufferAppend(&buffer, &state);
+    PKTraceBufferAppend(&buffer, &begin);
+    PKTraceBufferAppend(&buffer, &end);
+    
+    char *json = PKWriteJSON(&buffer, &writtenCount);
+    
+    PKAssertEqual(writtenCount, 3);
+    PKAssertTrue(strncmp(json, "{\"traceEvents\":[", 16) == 0);
+    PKAssertTrue(strstr(json, "{\"name\":\"state\",\"cat\":\"PKRevealController\",\"ph\":\"i\",\"ts\":1500000.000,\"pid\":42,\"tid\":7,\"s\":\"t\",\"args\":{\"from\":3,\"to\":2}}") != NULL);
+    PKAssertTrue(strstr(json, "\"ph\":\"b\",\"ts\":1500000.000,\"pid\":42,\"tid\":7,\"id\":\"0xabc\",\"args\":{}") != NULL);
+    PKAssertTrue(strstr(json, "\"ph\":\"e\",\"ts\":2000000.000") != NULL);
+    PKAssertTrue(strstr(json, "\"droppedEvents\":0") != NULL);
+    
+    free(json);
+    PKTraceBufferDestroy(&buffer);
+}
+
+static void testStringsAreEscaped(void)
+{
+    PKTraceBuffer buffer;
+    PKTraceEvent event = PKInstantEvent("attach");
+    size_t writtenCount = 0;
+    
+    event.detail = "My\"Controller\\\n";
+    
+    PKTraceBufferInitialize(&buffer, 1);
+    PKTraceBufferAppend(&buffer, &event);
+    
+    char *json = PKWriteJSON(&buffer, &writtenCount);
+    
+    PKAssertTrue(strstr(json, "\"args\":{\"detail\":\"My\\\"Controller\\\\\\u000a\"}") != NULL);
+    
+    free(json);
+    PKTraceBufferDestroy(&buffer);
+}
+
+int main(void)
+{
+    PKRunTest(testFullBufferDropsEvents);
+    PKRunTest(testEventsAreWrittenAsChromeTraceJSON);
+    PKRunTest(testStringsAreEscaped);
+    
+    return PKTestResult();
+}
@@ -33,7 +33,7 @@ static char identifierKey;
 
 - (void)setPk_identifier:(NSInteger)pk_identifier
 {
-    objc_setAssociatedObject(self, &identifierKey, [NSNumber numberWithInteger:pk_identifier], OBJC_ASSOCIATION_ASSIGN);
+    objc_setAssociatedObject(self, &identifierKey, @(pk_identifier), OBJC_ASSOCIATION_RETAIN_NONATOMIC);
 }
 
 - (NSInteger)pk_identifier
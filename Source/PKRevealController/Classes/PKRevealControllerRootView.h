@@ -0,0 +1,48 @@
+/*
+    PKRevealController > PKRevealControllerRootView.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <UIKit/UIKit.h>
+#import "PKRevealController.h"
+
+/**
+ The reveal controller's root view. While the front view rests, touches are routed straight to the one container
+ they can reach according to the controller's state, instead of hit testing every container in turn. Falls back to
+ UIKit's hit testing while the front view moves or if views other than the containers were added.
+ */
+@interface PKRevealControllerRootView : UIView
+
+#pragma mark - Properties
+@property (nonatomic, weak, readwrite) UIView *frontView;
+@property (nonatomic, weak, readwrite) UIView *leftView;
+@property (nonatomic, weak, readwrite) UIView *rightView;
+
+/// The controller's state, mirrored whenever it changes.
+@property (nonatomic, assign, readwrite) PKRevealControllerState revealState;
+
+/// Whether touches are routed by revealState. Disabled while the front view moves. Defaults to YES.
+@property (nonatomic, assign, readwrite) BOOL routesTouches;
+
+@end
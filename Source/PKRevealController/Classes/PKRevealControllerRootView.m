@@ -0,0 +1,96 @@
+/*
+    PKRevealController > PKRevealControllerRootView.m
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PKRevealControllerRootView.h"
+
+@implementation PKRevealControllerRootView
+
+#pragma mark - Initialization
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    self = [super initWithFrame:frame];
+    
+    if (self)
+    {
+        _revealState = PKRevealControllerShowsFrontViewController;
+        _routesTouches = YES;
+    }
+    
+    return self;
+}
+
+#pragma mark - Hit Testing
+
+- (UIView *)hitTest:(CGPoint)point withEvent:(UIEvent *)event
+{
+    if (!self.routesTouches || ![self containsOnlyContainers])
+    {
+        return [super hitTest:point withEvent:event];
+    }
+    
+    if (!self.userInteractionEnabled || self.hidden || self.alpha < 0.01 || ![self pointInside:point withEvent:event])
+    {
+        return nil;
+    }
+    
+    UIView *container = [self containerForPoint:point withEvent:event];
+    UIView *view = [container hitTest:[self convertPoint:point toView:container] withEvent:event];
+    
+    // Like UIKit, the root view receives touches that none of its subviews take. The other containers are not asked.
+    return view ?: self;
+}
+
+#pragma mark - Internal
+
+- (BOOL)containsOnlyContainers
+{
+    NSUInteger count = (self.frontView ? 1 : 0) + (self.leftView ? 1 : 0) + (self.rightView ? 1 : 0);
+    return (count > 0 && [self.subviews count] == count);
+}
+
+/*
+ * The focused front view covers the whole root view and the rear containers behind it are hidden. Once a rear
+ * view is revealed, a touch either lands on the remaining part of the front view or on that rear view.
+ */
+- (UIView *)containerForPoint:(CGPoint)point withEvent:(UIEvent *)event
+{
+    UIView *frontView = self.frontView;
+    
+    if (self.revealState == PKRevealControllerShowsFrontViewController ||
+        [frontView pointInside:[self convertPoint:point toView:frontView] withEvent:event])
+    {
+        return frontView;
+    }
+    
+    BOOL isLeft = (self.revealState == PKRevealControllerShowsLeftViewController ||
+                   self.revealState == PKRevealControllerShowsLeftViewControllerInPresentationMode);
+    UIView *rearView = isLeft ? self.leftView : self.rightView;
+    
+    return rearView.hidden ? nil : rearView;
+}
+
+@end
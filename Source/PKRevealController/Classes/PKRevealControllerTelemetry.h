@@ -0,0 +1,89 @@
+/*
+    PKRevealController > PKRevealControllerTelemetry.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import "PKRevealController.h"
+#import "PKRevealCoreTelemetry.h"
+
+/// The measurements of a single animated or interactive transition of a reveal controller.
+@interface PKRevealControllerTransitionMetrics : NSObject
+
+#pragma mark - Properties
+@property (nonatomic, assign, readonly) PKRevealControllerState fromState;
+@property (nonatomic, assign, readonly) PKRevealControllerState toState;
+
+/// YES if the transition was driven by a pan gesture, NO if it was triggered programmatically or by a tap.
+@property (nonatomic, assign, readonly, getter = isInteractive) BOOL interactive;
+
+/// The time from the gesture or call that triggered the transition until the first frame that moved the front view. Negative if the front view never moved.
+@property (nonatomic, assign, readonly) NSTimeInterval latency;
+
+/// The number of frames that missed their deadline while the transition was in flight.
+@property (nonatomic, assign, readonly) NSUInteger droppedFrameCount;
+
+/// The number of frames that were displayed while the transition was in flight.
+@property (nonatomic, assign, readonly) NSUInteger frameCount;
+
+/// The time from the start of the transition until the front view came to rest.
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+#pragma mark - Methods
+- (instancetype)initWithSample:(const PKRevealCoreTransitionSample *)sample;
+
+@end
+
+/**
+ An immutable snapshot of a reveal controller's aggregated transition telemetry. Every histogram has
+ PKRevealCoreHistogramBucketCount buckets, see +histogramBucketUpperBounds.
+ */
+@interface PKRevealControllerTelemetry : NSObject
+
+#pragma mark - Properties
+/// The number of transitions between all states.
+@property (nonatomic, assign, readonly) NSUInteger transitionCount;
+
+/// The number of transitions between all states that dropped at least one frame.
+@property (nonatomic, assign, readonly) NSUInteger jankyTransitionCount;
+
+#pragma mark - Methods
+- (instancetype)initWithTelemetry:(const PKRevealCoreTelemetry *)telemetry;
+
+/// @return The exclusive upper bounds of the histogram buckets. Each bucket counts the values between the previous bucket's bound and its own. The last bound is infinite.
++ (NSArray *)histogramBucketUpperBounds;
+
+- (NSUInteger)transitionCountFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState;
+- (NSUInteger)jankyTransitionCountFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState;
+
+/// @return The bucket counts of the latencies of all transitions between the given states, in milliseconds.
+- (NSArray *)latencyHistogramFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState;
+
+/// @return The bucket counts of the dropped frames per transition between the given states.
+- (NSArray *)droppedFrameHistogramFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState;
+
+/// @return The bucket counts of the durations of all transitions between the given states, in milliseconds.
+- (NSArray *)durationHistogramFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState;
+
+@end
@@ -0,0 +1,181 @@
+/*
+    PKRevealController > PKRevealControllerTelemetry.m
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PKRevealControllerTelemetry.h"
+
+NS_INLINE NSArray *PKRevealControllerHistogramCounts(const PKRevealCoreHistogram *histogram)
+{
+    NSMutableArray *counts = [NSMutableArray arrayWithCapacity:PKRevealCoreHistogramBucketCount];
+    
+    for (NSUInteger bucket = 0; bucket < PKRevealCoreHistogramBucketCount; bucket++)
+    {
+        [counts addObject:@(histogram->counts[bucket])];
+    }
+    
+    return [counts copy];
+}
+
+#pragma mark - PKRevealControllerTransitionMetrics
+
+@interface PKRevealControllerTransitionMetrics ()
+
+#pragma mark - Properties
+@property (nonatomic, assign, readwrite) PKRevealControllerState fromState;
+@property (nonatomic, assign, readwrite) PKRevealControllerState toState;
+@property (nonatomic, assign, readwrite, getter = isInteractive) BOOL interactive;
+@property (nonatomic, assign, readwrite) NSTimeInterval latency;
+@property (nonatomic, assign, readwrite) NSUInteger droppedFrameCount;
+@property (nonatomic, assign, readwrite) NSUInteger frameCount;
+@property (nonatomic, assign, readwrite) NSTimeInterval duration;
+
+@end
+
+@implementation PKRevealControllerTransitionMetrics
+
+#pragma mark - Initialization
+
+- (instancetype)initWithSample:(const PKRevealCoreTransitionSample *)sample
+{
+    self = [super init];
+    
+    if (self)
+    {
+        self.fromState = (PKRevealControllerState)sample->fromState;
+        self.toState = (PKRevealControllerState)sample->toState;
+        self.interactive = sample->isInteractive;
+        self.latency = sample->latency;
+        self.droppedFrameCount = sample->droppedFrameCount;
+        self.frameCount = sample->frameCount;
+        self.duration = sample->duration;
+    }
+    
+    return self;
+}
+
+@end
+
+#pragma mark - PKRevealControllerTelemetry
+
+@interface PKRevealControllerTelemetry ()
+{
+    PKRevealCoreTelemetry _telemetry;
+}
+
+@end
+
+@implementation PKRevealControllerTelemetry
+
+#pragma mark - Initialization
+
+- (instancetype)initWithTelemetry:(const PKRevealCoreTelemetry *)telemetry
+{
+    self = [super init];
+    
+    if (self)
+    {
+        _telemetry = *telemetry;
+    }
+    
+    return self;
+}
+
+#pragma mark - API
+
++ (NSArray *)histogramBucketUpperBounds
+{
+    NSMutableArray *bounds = [NSMutableArray arrayWithCapacity:PKRevealCoreHistogramBucketCount];
+    
+    for (NSUInteger bucket = 0; bucket < PKRevealCoreHistogramBucketCount; bucket++)
+    {
+        [bounds addObject:@(PKRevealCoreHistogramBucketUpperBound(bucket))];
+    }
+    
+    return [bounds copy];
+}
+
+- (NSUInteger)transitionCount
+{
+    NSUInteger count = 0;
+    
+    for (NSUInteger from = 0; from < PKRevealCoreStateCount; from++)
+    {
+        for (NSUInteger to = 0; to < PKRevealCoreStateCount; to++)
+        {
+            count += _telemetry.transitions[from][to].transitionCount;
+        }
+    }
+    
+    return count;
+}
+
+- (NSUInteger)jankyTransitionCount
+{
+    NSUInteger count = 0;
+    
+    for (NSUInteger from = 0; from < PKRevealCoreStateCount; from++)
+    {
+        for (NSUInteger to = 0; to < PKRevealCoreStateCount; to++)
+        {
+            count += _telemetry.transitions[from][to].jankyCount;
+        }
+    }
+    
+    return count;
+}
+
+- (NSUInteger)transitionCountFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState
+{
+    return [self statisticsFromState:fromState toState:toState]->transitionCount;
+}
+
+- (NSUInteger)jankyTransitionCountFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState
+{
+    return [self statisticsFromState:fromState toState:toState]->jankyCount;
+}
+
+- (NSArray *)latencyHistogramFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState
+{
+    return PKRevealControllerHistogramCounts(&[self statisticsFromState:fromState toState:toState]->latency);
+}
+
+- (NSArray *)droppedFrameHistogramFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState
+{
+    return PKRevealControllerHistogramCounts(&[self statisticsFromState:fromState toState:toState]->droppedFrames);
+}
+
+- (NSArray *)durationHistogramFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState
+{
+    return PKRevealControllerHistogramCounts(&[self statisticsFromState:fromState toState:toState]->duration);
+}
+
+#pragma mark - Internal
+
+- (const PKRevealCoreTransitionStatistics *)statisticsFromState:(PKRevealControllerState)fromState toState:(PKRevealControllerState)toState
+{
+    return PKRevealCoreTelemetryStatistics(&_telemetry, (PKRevealCoreState)fromState, (PKRevealCoreState)toState);
+}
+
+@end
@@ -26,15 +26,34 @@
 
 #import <UIKit/UIKit.h>
 #import <QuartzCore/QuartzCore.h>
+#import "PKRevealController.h"
 
 @interface PKRevealControllerView : UIView
 
 #pragma mark - Properties
 @property (nonatomic, assign, readwrite, getter = hasShadow) BOOL shadow;
+
+/// How the shadow is rendered. Defaults to PKRevealControllerShadowStyleLayer.
+@property (nonatomic, assign, readwrite) PKRevealControllerShadowStyle shadowStyle;
 @property (nonatomic, weak, readwrite) UIViewController *viewController;
 
+/// Whether the contained view is replaced by a cached snapshot between beginSnapshotting and endSnapshotting. Defaults to NO.
+@property (nonatomic, assign, readwrite) BOOL usesSnapshots;
+
+/// YES while the contained view is replaced by its snapshot.
+@property (nonatomic, assign, readonly, getter = isShowingSnapshot) BOOL showingSnapshot;
+
 #pragma mark - Methods
 - (void)updateShadowWithAnimationDuration:(NSTimeInterval)duration;
 - (void)setUserInteractionForContainedViewEnabled:(BOOL)userInteractionEnabled;
 
+/// Replaces the contained view with its snapshot, rendering the snapshot only if there is no valid cached one. Does nothing unless usesSnapshots is enabled.
+- (void)beginSnapshotting;
+
+/// Restores the contained view. The snapshot is kept for the next call to beginSnapshotting.
+- (void)endSnapshotting;
+
+/// Discards the cached snapshot, e.g. because the contained view's content changed. Restores the contained view if it is currently replaced.
+- (void)invalidateSnapshot;
+
 @end
@@ -28,9 +28,68 @@
 #import "PKAnimation.h"
 
 #define SHADOW_TRANSITION_ANIMATION_IDENTIFIER 1
+#define SHADOW_OPACITY 0.5
+#define SHADOW_RADIUS 2.5
+#define SHADOW_GRADIENT_WIDTH (3.0 * SHADOW_RADIUS)
+#define SHADOW_GRADIENT_PIXEL_WIDTH 32
+#define SHADOW_PATH_CACHE_CAPACITY 2
 
 static NSString *kShadowTransitionAnimationKey = @"shadowTransitionAnimation";
 
+@interface PKRevealControllerView ()
+
+#pragma mark - Properties
+@property (nonatomic, assign, readwrite, getter = isShowingSnapshot) BOOL showingSnapshot;
+@property (nonatomic, strong, readwrite) CALayer *snapshotLayer;
+@property (nonatomic, strong, readwrite) UIImage *snapshot;
+@property (nonatomic, strong, readwrite) CALayer *leftShadowLayer;
+@property (nonatomic, strong, readwrite) CALayer *rightShadowLayer;
+@property (nonatomic, strong, readwrite) NSMutableArray *shadowPaths;
+
+@end
+
+/*
+ * The gradient shadow strips share two pre-rendered images, one per edge. They are one pixel tall and are
+ * stretched to the container's height by the compositor, so neither a blur nor an offscreen pass is needed.
+ */
+static CGImageRef PKRevealControllerViewCreateShadowGradientImage(BOOL fadesToTheLeft)
+{
+    size_t width = SHADOW_GRADIENT_PIXEL_WIDTH;
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, 1, 8, width * 4, colorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+    
+    CGFloat components[8] = { 0.0, 0.0, 0.0, SHADOW_OPACITY, 0.0, 0.0, 0.0, 0.0 };
+    CGFloat locations[2] = { 0.0, 1.0 };
+    CGGradientRef gradient = CGGradientCreateWithColorComponents(colorSpace, components, locations, 2);
+    
+    CGPoint edge = CGPointMake(fadesToTheLeft ? width : 0.0, 0.0);
+    CGPoint end = CGPointMake(fadesToTheLeft ? 0.0 : width, 0.0);
+    CGContextDrawLinearGradient(context, gradient, edge, end, 0);
+    
+    CGImageRef image = CGBitmapContextCreateImage(context);
+    
+    CGGradientRelease(gradient);
+    CGContextRelease(context);
+    CGColorSpaceRelease(colorSpace);
+    
+    return image;
+}
+
+static CGImageRef PKRevealControllerViewShadowGradientImage(BOOL fadesToTheLeft)
+{
+    static CGImageRef leftImage = NULL;
+    static CGImageRef rightImage = NULL;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^
+    {
+        leftImage = PKRevealControllerViewCreateShadowGradientImage(YES);
+        rightImage = PKRevealControllerViewCreateShadowGradientImage(NO);
+    });
+    
+    return fadesToTheLeft ? leftImage : rightImage;
+}
+
 @implementation PKRevealControllerView
 
 #pragma mark - Accessors
@@ -39,6 +98,8 @@ static NSString *kShadowTransitionAnimationKey = @"shadowTransitionAnimation";
 {
     if (_viewController != viewController)
     {
+        [self invalidateSnapshot];
+        
         _viewController = viewController;
         _viewController.view.frame = self.bounds;
         _viewController.view.autoresizingMask = self.autoresizingMask;
@@ -47,24 +108,31 @@ static NSString *kShadowTransitionAnimationKey = @"shadowTransitionAnimation";
 
 - (void)setShadow:(BOOL)shadow
 {
-    if (shadow)
+    _shadow = shadow;
+    [self updateShadowLayers];
+}
+
+- (void)setShadowStyle:(PKRevealControllerShadowStyle)shadowStyle
+{
+    if (_shadowStyle != shadowStyle)
     {
-        UIBezierPath *shadowPath = [UIBezierPath bezierPathWithRect:self.bounds];
-        self.layer.masksToBounds = NO;
-        self.layer.shadowColor = [UIColor blackColor].CGColor;
-        self.layer.shadowOffset = CGSizeMake(0.0, 0.0);
-        self.layer.shadowOpacity = 0.5;
-        self.layer.shadowRadius = 2.5;
-        self.layer.shadowPath = shadowPath.CGPath;
+        _shadowStyle = shadowStyle;
+        [self updateShadowLayers];
     }
-    else
+}
+
+#pragma mark - Layout
+
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+    
+    if (self.hasShadow && self.shadowStyle == PKRevealControllerShadowStyleGradient)
     {
-        self.layer.masksToBounds = YES;
-        self.layer.shadowColor = nil;
-        self.layer.shadowOffset = CGSizeZero;
-        self.layer.shadowOpacity = 0.0;
-        self.layer.shadowRadius = 0.0;
-        self.layer.shadowPath = nil;
+        [CATransaction begin];
+        [CATransaction setDisableActions:YES];
+        [self layoutShadowGradientLayers];
+        [CATransaction commit];
     }
 }
 
@@ -72,14 +140,28 @@ static NSString *kShadowTransitionAnimationKey = @"shadowTransitionAnimation";
 
 - (void)updateShadowWithAnimationDuration:(NSTimeInterval)duration
 {
-    UIBezierPath *existingShadowPath = [UIBezierPath bezierPathWithCGPath:self.layer.shadowPath];
+    if (!self.hasShadow)
+    {
+        return;
+    }
     
-    self.layer.shadowPath = [UIBezierPath bezierPathWithRect:self.bounds].CGPath;
+    if (self.shadowStyle == PKRevealControllerShadowStyleGradient)
+    {
+        [CATransaction begin];
+        [CATransaction setAnimationDuration:duration];
+        [self layoutShadowGradientLayers];
+        [CATransaction commit];
+        
+        return;
+    }
     
-    if (existingShadowPath != nil)
+    CGPathRef existingShadowPath = self.layer.shadowPath;
+    CGPathRef shadowPath = [self shadowPathForSize:self.bounds.size];
+    
+    if (existingShadowPath != nil && existingShadowPath != shadowPath)
     {
         PKAnimation *transition = [PKAnimation animationWithKeyPath:@"shadowPath"];
-        transition.fromValue = (__bridge id)(existingShadowPath.CGPath);
+        transition.fromValue = (__bridge id)existingShadowPath;
         transition.timingFunction = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseInEaseOut];
         transition.duration = duration;
         transition.removedOnCompletion = NO;
@@ -88,6 +170,8 @@ static NSString *kShadowTransitionAnimationKey = @"shadowTransitionAnimation";
         
         [self.layer addAnimation:transition forKey:kShadowTransitionAnimationKey];
     }
+    
+    self.layer.shadowPath = shadowPath;
 }
 
 - (void)animationDidStop:(CAAnimation *)animation finished:(BOOL)flag
@@ -103,4 +187,186 @@ static NSString *kShadowTransitionAnimationKey = @"shadowTransitionAnimation";
     [self.viewController.view setUserInteractionEnabled:userInteractionEnabled];
 }
 
+#pragma mark - Hit Testing
+
+/*
+ * The contained view is the container's only subview. While it ignores touches or is replaced by its snapshot,
+ * the container takes the touch itself, e.g. for the reset tap, without walking the contained hierarchy.
+ */
+- (UIView *)hitTest:(CGPoint)point withEvent:(UIEvent *)event
+{
+    UIView *contentView = [self.viewController isViewLoaded] ? self.viewController.view : nil;
+    
+    if (contentView.superview != self || (contentView.userInteractionEnabled && !contentView.hidden))
+    {
+        return [super hitTest:point withEvent:event];
+    }
+    
+    if (!self.userInteractionEnabled || self.hidden || self.alpha < 0.01 || ![self pointInside:point withEvent:event])
+    {
+        return nil;
+    }
+    
+    return self;
+}
+
+#pragma mark - Shadow
+
+- (void)updateShadowLayers
+{
+    BOOL usesLayerShadow = (self.hasShadow && self.shadowStyle == PKRevealControllerShadowStyleLayer);
+    BOOL usesGradientShadow = (self.hasShadow && self.shadowStyle == PKRevealControllerShadowStyleGradient);
+    
+    self.layer.masksToBounds = !self.hasShadow;
+    
+    if (usesLayerShadow)
+    {
+        self.layer.shadowColor = [UIColor blackColor].CGColor;
+        self.layer.shadowOffset = CGSizeMake(0.0, 0.0);
+        self.layer.shadowOpacity = SHADOW_OPACITY;
+        self.layer.shadowRadius = SHADOW_RADIUS;
+        self.layer.shadowPath = [self shadowPathForSize:self.bounds.size];
+    }
+    else
+    {
+        self.layer.shadowColor = nil;
+        self.layer.shadowOffset = CGSizeZero;
+        self.layer.shadowOpacity = 0.0;
+        self.layer.shadowRadius = 0.0;
+        self.layer.shadowPath = nil;
+    }
+    
+    if (usesGradientShadow)
+    {
+        if (!self.leftShadowLayer)
+        {
+            self.leftShadowLayer = [CALayer layer];
+            self.leftShadowLayer.contents = (__bridge id)PKRevealControllerViewShadowGradientImage(YES);
+            self.rightShadowLayer = [CALayer layer];
+            self.rightShadowLayer.contents = (__bridge id)PKRevealControllerViewShadowGradientImage(NO);
+        }
+        
+        [CATransaction begin];
+        [CATransaction setDisableActions:YES];
+        [self.layer addSublayer:self.leftShadowLayer];
+        [self.layer addSublayer:self.rightShadowLayer];
+        [self layoutShadowGradientLayers];
+        [CATransaction commit];
+    }
+    else
+    {
+        [self.leftShadowLayer removeFromSuperlayer];
+        [self.rightShadowLayer removeFromSuperlayer];
+    }
+}
+
+- (void)layoutShadowGradientLayers
+{
+    CGRect bounds = self.bounds;
+    
+    self.leftShadowLayer.frame = CGRectMake(CGRectGetMinX(bounds) - SHADOW_GRADIENT_WIDTH, CGRectGetMinY(bounds), SHADOW_GRADIENT_WIDTH, CGRectGetHeight(bounds));
+    self.rightShadowLayer.frame = CGRectMake(CGRectGetMaxX(bounds), CGRectGetMinY(bounds), SHADOW_GRADIENT_WIDTH, CGRectGetHeight(bounds));
+}
+
+/*
+ * Shadow paths are cached for the most recently used sizes, as the container mostly alternates between two of
+ * them, e.g. when rotating. Other sizes, e.g. while the container is resized continuously, evict the oldest.
+ */
+- (CGPathRef)shadowPathForSize:(CGSize)size
+{
+    if (!self.shadowPaths)
+    {
+        self.shadowPaths = [NSMutableArray arrayWithCapacity:SHADOW_PATH_CACHE_CAPACITY];
+    }
+    
+    UIBezierPath *shadowPath = nil;
+    
+    for (UIBezierPath *cachedPath in self.shadowPaths)
+    {
+        if (CGSizeEqualToSize(cachedPath.bounds.size, size))
+        {
+            shadowPath = cachedPath;
+            break;
+        }
+    }
+    
+    if (shadowPath)
+    {
+        [self.shadowPaths removeObjectIdenticalTo:shadowPath];
+    }
+    else
+    {
+        shadowPath = [UIBezierPath bezierPathWithRect:CGRectMake(0.0, 0.0, size.width, size.height)];
+        
+        if ([self.shadowPaths count] == SHADOW_PATH_CACHE_CAPACITY)
+        {
+            [self.shadowPaths removeLastObject];
+        }
+    }
+    
+    [self.shadowPaths insertObject:shadowPath atIndex:0];
+    
+    return shadowPath.CGPath;
+}
+
+#pragma mark - Snapshots
+
+- (void)beginSnapshotting
+{
+    UIView *contentView = [self.viewController isViewLoaded] ? self.viewController.view : nil;
+    
+    if (!self.usesSnapshots || self.isShowingSnapshot || contentView.superview != self)
+    {
+        return;
+    }
+    
+    if (!self.snapshot || !CGSizeEqualToSize(self.snapshot.size, self.bounds.size))
+    {
+        UIGraphicsBeginImageContextWithOptions(self.bounds.size, contentView.opaque, 0.0);
+        [contentView.layer renderInContext:UIGraphicsGetCurrentContext()];
+        self.snapshot = UIGraphicsGetImageFromCurrentImageContext();
+        UIGraphicsEndImageContext();
+    }
+    
+    if (!self.snapshotLayer)
+    {
+        self.snapshotLayer = [CALayer layer];
+    }
+    
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    self.snapshotLayer.frame = self.bounds;
+    self.snapshotLayer.contentsScale = self.snapshot.scale;
+    self.snapshotLayer.contents = (__bridge id)self.snapshot.CGImage;
+    [self.layer addSublayer:self.snapshotLayer];
+    [CATransaction commit];
+    
+    contentView.hidden = YES;
+    self.showingSnapshot = YES;
+}
+
+- (void)endSnapshotting
+{
+    if (!self.isShowingSnapshot)
+    {
+        return;
+    }
+    
+    self.viewController.view.hidden = NO;
+    
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    [self.snapshotLayer removeFromSuperlayer];
+    self.snapshotLayer.contents = nil;
+    [CATransaction commit];
+    
+    self.showingSnapshot = NO;
+}
+
+- (void)invalidateSnapshot
+{
+    [self endSnapshotting];
+    self.snapshot = nil;
+}
+
 @end
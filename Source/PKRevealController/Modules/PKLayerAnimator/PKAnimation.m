@@ -80,7 +80,34 @@
 
 - (NSString *)key
 {
-    return [NSString stringWithFormat:@"%lu%ld", (unsigned long)[self hash], (long)self.identifier];
+    if (!_key)
+    {
+        _key = [NSString stringWithFormat:@"%lu%ld", (unsigned long)[self hash], (long)self.identifier];
+    }
+    
+    return _key;
+}
+
+- (void)setIdentifier:(NSInteger)identifier
+{
+    if (identifier != _identifier)
+    {
+        _identifier = identifier;
+        _key = nil;
+    }
+}
+
+#pragma mark - PKIdentifier
+
+// PKAnimation stores its identifier in an ivar, which layers copy along with the animation, instead of an associated object.
+- (void)setPk_identifier:(NSInteger)pk_identifier
+{
+    self.identifier = pk_identifier;
+}
+
+- (NSInteger)pk_identifier
+{
+    return self.identifier;
 }
 
 - (void)setLayer:(CALayer *)layer
@@ -0,0 +1,60 @@
+/*
+    PKRevealController > PKAnimationPool.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <QuartzCore/QuartzCore.h>
+#import "PKSequentialAnimation.h"
+
+/**
+ Recycles sequential animations, so that starting an animation in steady state creates no animation objects,
+ animation keys or timing functions. An animation returns to the pool by itself once it stopped and its
+ completion handler has been called. The pool only grows if all of its animations are in use.
+ */
+@interface PKAnimationPool : NSObject
+
+#pragma mark - Properties
+/// The number of animations the pool has created, including the preallocated ones.
+@property (nonatomic, assign, readonly) NSUInteger allocationCount;
+
+#pragma mark - Methods
+/**
+ @param capacity The number of animations to preallocate.
+ */
++ (instancetype)poolWithCapacity:(NSUInteger)capacity;
+
+/**
+ @return An animation that is not in use, reset to the given values. Progress and completion handlers are cleared and the mode is PKSequentialAnimationModeChained.
+ */
+- (PKSequentialAnimation *)sequentialAnimationForKeyPath:(NSString *)keyPath
+                                                  values:(NSArray *)values
+                                                duration:(NSTimeInterval)duration;
+
+/**
+ @return A shared timing function instance for one of the kCAMediaTimingFunction names.
+ */
++ (CAMediaTimingFunction *)timingFunctionWithName:(NSString *)name;
+
+@end
@@ -0,0 +1,127 @@
+/*
+    PKRevealController > PKAnimationPool.m
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PKAnimationPool.h"
+
+@interface PKAnimationPool ()
+
+#pragma mark - Properties
+@property (nonatomic, strong, readwrite) NSMutableArray *animations;
+@property (nonatomic, assign, readwrite) NSUInteger allocationCount;
+
+@end
+
+@implementation PKAnimationPool
+
+#pragma mark - Initialization
+
++ (instancetype)poolWithCapacity:(NSUInteger)capacity
+{
+    return [[[self class] alloc] initWithCapacity:capacity];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+    self = [super init];
+    
+    if (self)
+    {
+        self.animations = [NSMutableArray arrayWithCapacity:capacity];
+        
+        for (NSUInteger index = 0; index < capacity; index++)
+        {
+            [self addAnimation];
+        }
+    }
+    
+    return self;
+}
+
+#pragma mark - API
+
+- (PKSequentialAnimation *)sequentialAnimationForKeyPath:(NSString *)keyPath
+                                                  values:(NSArray *)values
+                                                duration:(NSTimeInterval)duration
+{
+    PKSequentialAnimation *reusableAnimation = nil;
+    
+    for (PKSequentialAnimation *animation in self.animations)
+    {
+        if (!animation.isInUse)
+        {
+            reusableAnimation = animation;
+            break;
+        }
+    }
+    
+    if (!reusableAnimation)
+    {
+        reusableAnimation = [self addAnimation];
+    }
+    
+    [reusableAnimation prepareForReuseWithKeyPath:keyPath values:values duration:duration];
+    
+    return reusableAnimation;
+}
+
++ (CAMediaTimingFunction *)timingFunctionWithName:(NSString *)name
+{
+    static NSDictionary *timingFunctions = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^
+    {
+        NSArray *names = @[kCAMediaTimingFunctionLinear,
+                           kCAMediaTimingFunctionEaseIn,
+                           kCAMediaTimingFunctionEaseOut,
+                           kCAMediaTimingFunctionEaseInEaseOut,
+                           kCAMediaTimingFunctionDefault];
+        NSMutableDictionary *functions = [NSMutableDictionary dictionaryWithCapacity:[names count]];
+        
+        for (NSString *functionName in names)
+        {
+            functions[functionName] = [CAMediaTimingFunction functionWithName:functionName];
+        }
+        
+        timingFunctions = [functions copy];
+    });
+    
+    return timingFunctions[name] ?: [CAMediaTimingFunction functionWithName:name];
+}
+
+#pragma mark - Internal
+
+- (PKSequentialAnimation *)addAnimation
+{
+    PKSequentialAnimation *animation = [PKSequentialAnimation animationForKeyPath:nil values:nil duration:0.0];
+    
+    [self.animations addObject:animation];
+    self.allocationCount++;
+    
+    return animation;
+}
+
+@end
@@ -0,0 +1,67 @@
+/*
+    PKRevealController > PKFrameUpdateScheduler.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+typedef void(^PKFrameUpdateBlock)(NSUInteger flags);
+
+/**
+ Coalesces update requests into one update per run loop iteration. Requests mark flags as dirty and the
+ handler is called with all of them from a main run loop observer that runs right before Core Animation
+ commits the frame's transaction. Requests made while an update is pending are elided.
+ */
+@interface PKFrameUpdateScheduler : NSObject
+
+#pragma mark - Properties
+/// The flags marked since the last update.
+@property (nonatomic, assign, readonly) NSUInteger pendingFlags;
+
+/// The number of requests, including the ones that did not mark any flags.
+@property (nonatomic, assign, readonly) NSUInteger requestCount;
+
+/// The number of times the handler was called.
+@property (nonatomic, assign, readonly) NSUInteger updateCount;
+
+/// The number of requests that did not cause an update of their own, i.e. requestCount - updateCount.
+@property (nonatomic, assign, readonly) NSUInteger elidedCount;
+
+#pragma mark - Methods
++ (instancetype)schedulerWithHandler:(PKFrameUpdateBlock)handler;
+
+/**
+ Marks flags as dirty and schedules an update before the next commit if any are pending.
+ 
+ @param flags The flags to mark. Requests without flags are only counted.
+ */
+- (void)setNeedsUpdate:(NSUInteger)flags;
+
+/// Calls the handler immediately if an update is pending.
+- (void)flush;
+
+/// Discards the pending flags, e.g. after the same work was done directly.
+- (void)cancel;
+
+@end
@@ -0,0 +1,145 @@
+/*
+    PKRevealController > PKFrameUpdateScheduler.m
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PKFrameUpdateScheduler.h"
+
+/// Core Animation commits its implicit transaction from a run loop observer of order 2000000.
+static const CFIndex kPKFrameUpdateSchedulerObserverOrder = 1999000;
+
+@interface PKFrameUpdateScheduler ()
+{
+    CFRunLoopObserverRef _observer;
+}
+
+#pragma mark - Properties
+@property (nonatomic, assign, readwrite) NSUInteger pendingFlags;
+@property (nonatomic, assign, readwrite) NSUInteger requestCount;
+@property (nonatomic, assign, readwrite) NSUInteger updateCount;
+@property (nonatomic, copy, readwrite) PKFrameUpdateBlock handler;
+
+@end
+
+@implementation PKFrameUpdateScheduler
+
+#pragma mark - Initialization
+
++ (instancetype)schedulerWithHandler:(PKFrameUpdateBlock)handler
+{
+    return [[[self class] alloc] initWithHandler:handler];
+}
+
+- (instancetype)initWithHandler:(PKFrameUpdateBlock)handler
+{
+    self = [super init];
+    
+    if (self)
+    {
+        self.handler = handler;
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_observer)
+    {
+        CFRunLoopObserverInvalidate(_observer);
+        CFRelease(_observer);
+    }
+}
+
+#pragma mark - API
+
+- (NSUInteger)elidedCount
+{
+    return self.requestCount - self.updateCount;
+}
+
+- (void)setNeedsUpdate:(NSUInteger)flags
+{
+    self.requestCount++;
+    
+    if (flags == 0)
+    {
+        return;
+    }
+    
+    self.pendingFlags |= flags;
+    [self installObserverIfNeeded];
+}
+
+- (void)flush
+{
+    NSUInteger flags = self.pendingFlags;
+    
+    if (flags == 0)
+    {
+        return;
+    }
+    
+    self.pendingFlags = 0;
+    self.updateCount++;
+    
+    if (self.handler)
+    {
+        self.handler(flags);
+    }
+}
+
+- (void)cancel
+{
+    self.pendingFlags = 0;
+}
+
+#pragma mark - Internal
+
+/*
+ * The observer stays installed for the scheduler's lifetime. Adding and removing it on every frame
+ * would cost more than checking the pending flags once per run loop iteration.
+ */
+- (void)installObserverIfNeeded
+{
+    if (_observer)
+    {
+        return;
+    }
+    
+    __weak PKFrameUpdateScheduler *weakSelf = self;
+    
+    _observer = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault,
+                                                   (kCFRunLoopBeforeWaiting | kCFRunLoopExit),
+                                                   true,
+                                                   kPKFrameUpdateSchedulerObserverOrder,
+                                                   ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity)
+    {
+        [weakSelf flush];
+    });
+    
+    CFRunLoopAddObserver(CFRunLoopGetMain(), _observer, kCFRunLoopCommonModes);
+}
+
+@end
@@ -0,0 +1,90 @@
+/*
+    PKRevealController > PKInteractiveAnimator.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <QuartzCore/QuartzCore.h>
+#import "PKAnimating.h"
+#import "PKRevealCore.h"
+
+typedef void(^PKInteractiveAnimatorProgressBlock)(CGPoint position);
+
+/**
+ Drives a layer's position from a display link by updating its model value on every frame. Since the model
+ value always equals what is on screen, the animation can be interrupted or retargeted at any time without
+ the layer jumping, and a start velocity can be carried into the animation.
+ */
+@interface PKInteractiveAnimator : NSObject
+
+#pragma mark - Properties
+@property (nonatomic, strong, readonly) CALayer *layer;
+@property (nonatomic, assign, readonly, getter = isAnimating) BOOL animating;
+
+/// The current horizontal velocity of the layer in points per second. Zero while the animator is idle.
+@property (nonatomic, assign, readonly) CGFloat velocity;
+
+/// Called on every frame after the layer's position has been updated.
+@property (nonatomic, copy, readwrite) PKInteractiveAnimatorProgressBlock progressHandler;
+
+#pragma mark - Methods
++ (instancetype)animatorForLayer:(CALayer *)layer;
+
+/**
+ Moves the layer's position horizontally to the given position. A running animation is retargeted from the
+ layer's current position and its completion handler is called with NO.
+ 
+ @param position The target position.
+ @param velocity The horizontal start velocity in points per second, e.g. a gesture's release velocity.
+ @param duration The duration of the animation. The layer is moved immediately if it is not positive.
+ @param completion Called once the animation finished or was interrupted.
+ */
+- (void)animateToPosition:(CGPoint)position
+                 velocity:(CGFloat)velocity
+                 duration:(NSTimeInterval)duration
+               completion:(PKAnimationCompletionBlock)completion;
+
+/**
+ Moves the layer's position horizontally to the given position using a damped spring. The duration is
+ derived from the spring, the distance and the start velocity. A running animation is retargeted from the
+ layer's current position and its completion handler is called with NO.
+ 
+ @param position The target position.
+ @param velocity The horizontal start velocity in points per second, e.g. a gesture's release velocity.
+ @param spring The spring parameters.
+ @param completion Called once the animation finished or was interrupted.
+ */
+- (void)animateToPosition:(CGPoint)position
+                 velocity:(CGFloat)velocity
+                   spring:(PKRevealCoreSpring)spring
+               completion:(PKAnimationCompletionBlock)completion;
+
+/**
+ Stops a running animation and leaves the layer at its current position.
+ 
+ @return The position the layer was stopped at.
+ */
+- (CGPoint)interruptAnimation;
+
+@end
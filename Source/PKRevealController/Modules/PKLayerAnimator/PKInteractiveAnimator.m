@@ -0,0 +1,188 @@
+/*
+    PKRevealController > PKInteractiveAnimator.m
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PKInteractiveAnimator.h"
+
+static const double kPKInteractiveAnimatorRestingDistance = 0.5;
+
+@interface PKInteractiveAnimator ()
+{
+    PKRevealCoreMotion _motion;
+}
+
+#pragma mark - Properties
+@property (nonatomic, strong, readwrite) CALayer *layer;
+@property (nonatomic, assign, readwrite, getter = isAnimating) BOOL animating;
+@property (nonatomic, assign, readwrite) CGFloat velocity;
+@property (nonatomic, assign, readwrite) CGFloat targetY;
+@property (nonatomic, assign, readwrite) CFTimeInterval startTime;
+@property (nonatomic, strong, readwrite) CADisplayLink *displayLink;
+@property (nonatomic, copy, readwrite) PKAnimationCompletionBlock completionHandler;
+
+@end
+
+@implementation PKInteractiveAnimator
+
+#pragma mark - Initialization
+
++ (instancetype)animatorForLayer:(CALayer *)layer
+{
+    return [[[self class] alloc] initWithLayer:layer];
+}
+
+- (instancetype)initWithLayer:(CALayer *)layer
+{
+    self = [super init];
+    
+    if (self)
+    {
+        self.layer = layer;
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    [_displayLink invalidate];
+}
+
+#pragma mark - API
+
+- (void)animateToPosition:(CGPoint)position
+                 velocity:(CGFloat)velocity
+                 duration:(NSTimeInterval)duration
+               completion:(PKAnimationCompletionBlock)completion
+{
+    [self finishWithPosition:self.layer.position finished:NO];
+    
+    PKRevealCoreMotion motion = PKRevealCoreMotionMake(self.layer.position.x, position.x, velocity, duration);
+    [self startMotion:motion targetY:position.y completion:completion];
+}
+
+- (void)animateToPosition:(CGPoint)position
+                 velocity:(CGFloat)velocity
+                   spring:(PKRevealCoreSpring)spring
+               completion:(PKAnimationCompletionBlock)completion
+{
+    [self finishWithPosition:self.layer.position finished:NO];
+    
+    PKRevealCoreMotion motion = PKRevealCoreMotionMakeSpring(self.layer.position.x,
+                                                             position.x,
+                                                             velocity,
+                                                             spring,
+                                                             kPKInteractiveAnimatorRestingDistance);
+    [self startMotion:motion targetY:position.y completion:completion];
+}
+
+- (CGPoint)interruptAnimation
+{
+    CGPoint position = self.layer.position;
+    [self finishWithPosition:position finished:NO];
+    
+    return position;
+}
+
+#pragma mark - Internal
+
+- (void)startMotion:(PKRevealCoreMotion)motion targetY:(CGFloat)targetY completion:(PKAnimationCompletionBlock)completion
+{
+    if (motion.duration <= 0.0)
+    {
+        [self setLayerPosition:CGPointMake(motion.to, targetY)];
+        
+        if (completion)
+        {
+            completion(YES);
+        }
+        
+        return;
+    }
+    
+    _motion = motion;
+    
+    self.targetY = targetY;
+    self.velocity = motion.velocity;
+    self.completionHandler = completion;
+    self.startTime = CACurrentMediaTime();
+    self.animating = YES;
+    
+    self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayLinkDidFire:)];
+    [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink
+{
+    CFTimeInterval time = displayLink.timestamp + displayLink.duration - self.startTime;
+    
+    if (PKRevealCoreMotionIsFinished(&_motion, time))
+    {
+        [self finishWithPosition:CGPointMake(_motion.to, self.targetY) finished:YES];
+    }
+    else
+    {
+        self.velocity = PKRevealCoreMotionVelocity(&_motion, time);
+        [self setLayerPosition:CGPointMake(PKRevealCoreMotionPosition(&_motion, time), self.targetY)];
+    }
+}
+
+- (void)finishWithPosition:(CGPoint)position finished:(BOOL)finished
+{
+    if (!self.isAnimating)
+    {
+        return;
+    }
+    
+    [self.displayLink invalidate];
+    self.displayLink = nil;
+    self.animating = NO;
+    self.velocity = 0.0;
+    
+    [self setLayerPosition:position];
+    
+    PKAnimationCompletionBlock completion = self.completionHandler;
+    self.completionHandler = nil;
+    
+    if (completion)
+    {
+        completion(finished);
+    }
+}
+
+- (void)setLayerPosition:(CGPoint)position
+{
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    self.layer.position = position;
+    [CATransaction commit];
+    
+    if (self.progressHandler)
+    {
+        self.progressHandler(position);
+    }
+}
+
+@end
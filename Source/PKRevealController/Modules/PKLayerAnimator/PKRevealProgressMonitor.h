@@ -0,0 +1,95 @@
+/*
+    PKRevealController > PKRevealProgressMonitor.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <QuartzCore/QuartzCore.h>
+#import "PKRevealCore.h"
+
+typedef enum : NSUInteger
+{
+    /// The left view's progress changed.
+    PKRevealProgressEventLeft           = 1 << 0,
+    /// The right view's progress changed.
+    PKRevealProgressEventRight          = 1 << 1,
+    /// The change was driven by a pan gesture.
+    PKRevealProgressEventInteractive    = 1 << 2,
+    /// The change was driven by an animated or immediate state change.
+    PKRevealProgressEventAutomatic      = 1 << 3,
+    PKRevealProgressEventAll            = (PKRevealProgressEventLeft |
+                                           PKRevealProgressEventRight |
+                                           PKRevealProgressEventInteractive |
+                                           PKRevealProgressEventAutomatic)
+} PKRevealProgressEvents;
+
+typedef void(^PKRevealProgressBlock)(PKRevealCoreRevealProgress progress, PKRevealProgressEvents events);
+typedef PKRevealCoreRevealProgress(^PKRevealProgressMappingBlock)(CGFloat position);
+
+/**
+ Reports the reveal progress of a moving layer to its observers, at most once per display frame. Pan updates
+ are coalesced until the next frame, animations are sampled from the layer's presentation. The display link
+ only runs between -beginMonitoring and -endMonitoring, and only while there are observers.
+ */
+@interface PKRevealProgressMonitor : NSObject
+
+#pragma mark - Properties
+@property (nonatomic, strong, readwrite) CALayer *layer;
+
+/// Maps the layer's horizontal position to the reveal progress. Required.
+@property (nonatomic, copy, readwrite) PKRevealProgressMappingBlock progressForPosition;
+
+/// The progress most recently reported to the observers.
+@property (nonatomic, assign, readonly) PKRevealCoreRevealProgress progress;
+
+@property (nonatomic, assign, readonly) BOOL hasObservers;
+@property (nonatomic, assign, readonly, getter = isMonitoring) BOOL monitoring;
+
+#pragma mark - Methods
++ (instancetype)monitorForLayer:(CALayer *)layer;
+
+/**
+ Registers an observer.
+ 
+ @param events The sides and sources the observer is interested in. It is called if at least one side and one source match.
+ @param block Called on the main thread with the new progress and the events that caused it.
+ @return An opaque token to pass to -removeObserver:.
+ */
+- (id)addObserverForEvents:(PKRevealProgressEvents)events usingBlock:(PKRevealProgressBlock)block;
+
+- (void)removeObserver:(id)observer;
+
+/// Starts sampling the layer once per frame.
+- (void)beginMonitoring;
+
+/// Reports any pending update and the layer's resting position, and stops sampling.
+- (void)endMonitoring;
+
+/// Reports the position of a pan gesture on the next frame, replacing any update still pending.
+- (void)setNeedsUpdateWithInteractivePosition:(CGFloat)position;
+
+/// Reports the layer's position immediately, e.g. after a state change without animation.
+- (void)update;
+
+@end
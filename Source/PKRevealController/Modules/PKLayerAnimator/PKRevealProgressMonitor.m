@@ -0,0 +1,218 @@
+/*
+    PKRevealController > PKRevealProgressMonitor.m
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PKRevealProgressMonitor.h"
+
+@interface PKRevealProgressObserver : NSObject
+
+@property (nonatomic, assign, readwrite) PKRevealProgressEvents events;
+@property (nonatomic, copy, readwrite) PKRevealProgressBlock block;
+
+@end
+
+@implementation PKRevealProgressObserver
+
+@end
+
+@interface PKRevealProgressMonitor ()
+{
+    CGFloat _pendingPosition;
+    BOOL _hasPendingPosition;
+}
+
+#pragma mark - Properties
+@property (nonatomic, assign, readwrite) PKRevealCoreRevealProgress progress;
+@property (nonatomic, assign, readwrite, getter = isMonitoring) BOOL monitoring;
+@property (nonatomic, strong, readwrite) NSMutableArray *observers;
+@property (nonatomic, strong, readwrite) CADisplayLink *displayLink;
+
+@end
+
+@implementation PKRevealProgressMonitor
+
+#pragma mark - Initialization
+
++ (instancetype)monitorForLayer:(CALayer *)layer
+{
+    return [[[self class] alloc] initWithLayer:layer];
+}
+
+- (instancetype)initWithLayer:(CALayer *)layer
+{
+    self = [super init];
+    
+    if (self)
+    {
+        self.layer = layer;
+        self.observers = [NSMutableArray array];
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    [_displayLink invalidate];
+}
+
+#pragma mark - API
+
+- (BOOL)hasObservers
+{
+    return ([self.observers count] > 0);
+}
+
+- (id)addObserverForEvents:(PKRevealProgressEvents)events usingBlock:(PKRevealProgressBlock)block
+{
+    PKRevealProgressObserver *observer = [PKRevealProgressObserver new];
+    observer.events = events;
+    observer.block = block;
+    
+    [self.observers addObject:observer];
+    [self updateDisplayLink];
+    
+    return observer;
+}
+
+- (void)removeObserver:(id)observer
+{
+    [self.observers removeObjectIdenticalTo:observer];
+    [self updateDisplayLink];
+}
+
+- (void)beginMonitoring
+{
+    self.monitoring = YES;
+    [self updateDisplayLink];
+}
+
+- (void)endMonitoring
+{
+    [self reportPendingPosition];
+    [self reportPosition:self.layer.position.x events:PKRevealProgressEventAutomatic];
+    
+    self.monitoring = NO;
+    [self updateDisplayLink];
+}
+
+- (void)setNeedsUpdateWithInteractivePosition:(CGFloat)position
+{
+    _pendingPosition = position;
+    _hasPendingPosition = YES;
+}
+
+- (void)update
+{
+    _hasPendingPosition = NO;
+    [self reportPosition:self.layer.position.x events:PKRevealProgressEventAutomatic];
+}
+
+#pragma mark - Internal
+
+- (void)updateDisplayLink
+{
+    BOOL needsDisplayLink = (self.monitoring && [self hasObservers]);
+    
+    if (needsDisplayLink && !self.displayLink)
+    {
+        self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayLinkDidFire:)];
+        [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+    else if (!needsDisplayLink && self.displayLink)
+    {
+        [self.displayLink invalidate];
+        self.displayLink = nil;
+    }
+}
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink
+{
+    if (_hasPendingPosition)
+    {
+        [self reportPendingPosition];
+    }
+    else
+    {
+        [self reportPosition:[self displayedPosition].x events:PKRevealProgressEventAutomatic];
+    }
+}
+
+- (void)reportPendingPosition
+{
+    if (_hasPendingPosition)
+    {
+        _hasPendingPosition = NO;
+        [self reportPosition:_pendingPosition events:PKRevealProgressEventInteractive];
+    }
+}
+
+- (void)reportPosition:(CGFloat)position events:(PKRevealProgressEvents)source
+{
+    if (![self hasObservers] || !self.progressForPosition)
+    {
+        return;
+    }
+    
+    PKRevealCoreRevealProgress progress = self.progressForPosition(position);
+    PKRevealProgressEvents events = source;
+    
+    if (progress.left != _progress.left)
+    {
+        events |= PKRevealProgressEventLeft;
+    }
+    
+    if (progress.right != _progress.right)
+    {
+        events |= PKRevealProgressEventRight;
+    }
+    
+    if (events == source)
+    {
+        return;
+    }
+    
+    self.progress = progress;
+    
+    // Observers may remove themselves while being notified.
+    for (PKRevealProgressObserver *observer in [self.observers copy])
+    {
+        PKRevealProgressEvents matches = (observer.events & events);
+        
+        if ((matches & (PKRevealProgressEventLeft | PKRevealProgressEventRight)) &&
+            (matches & (PKRevealProgressEventInteractive | PKRevealProgressEventAutomatic)))
+        {
+            observer.block(progress, events);
+        }
+    }
+}
+
+- (CGPoint)displayedPosition
+{
+    CALayer *presentationLayer = [self.layer presentationLayer];
+    return presentationLayer ? presentationLayer.position : self.layer.position;
+}
+
+@end
@@ -26,14 +26,32 @@
 
 #import "PKAnimation.h"
 #import "PKAnimating.h"
+#import "PKTimingCurve.h"
 
 typedef void(^PKSequentialAnimationProgressBlock)(NSValue *fromValue, NSValue *toValue, NSUInteger index);
 
+typedef enum : NSUInteger
+{
+    /// Each segment is committed as a separate animation once the previous one stopped.
+    PKSequentialAnimationModeChained,
+    /// All segments are compiled into a single keyframe animation that runs entirely on the render server.
+    PKSequentialAnimationModeKeyframe
+} PKSequentialAnimationMode;
+
 @interface PKSequentialAnimation : NSObject <PKAnimating>
 
 #pragma mark - Properties
 @property (nonatomic, copy, readwrite) PKSequentialAnimationProgressBlock progressHandler;
 
+/// How the segments are committed. Defaults to PKSequentialAnimationModeChained. In keyframe mode the progress handler is still called at every segment boundary.
+@property (nonatomic, assign, readwrite) PKSequentialAnimationMode mode;
+
+/// The curve the animation follows from its first to its last value, across all segments. If nil, the first segment eases in, the last segment eases out and all others are linear. Defaults to nil.
+@property (nonatomic, strong, readwrite) PKTimingCurve *timingCurve;
+
+/// YES from the moment the animation is started or prepared for reuse until its completion handler has been called.
+@property (nonatomic, assign, readonly, getter = isInUse) BOOL inUse;
+
 #pragma mark - Methods
 + (instancetype)animationForKeyPath:(NSString *)keyPath
                              values:(NSArray *)values
@@ -45,4 +63,11 @@ typedef void(^PKSequentialAnimationProgressBlock)(NSValue *fromValue, NSValue *t
                            progress:(PKSequentialAnimationProgressBlock)progress
                          completion:(PKAnimationCompletionBlock)completion;
 
+/**
+ Resets the animation to new values and marks it as in use. The key, the keyframe animation and the timing functions are kept. Used by PKAnimationPool, must not be called while the animation is in use.
+ */
+- (void)prepareForReuseWithKeyPath:(NSString *)keyPath
+                            values:(NSArray *)values
+                          duration:(NSTimeInterval)duration;
+
 @end
@@ -26,11 +26,24 @@
 
 #import "PKSequentialAnimation.h"
 #import "NSObject+PKBlocks.h"
+#import "PKTrace.h"
+#import "PKAnimationPool.h"
 
 @interface PKSequentialAnimation ()
 
 #pragma mark - Properties
 @property (nonatomic, strong, readwrite) NSArray *animations;
+@property (nonatomic, copy, readwrite) NSString *keyPath;
+@property (nonatomic, strong, readwrite) NSArray *values;
+@property (nonatomic, assign, readwrite) NSTimeInterval duration;
+@property (nonatomic, strong, readwrite) NSArray *keyframeValues;
+@property (nonatomic, strong, readwrite) NSArray *keyframeTimes;
+@property (nonatomic, assign, readwrite) NSUInteger keyframeGeneration;
+@property (nonatomic, assign, readwrite, getter = isInUse) BOOL inUse;
+@property (nonatomic, strong, readwrite) NSArray *segmentKeys;
+@property (nonatomic, copy, readwrite) NSString *keyframeKey;
+@property (nonatomic, strong, readwrite) CAKeyframeAnimation *keyframeAnimation;
+@property (nonatomic, strong, readwrite) NSArray *keyframeTimingFunctions;
 
 @end
 
@@ -61,26 +74,77 @@
 {
     PKSequentialAnimation *animation = [[PKSequentialAnimation alloc] init];
     
-    animation.animations = [animation animationsForKeyPath:keyPath withValues:values duration:duration];
+    animation.keyPath = keyPath;
+    animation.values = values;
+    animation.duration = duration;
     animation.completionHandler = completion;
     animation.progressHandler = progress;
     
     return animation;
 }
 
+- (void)prepareForReuseWithKeyPath:(NSString *)keyPath
+                            values:(NSArray *)values
+                          duration:(NSTimeInterval)duration
+{
+    self.keyPath = keyPath;
+    self.values = values;
+    self.duration = duration;
+    self.mode = PKSequentialAnimationModeChained;
+    self.timingCurve = nil;
+    self.progressHandler = nil;
+    self.startHandler = nil;
+    self.completionHandler = nil;
+    self.animations = nil;
+    self.segmentKeys = nil;
+    self.keyframeValues = nil;
+    self.keyframeTimes = nil;
+    self.inUse = YES;
+}
+
+- (NSArray *)animations
+{
+    // The segment animations are only needed in chained mode, hence they are built lazily.
+    if (!_animations)
+    {
+        _animations = [self animationsForKeyPath:self.keyPath withValues:self.values duration:self.duration];
+    }
+    
+    return _animations;
+}
+
 - (NSArray *)animationsForKeyPath:(NSString *)keyPath
                        withValues:(NSArray *)values
                          duration:(NSTimeInterval)duration
 {
     NSMutableArray *animations = [NSMutableArray arrayWithCapacity:[values count]];
+    id startValue = [self.layer valueForKeyPath:keyPath];
+    PKTimingCurve *timingCurve = startValue ? self.timingCurve : nil;
+    
+    // A timing curve spans all segments. Each segment takes the part of the curve during which the
+    // animated property covers the segment's share of the total distance.
+    NSArray *keyTimes = timingCurve ? [self keyTimesForValues:[@[startValue] arrayByAddingObjectsFromArray:values]] : nil;
     
     [values enumerateObjectsUsingBlock:^(NSValue *value, NSUInteger index, BOOL *stop)
      {
          PKAnimation *animation = [PKAnimation animationWithKeyPath:keyPath];
          animation.fromValue = [((CALayer *)self.layer.presentationLayer) valueForKeyPath:keyPath];
          animation.toValue = value;
-         animation.duration = duration / [values count];
-         animation.timingFunction = [self timingFunctionForAnimationAtIndex:index totalNumberOfAnimations:[values count]];
+         
+         if (timingCurve)
+         {
+             CGFloat startTime = [timingCurve timeForValue:[keyTimes[index] doubleValue]];
+             CGFloat endTime = [timingCurve timeForValue:[keyTimes[index + 1] doubleValue]];
+             
+             animation.duration = duration * (endTime - startTime);
+             animation.timingFunction = [timingCurve timingFunctionForSegmentFromTime:startTime toTime:endTime];
+         }
+         else
+         {
+             animation.duration = duration / [values count];
+             animation.timingFunction = [self timingFunctionForAnimationAtIndex:index totalNumberOfAnimations:[values count]];
+         }
+         
          animation.identifier = index;
          animation.delegate = self;
          
@@ -92,17 +156,46 @@
 
 - (NSString *)key
 {
-    return [NSString stringWithFormat:@"%lu", (unsigned long)[self hash]];
+    // The keys are interned for the lifetime of the animation, which may be reused many times.
+    if (!_key)
+    {
+        _key = [NSString stringWithFormat:@"%lu", (unsigned long)[self hash]];
+    }
+    
+    return _key;
 }
 
 - (NSString *)keyForAnimationAtIndex:(NSUInteger)index
 {
-    return [NSString stringWithFormat:@"%@%@", self.key, [(PKAnimation *)self.animations[index] key]];
+    if (!self.segmentKeys)
+    {
+        NSMutableArray *segmentKeys = [NSMutableArray arrayWithCapacity:[self.animations count]];
+        
+        for (PKAnimation *animation in self.animations)
+        {
+            [segmentKeys addObject:[NSString stringWithFormat:@"%@%@", self.key, [animation key]]];
+        }
+        
+        self.segmentKeys = segmentKeys;
+    }
+    
+    return self.segmentKeys[index];
 }
 
 - (void)startAnimationOnLayer:(CALayer *)layer
 {
-    if (!self.isAnimating && [self.animations count] > 0)
+    if (self.isAnimating || [self.values count] == 0)
+    {
+        return;
+    }
+    
+    self.inUse = YES;
+    
+    if (self.mode == PKSequentialAnimationModeKeyframe)
+    {
+        [self startKeyframeAnimationOnLayer:layer];
+    }
+    else
     {
         self.layer = layer;
         PKAnimation *firstAnimation = self.animations[0];
@@ -119,52 +212,199 @@
     
     NSArray *animationKeys = [self.layer.animationKeys copy];
     
+    self.keyframeGeneration++;
+    
     [animationKeys enumerateObjectsUsingBlock:^(NSString *key, NSUInteger idx, BOOL *stop)
      {
          CAAnimation *animation = [self.layer animationForKey:key];
          
-         if ([animation isMemberOfClass:[PKAnimation class]] &&
+         if ([animation isKindOfClass:[CAPropertyAnimation class]] &&
              [key hasPrefix:self.key])
          {
-             PKAnimation *animation = (PKAnimation *)[self.layer animationForKey:key];
-             [self.layer setValue:[presentationLayer valueForKeyPath:animation.keyPath] forKeyPath:animation.keyPath];
+             CAPropertyAnimation *propertyAnimation = (CAPropertyAnimation *)animation;
+             [self.layer setValue:[presentationLayer valueForKeyPath:propertyAnimation.keyPath] forKeyPath:propertyAnimation.keyPath];
              [self.layer removeAnimationForKey:key];
          }
      }];
 }
 
+#pragma mark - Keyframe Mode
+
+- (void)startKeyframeAnimationOnLayer:(CALayer *)layer
+{
+    self.layer = layer;
+    
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:([self.values count] + 1)];
+    [values addObject:[self.layer valueForKeyPath:self.keyPath]];
+    [values addObjectsFromArray:self.values];
+    
+    if (!self.timingCurve && [self.keyframeTimingFunctions count] != [self.values count])
+    {
+        NSMutableArray *timingFunctions = [NSMutableArray arrayWithCapacity:[self.values count]];
+        
+        for (NSUInteger index = 0; index < [self.values count]; index++)
+        {
+            [timingFunctions addObject:[self timingFunctionForAnimationAtIndex:index totalNumberOfAnimations:[self.values count]]];
+        }
+        
+        self.keyframeTimingFunctions = timingFunctions;
+    }
+    
+    self.keyframeValues = values;
+    self.keyframeTimes = [self keyTimesForValues:values];
+    
+    // Layers copy added animations, hence a single keyframe animation serves every run.
+    if (!self.keyframeAnimation)
+    {
+        self.keyframeAnimation = [CAKeyframeAnimation animation];
+    }
+    
+    CAKeyframeAnimation *animation = self.keyframeAnimation;
+    animation.keyPath = self.keyPath;
+    animation.values = values;
+    animation.keyTimes = self.keyframeTimes;
+    
+    // A timing curve applies to the animation as a whole, while the segments in between keep a constant pace.
+    animation.timingFunction = self.timingCurve.timingFunction;
+    animation.timingFunctions = self.timingCurve ? nil : self.keyframeTimingFunctions;
+    animation.duration = self.duration;
+    animation.delegate = self;
+    
+    [self.layer setValue:[values lastObject] forKeyPath:self.keyPath];
+    [self.layer addAnimation:animation forKey:[self keyForKeyframeAnimation]];
+    
+    // Animations retain their delegate. Only the layer's copy needs it.
+    animation.delegate = nil;
+}
+
+- (NSString *)keyForKeyframeAnimation
+{
+    if (!self.keyframeKey)
+    {
+        self.keyframeKey = [NSString stringWithFormat:@"%@keyframes", self.key];
+    }
+    
+    return self.keyframeKey;
+}
+
+/*
+ * Key times are distributed proportionally to the length of each segment, such that the
+ * animated property moves at a constant pace across segment boundaries. Values that are not
+ * points fall back to segments of equal duration.
+ */
+- (NSArray *)keyTimesForValues:(NSArray *)values
+{
+    NSUInteger count = [values count];
+    NSMutableArray *keyTimes = [NSMutableArray arrayWithCapacity:count];
+    CGFloat lengths[count];
+    CGFloat totalLength = 0.0;
+    
+    lengths[0] = 0.0;
+    
+    for (NSUInteger index = 1; index < count; index++)
+    {
+        NSValue *fromValue = values[index - 1];
+        NSValue *toValue = values[index];
+        
+        if ([fromValue isKindOfClass:[NSValue class]] && strcmp([fromValue objCType], @encode(CGPoint)) == 0 &&
+            [toValue isKindOfClass:[NSValue class]] && strcmp([toValue objCType], @encode(CGPoint)) == 0)
+        {
+            CGPoint from = [fromValue CGPointValue];
+            CGPoint to = [toValue CGPointValue];
+            lengths[index] = hypot(to.x - from.x, to.y - from.y);
+        }
+        else
+        {
+            lengths[index] = 1.0;
+        }
+        
+        totalLength += lengths[index];
+    }
+    
+    CGFloat accumulatedLength = 0.0;
+    
+    for (NSUInteger index = 0; index < count; index++)
+    {
+        accumulatedLength += lengths[index];
+        
+        if (totalLength > 0.0)
+        {
+            [keyTimes addObject:@(accumulatedLength / totalLength)];
+        }
+        else
+        {
+            [keyTimes addObject:@((count > 1) ? ((CGFloat)index / (CGFloat)(count - 1)) : 1.0)];
+        }
+    }
+    
+    return keyTimes;
+}
+
+- (void)scheduleProgressForKeyframeSegmentsWithGeneration:(NSUInteger)generation
+{
+    NSUInteger segmentCount = [self.keyframeValues count] - 1;
+    
+    [self reportProgressForKeyframeSegmentAtIndex:0];
+    
+    for (NSUInteger index = 1; index < segmentCount; index++)
+    {
+        CGFloat keyTime = [self.keyframeTimes[index] doubleValue];
+        NSTimeInterval delay = (self.timingCurve ? [self.timingCurve timeForValue:keyTime] : keyTime) * self.duration;
+        
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^
+        {
+            if (self.isAnimating && self.keyframeGeneration == generation)
+            {
+                [self reportProgressForKeyframeSegmentAtIndex:index];
+            }
+        });
+    }
+}
+
+- (void)reportProgressForKeyframeSegmentAtIndex:(NSUInteger)index
+{
+    PKTraceInstant("segment", NULL, "index", index, NULL, 0);
+    
+    if (self.progressHandler)
+    {
+        self.progressHandler(self.keyframeValues[index], self.keyframeValues[index + 1], index);
+    }
+}
+
+#pragma mark - Timing
+
 - (CAMediaTimingFunction *)timingFunctionForAnimationAtIndex:(NSUInteger)index totalNumberOfAnimations:(NSUInteger)total
 {
     CAMediaTimingFunction *function = nil;
     
     if (total == 1)
     {
-        function = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseInEaseOut];
+        function = [PKAnimationPool timingFunctionWithName:kCAMediaTimingFunctionEaseInEaseOut];
     }
     else if (total == 2)
     {
         if (index == 0)
         {
-            function = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseIn];
+            function = [PKAnimationPool timingFunctionWithName:kCAMediaTimingFunctionEaseIn];
         }
         else
         {
-            function = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseOut];
+            function = [PKAnimationPool timingFunctionWithName:kCAMediaTimingFunctionEaseOut];
         }
     }
     else
     {
         if (index == 0)
         {
-            function = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseIn];
+            function = [PKAnimationPool timingFunctionWithName:kCAMediaTimingFunctionEaseIn];
         }
         else if ((index + 1) == total)
         {
-            function = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseOut];
+            function = [PKAnimationPool timingFunctionWithName:kCAMediaTimingFunctionEaseOut];
         }
         else
         {
-            function = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionLinear];
+            function = [PKAnimationPool timingFunctionWithName:kCAMediaTimingFunctionLinear];
         }
     }
     
@@ -175,6 +415,23 @@
 {
     self.animating = YES;
     
+    if ([anim isKindOfClass:[CAKeyframeAnimation class]])
+    {
+        PKTraceBegin("keyframes", self, "segments", [self.values count]);
+        
+        NSUInteger generation = self.keyframeGeneration;
+        
+        [self pk_performBlock:^
+        {
+            [self scheduleProgressForKeyframeSegmentsWithGeneration:generation];
+        }
+        onMainThread:YES];
+        
+        return;
+    }
+    
+    PKTraceBegin("segment", self, "index", anim.pk_identifier);
+    
     PKAnimation *animation = self.animations[anim.pk_identifier];
     
     [self pk_performBlock:^
@@ -189,14 +446,22 @@
 
 - (void)animationDidStop:(CAAnimation *)anim finished:(BOOL)flag
 {
+    BOOL isKeyframeAnimation = [anim isKindOfClass:[CAKeyframeAnimation class]];
     NSInteger currentIndex = anim.pk_identifier;
-    NSInteger lastAnimationIndex = [self.animations count] - 1;
     
-    if (flag && currentIndex < lastAnimationIndex)
+    if (isKeyframeAnimation)
+    {
+        PKTraceEnd("keyframes", self, "finished", flag);
+    }
+    else
+    {
+        PKTraceEnd("segment", self, "finished", flag);
+    }
+    
+    if (flag && !isKeyframeAnimation && currentIndex < ((NSInteger)[self.animations count] - 1))
     {
         NSUInteger nextAnimationIndex = currentIndex + 1;
         
-        NSString *nextAnimationIndexString = [NSString stringWithFormat:@"%lu", (unsigned long)nextAnimationIndex];
         PKAnimation *nextAnimation = self.animations[nextAnimationIndex];
         nextAnimation.fromValue = [((CALayer *)self.layer.presentationLayer) valueForKeyPath:nextAnimation.keyPath];
         
@@ -212,7 +477,7 @@
         onMainThread:YES];
         
         [self.layer setValue:nextAnimation.toValue forKeyPath:nextAnimation.keyPath];
-        [self.layer addAnimation:nextAnimation forKey:nextAnimationIndexString];
+        [self.layer addAnimation:nextAnimation forKey:[self keyForAnimationAtIndex:nextAnimationIndex]];
     }
     else
     {
@@ -225,6 +490,8 @@
             {
                 self.completionHandler(flag);
             }
+            
+            self.inUse = NO;
         }
         onMainThread:YES];
     }
@@ -0,0 +1,73 @@
+/*
+    PKRevealController > PKTimingCurve.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <QuartzCore/QuartzCore.h>
+#import "PKRevealCoreCurve.h"
+
+/**
+ An immutable cubic-bezier timing curve. The curve is sampled into a lookup table once, when it is created,
+ such that custom and display-link-driven animations can evaluate it in constant time on every frame. Its
+ timingFunction describes the same curve to Core Animation.
+ */
+@interface PKTimingCurve : NSObject
+
+#pragma mark - Properties
+@property (nonatomic, assign, readonly) CGPoint controlPoint1;
+@property (nonatomic, assign, readonly) CGPoint controlPoint2;
+
+/// The curve as a Core Animation timing function.
+@property (nonatomic, strong, readonly) CAMediaTimingFunction *timingFunction;
+
+/// The curve's lookup table, for evaluation from C. Valid for the lifetime of the curve.
+@property (nonatomic, assign, readonly) const PKRevealCoreCurve *coreCurve;
+
+#pragma mark - Methods
+/**
+ @param controlPoint1 The first control point. Its x coordinate is clamped to [0, 1].
+ @param controlPoint2 The second control point. Its x coordinate is clamped to [0, 1].
+ */
++ (instancetype)curveWithControlPoint1:(CGPoint)controlPoint1 controlPoint2:(CGPoint)controlPoint2;
+
+/// @return Shared instances of the curves of the kCAMediaTimingFunction names.
++ (instancetype)linearCurve;
++ (instancetype)easeInCurve;
++ (instancetype)easeOutCurve;
++ (instancetype)easeInEaseOutCurve;
+
+/// @return The fraction of the distance covered at the given fraction of the duration, in constant time.
+- (CGFloat)valueAtTime:(CGFloat)time;
+
+/// @return The earliest fraction of the duration at which the given fraction of the distance is covered.
+- (CGFloat)timeForValue:(CGFloat)value;
+
+/**
+ @return A timing function for the part of the curve between two fractions of the duration. Consecutive
+ animations using consecutive segments together follow this curve.
+ */
+- (CAMediaTimingFunction *)timingFunctionForSegmentFromTime:(CGFloat)startTime toTime:(CGFloat)endTime;
+
+@end
@@ -0,0 +1,175 @@
+/*
+    PKRevealController > PKTimingCurve.m
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PKTimingCurve.h"
+#import "PKAnimationPool.h"
+
+@interface PKTimingCurve ()
+{
+    PKRevealCoreCurve _curve;
+}
+
+#pragma mark - Properties
+@property (nonatomic, assign, readwrite) CGPoint controlPoint1;
+@property (nonatomic, assign, readwrite) CGPoint controlPoint2;
+@property (nonatomic, strong, readwrite) CAMediaTimingFunction *timingFunction;
+
+@end
+
+@implementation PKTimingCurve
+
+#pragma mark - Initialization
+
++ (instancetype)curveWithControlPoint1:(CGPoint)controlPoint1 controlPoint2:(CGPoint)controlPoint2
+{
+    return [[[self class] alloc] initWithControlPoint1:controlPoint1 controlPoint2:controlPoint2 timingFunction:nil];
+}
+
++ (instancetype)linearCurve
+{
+    static PKTimingCurve *curve = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^
+    {
+        curve = [[self class] curveWithTimingFunctionName:kCAMediaTimingFunctionLinear];
+    });
+    
+    return curve;
+}
+
++ (instancetype)easeInCurve
+{
+    static PKTimingCurve *curve = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^
+    {
+        curve = [[self class] curveWithTimingFunctionName:kCAMediaTimingFunctionEaseIn];
+    });
+    
+    return curve;
+}
+
++ (instancetype)easeOutCurve
+{
+    static PKTimingCurve *curve = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^
+    {
+        curve = [[self class] curveWithTimingFunctionName:kCAMediaTimingFunctionEaseOut];
+    });
+    
+    return curve;
+}
+
++ (instancetype)easeInEaseOutCurve
+{
+    static PKTimingCurve *curve = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^
+    {
+        curve = [[self class] curveWithTimingFunctionName:kCAMediaTimingFunctionEaseInEaseOut];
+    });
+    
+    return curve;
+}
+
++ (instancetype)curveWithTimingFunctionName:(NSString *)name
+{
+    CAMediaTimingFunction *timingFunction = [PKAnimationPool timingFunctionWithName:name];
+    float controlPoint1[2];
+    float controlPoint2[2];
+    
+    [timingFunction getControlPointAtIndex:1 values:controlPoint1];
+    [timingFunction getControlPointAtIndex:2 values:controlPoint2];
+    
+    return [[[self class] alloc] initWithControlPoint1:CGPointMake(controlPoint1[0], controlPoint1[1])
+                                         controlPoint2:CGPointMake(controlPoint2[0], controlPoint2[1])
+                                        timingFunction:timingFunction];
+}
+
+- (instancetype)initWithControlPoint1:(CGPoint)controlPoint1
+                        controlPoint2:(CGPoint)controlPoint2
+                       timingFunction:(CAMediaTimingFunction *)timingFunction
+{
+    self = [super init];
+    
+    if (self)
+    {
+        _curve = PKRevealCoreCurveMake(controlPoint1.x, controlPoint1.y, controlPoint2.x, controlPoint2.y);
+        
+        self.controlPoint1 = CGPointMake(_curve.x1, _curve.y1);
+        self.controlPoint2 = CGPointMake(_curve.x2, _curve.y2);
+        self.timingFunction = timingFunction ?: [self timingFunctionWithControlPoints:(double[4]){ _curve.x1, _curve.y1, _curve.x2, _curve.y2 }];
+    }
+    
+    return self;
+}
+
+#pragma mark - API
+
+- (const PKRevealCoreCurve *)coreCurve
+{
+    return &_curve;
+}
+
+- (CGFloat)valueAtTime:(CGFloat)time
+{
+    return PKRevealCoreCurveValue(&_curve, time);
+}
+
+- (CGFloat)timeForValue:(CGFloat)value
+{
+    return PKRevealCoreCurveTime(&_curve, value);
+}
+
+- (CAMediaTimingFunction *)timingFunctionForSegmentFromTime:(CGFloat)startTime toTime:(CGFloat)endTime
+{
+    if (startTime <= 0.0 && endTime >= 1.0)
+    {
+        return self.timingFunction;
+    }
+    
+    double controlPoints[4];
+    PKRevealCoreCurveSegment(&_curve, startTime, endTime, controlPoints);
+    
+    return [self timingFunctionWithControlPoints:controlPoints];
+}
+
+#pragma mark - Internal
+
+- (CAMediaTimingFunction *)timingFunctionWithControlPoints:(const double *)controlPoints
+{
+    return [CAMediaTimingFunction functionWithControlPoints:controlPoints[0]
+                                                           :controlPoints[1]
+                                                           :controlPoints[2]
+                                                           :controlPoints[3]];
+}
+
+@end
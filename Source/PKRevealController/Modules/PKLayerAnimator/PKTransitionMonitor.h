@@ -0,0 +1,62 @@
+/*
+    PKRevealController > PKTransitionMonitor.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <QuartzCore/QuartzCore.h>
+#import "PKRevealCoreTelemetry.h"
+
+/**
+ Observes a layer's presentation from a display link while a transition is in flight, and measures the
+ transition's latency, missed frame deadlines and duration. The display link only runs between
+ -beginTransitionFromState:interactive: and -endTransitionToState:sample:.
+ */
+@interface PKTransitionMonitor : NSObject
+
+#pragma mark - Properties
+@property (nonatomic, strong, readonly) CALayer *layer;
+@property (nonatomic, assign, readonly, getter = isMonitoring) BOOL monitoring;
+
+#pragma mark - Methods
++ (instancetype)monitorForLayer:(CALayer *)layer;
+
+/**
+ Starts measuring a transition. A transition that is still being measured is discarded.
+ 
+ @param state The state the transition starts in.
+ @param interactive Whether the transition is driven by a pan gesture.
+ */
+- (void)beginTransitionFromState:(PKRevealCoreState)state interactive:(BOOL)interactive;
+
+/**
+ Stops measuring the current transition.
+ 
+ @param state The state the transition ended in.
+ @param sample Receives the measurements of the transition.
+ @return NO if no transition was being measured.
+ */
+- (BOOL)endTransitionToState:(PKRevealCoreState)state sample:(PKRevealCoreTransitionSample *)sample;
+
+@end
@@ -0,0 +1,104 @@
+/*
+    PKRevealController > PKTransitionMonitor.m
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PKTransitionMonitor.h"
+
+@interface PKTransitionMonitor ()
+{
+    PKRevealCoreTransitionTracker _tracker;
+}
+
+#pragma mark - Properties
+@property (nonatomic, strong, readwrite) CALayer *layer;
+@property (nonatomic, assign, readwrite, getter = isMonitoring) BOOL monitoring;
+@property (nonatomic, strong, readwrite) CADisplayLink *displayLink;
+
+@end
+
+@implementation PKTransitionMonitor
+
+#pragma mark - Initialization
+
++ (instancetype)monitorForLayer:(CALayer *)layer
+{
+    return [[[self class] alloc] initWithLayer:layer];
+}
+
+- (instancetype)initWithLayer:(CALayer *)layer
+{
+    self = [super init];
+    
+    if (self)
+    {
+        self.layer = layer;
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    [_displayLink invalidate];
+}
+
+#pragma mark - API
+
+- (void)beginTransitionFromState:(PKRevealCoreState)state interactive:(BOOL)interactive
+{
+    PKRevealCoreTransitionTrackerBegin(&_tracker, state, CACurrentMediaTime(), [self displayedPosition].x, interactive);
+    
+    if (!self.displayLink)
+    {
+        self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayLinkDidFire:)];
+        [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+    
+    self.monitoring = YES;
+}
+
+- (BOOL)endTransitionToState:(PKRevealCoreState)state sample:(PKRevealCoreTransitionSample *)sample
+{
+    [self.displayLink invalidate];
+    self.displayLink = nil;
+    self.monitoring = NO;
+    
+    return PKRevealCoreTransitionTrackerEnd(&_tracker, state, CACurrentMediaTime(), sample);
+}
+
+#pragma mark - Internal
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink
+{
+    PKRevealCoreTransitionTrackerFrame(&_tracker, displayLink.timestamp, displayLink.duration, [self displayedPosition].x);
+}
+
+- (CGPoint)displayedPosition
+{
+    CALayer *presentationLayer = [self.layer presentationLayer];
+    return presentationLayer ? presentationLayer.position : self.layer.position;
+}
+
+@end
@@ -23,7 +23,61 @@
     IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
     CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
- 
+
 #import <Foundation/Foundation.h>
 
-FOUNDATION_EXTERN void PKLog(NSString *format, ...);
+#define PKLOG_LEVEL_NONE 0
+#define PKLOG_LEVEL_ERROR 1
+#define PKLOG_LEVEL_WARNING 2
+#define PKLOG_LEVEL_INFO 3
+#define PKLOG_LEVEL_DEBUG 4
+
+/*
+ * The maximum level that is logged. Statements above it compile out entirely, including the evaluation of
+ * their arguments. Defaults to PKLOG_LEVEL_DEBUG in DEBUG builds and PKLOG_LEVEL_NONE otherwise; define it
+ * in the build settings to keep logging in e.g. internal performance builds.
+ */
+#ifndef PKLOG_LEVEL
+    #ifdef DEBUG
+        #define PKLOG_LEVEL PKLOG_LEVEL_DEBUG
+    #else
+        #define PKLOG_LEVEL PKLOG_LEVEL_NONE
+    #endif
+#endif
+
+/**
+ Formats a message on the calling thread and appends it to the thread's log buffer, which is written to
+ stderr by a background thread. Never blocks; messages are dropped if the buffer is full. Use the level
+ macros below instead of calling this function directly.
+ */
+FOUNDATION_EXTERN void PKLogWrite(NSUInteger level, const char *file, unsigned int line, NSString *format, ...) NS_FORMAT_FUNCTION(4,5);
+
+/// Synchronously writes all buffered messages.
+FOUNDATION_EXTERN void PKLogFlush(void);
+
+#if PKLOG_LEVEL >= PKLOG_LEVEL_ERROR
+    #define PKLogError(format, ...) PKLogWrite(PKLOG_LEVEL_ERROR, __FILE__, __LINE__, format, ##__VA_ARGS__)
+#else
+    #define PKLogError(format, ...) do {} while (0)
+#endif
+
+#if PKLOG_LEVEL >= PKLOG_LEVEL_WARNING
+    #define PKLogWarning(format, ...) PKLogWrite(PKLOG_LEVEL_WARNING, __FILE__, __LINE__, format, ##__VA_ARGS__)
+#else
+    #define PKLogWarning(format, ...) do {} while (0)
+#endif
+
+#if PKLOG_LEVEL >= PKLOG_LEVEL_INFO
+    #define PKLogInfo(format, ...) PKLogWrite(PKLOG_LEVEL_INFO, __FILE__, __LINE__, format, ##__VA_ARGS__)
+#else
+    #define PKLogInfo(format, ...) do {} while (0)
+#endif
+
+#if PKLOG_LEVEL >= PKLOG_LEVEL_DEBUG
+    #define PKLogDebug(format, ...) PKLogWrite(PKLOG_LEVEL_DEBUG, __FILE__, __LINE__, format, ##__VA_ARGS__)
+#else
+    #define PKLogDebug(format, ...) do {} while (0)
+#endif
+
+/// Logs an error. Kept for existing call sites.
+#define PKLog(format, ...) PKLogError(format, ##__VA_ARGS__)
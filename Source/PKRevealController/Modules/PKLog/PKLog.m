@@ -25,47 +25,263 @@
  */
 
 #import "PKLog.h"
+#import "PKLogRing.h"
 #import <libgen.h>
+#import <pthread.h>
+#import <stdlib.h>
+#import <time.h>
 
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunused-macros"
+#define PKLOG_MAX_THREAD_COUNT 64
+#define PKLOG_DRAIN_INTERVAL_MSEC 100
 
-#define STACK_IDX 0
-#define FRAMEWORK_IDX 1
-#define MEMORY_ADDR_IDX 2
-#define CLASS_CALLER_IDX 3
-#define FUNCTION_CALLER_IDX 4
-#define LINE_CALLER_IDX 5
+/*
+ * Every logging thread owns a ring buffer that is registered once, when the thread first logs. The rings
+ * are drained on a serial background queue, which is the only place that prints. A ring outlives its
+ * thread until it has been drained. The drain timer only runs while there is something to drain: a pass
+ * that finds the rings empty suspends it and the next write resumes it, so an idle process is not woken.
+ */
+typedef struct
+{
+    PKLogRing ring;
+    volatile int32_t isAbandoned;
+} PKLogThreadBuffer;
+
+static pthread_key_t PKLogThreadBufferKey;
+static pthread_mutex_t PKLogThreadBuffersLock = PTHREAD_MUTEX_INITIALIZER;
+static PKLogThreadBuffer *PKLogThreadBuffers[PKLOG_MAX_THREAD_COUNT];
+static dispatch_queue_t PKLogDrainQueue;
+static dispatch_source_t PKLogDrainTimer;
+static volatile int32_t PKLogDrainTimerIsArmed;
+
+static const char *PKLogLevelName(uint32_t level)
+{
+    switch (level)
+    {
+        case PKLOG_LEVEL_ERROR:
+            return "ERROR";
+            
+        case PKLOG_LEVEL_WARNING:
+            return "WARNING";
+            
+        case PKLOG_LEVEL_INFO:
+            return "INFO";
+            
+        default:
+            return "DEBUG";
+    }
+}
 
-#pragma clang diagnostic pop
+static void PKLogThreadBufferAbandon(void *buffer)
+{
+    __atomic_store_n(&((PKLogThreadBuffer *)buffer)->isAbandoned, 1, __ATOMIC_RELEASE);
+}
+
+static void PKLogPrintRecord(const PKLogRecord *record)
+{
+    time_t seconds = (time_t)(record->timestamp + kCFAbsoluteTimeIntervalSince1970);
+    int milliseconds = (int)((record->timestamp - floor(record->timestamp)) * 1000.0);
+    struct tm localTime;
+    char dateTime[32];
+    
+    localtime_r(&seconds, &localTime);
+    strftime(dateTime, sizeof(dateTime), "%Y-%m-%d %H:%M:%S", &localTime);
+    
+    char file[PATH_MAX];
+    strlcpy(file, record->file, sizeof(file));
+    
+    fprintf(stderr, "%s:%03d %s [%s:%u] - %s\n", dateTime, milliseconds, PKLogLevelName(record->level), basename(file), record->line, record->message);
+}
 
-void PKLog(NSString *format, ...)
+/// @return The number of records printed or reported as dropped.
+static NSUInteger PKLogDrain(void)
 {
-#ifdef DEBUG
-    if (format)
+    PKLogRecord record;
+    NSUInteger drainedCount = 0;
+    
+    pthread_mutex_lock(&PKLogThreadBuffersLock);
+    
+    for (NSUInteger index = 0; index < PKLOG_MAX_THREAD_COUNT; index++)
     {
-        NSString *sourceString = [[NSThread callStackSymbols] objectAtIndex:1];
-        NSCharacterSet *separatorSet = [NSCharacterSet characterSetWithCharactersInString:@" -[]+?.,"];
-        NSMutableArray *array = [NSMutableArray arrayWithArray:[sourceString componentsSeparatedByCharactersInSet:separatorSet]];
-        [array removeObject:@""];
+        PKLogThreadBuffer *buffer = PKLogThreadBuffers[index];
         
-        NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
-        [dateFormatter setLocale:[NSLocale currentLocale]];
-        [dateFormatter setDateFormat: @"yyyy-MM-dd HH:mm:ss:SSS"];
+        if (!buffer)
+        {
+            continue;
+        }
         
-        va_list argumentList;
-        va_start(argumentList, format);
+        // Read the flag first, so that records written right before the thread exited are drained as well.
+        BOOL isAbandoned = __atomic_load_n(&buffer->isAbandoned, __ATOMIC_ACQUIRE);
         
-        NSString *formattedString = [[NSString alloc] initWithFormat:format arguments:argumentList];
+        while (PKLogRingRead(&buffer->ring, &record))
+        {
+            PKLogPrintRecord(&record);
+            drainedCount++;
+        }
         
-        const char *class = [[array objectAtIndex:CLASS_CALLER_IDX] UTF8String];
-        const char *line = [[array objectAtIndex:LINE_CALLER_IDX] UTF8String];
-        const char *formattedCString = [[formattedString stringByReplacingOccurrencesOfString:@"%%" withString:@"%%%%"] UTF8String];
-        const char *dateTime = [[dateFormatter stringFromDate:[NSDate date]] UTF8String];
+        uint32_t droppedCount = PKLogRingTakeDroppedCount(&buffer->ring);
+        
+        if (droppedCount > 0)
+        {
+            fprintf(stderr, "PKLog dropped %u messages.\n", droppedCount);
+            drainedCount += droppedCount;
+        }
+        
+        if (isAbandoned)
+        {
+            PKLogThreadBuffers[index] = NULL;
+            free(buffer);
+        }
+    }
+    
+    pthread_mutex_unlock(&PKLogThreadBuffersLock);
+    
+    fflush(stderr);
+    
+    return drainedCount;
+}
+
+/// Resumes the drain timer unless it runs already. The first pass is one interval away, so writes are batched.
+static void PKLogArmDrainTimer(void)
+{
+    if (!__atomic_exchange_n(&PKLogDrainTimerIsArmed, 1, __ATOMIC_SEQ_CST))
+    {
+        dispatch_source_set_timer(PKLogDrainTimer,
+                                  dispatch_time(DISPATCH_TIME_NOW, PKLOG_DRAIN_INTERVAL_MSEC * NSEC_PER_MSEC),
+                                  PKLOG_DRAIN_INTERVAL_MSEC * NSEC_PER_MSEC,
+                                  10 * NSEC_PER_MSEC);
+        dispatch_resume(PKLogDrainTimer);
+    }
+}
+
+static void PKLogDrainTimerFired(void)
+{
+    if (PKLogDrain() > 0)
+    {
+        return;
+    }
+    
+    dispatch_suspend(PKLogDrainTimer);
+    __atomic_store_n(&PKLogDrainTimerIsArmed, 0, __ATOMIC_SEQ_CST);
+    
+    // A write committed before the flag was cleared did not arm the timer, hence the rings are checked once more.
+    if (PKLogDrain() > 0)
+    {
+        PKLogArmDrainTimer();
+    }
+}
+
+static void PKLogSetup(void)
+{
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^
+    {
+        pthread_key_create(&PKLogThreadBufferKey, PKLogThreadBufferAbandon);
         
-        printf("%s [%s:%s] - %s\n", dateTime, class, line, formattedCString);
+        PKLogDrainQueue = dispatch_queue_create("org.zuui.PKLog", DISPATCH_QUEUE_SERIAL);
+        dispatch_set_target_queue(PKLogDrainQueue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0));
         
-        va_end(argumentList);
+        // Sources are created suspended. The timer is resumed by the first write.
+        PKLogDrainTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, PKLogDrainQueue);
+        dispatch_source_set_event_handler(PKLogDrainTimer, ^
+        {
+            PKLogDrainTimerFired();
+        });
+    });
+}
+
+static PKLogRing *PKLogCurrentThreadRing(void)
+{
+    PKLogThreadBuffer *buffer = pthread_getspecific(PKLogThreadBufferKey);
+    
+    if (buffer)
+    {
+        return &buffer->ring;
+    }
+    
+    buffer = calloc(1, sizeof(PKLogThreadBuffer));
+    
+    if (!buffer)
+    {
+        return NULL;
+    }
+    
+    PKLogRingInitialize(&buffer->ring);
+    
+    pthread_mutex_lock(&PKLogThreadBuffersLock);
+    
+    NSUInteger index = 0;
+    
+    while (index < PKLOG_MAX_THREAD_COUNT && PKLogThreadBuffers[index])
+    {
+        index++;
+    }
+    
+    if (index < PKLOG_MAX_THREAD_COUNT)
+    {
+        PKLogThreadBuffers[index] = buffer;
+    }
+    
+    pthread_mutex_unlock(&PKLogThreadBuffersLock);
+    
+    if (index == PKLOG_MAX_THREAD_COUNT)
+    {
+        free(buffer);
+        return NULL;
+    }
+    
+    pthread_setspecific(PKLogThreadBufferKey, buffer);
+    
+    return &buffer->ring;
+}
+
+void PKLogWrite(NSUInteger level, const char *file, unsigned int line, NSString *format, ...)
+{
+    if (!format)
+    {
+        return;
+    }
+    
+    PKLogSetup();
+    
+    PKLogRing *ring = PKLogCurrentThreadRing();
+    PKLogRecord *record = ring ? PKLogRingBeginWrite(ring) : NULL;
+    
+    if (!record)
+    {
+        return;
     }
-#endif
+    
+    va_list argumentList;
+    va_start(argumentList, format);
+    NSString *message = [[NSString alloc] initWithFormat:format arguments:argumentList];
+    va_end(argumentList);
+    
+    NSUInteger length = 0;
+    [message getBytes:record->message
+            maxLength:(PKLogRingMessageLength - 1)
+           usedLength:&length
+             encoding:NSUTF8StringEncoding
+              options:0
+                range:NSMakeRange(0, message.length)
+       remainingRange:NULL];
+    record->message[length] = '\0';
+    
+    record->timestamp = CFAbsoluteTimeGetCurrent();
+    record->file = file;
+    record->line = line;
+    record->level = (uint32_t)level;
+    
+    PKLogRingCommitWrite(ring);
+    PKLogArmDrainTimer();
+}
+
+void PKLogFlush(void)
+{
+    PKLogSetup();
+    
+    dispatch_sync(PKLogDrainQueue, ^
+    {
+        PKLogDrain();
+    });
 }
@@ -0,0 +1,82 @@
+/*
+    PKRevealController > PKLogRing.c
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PKLogRing.h"
+#include <string.h>
+
+/*
+ * head and tail increase monotonically and wrap around at 2^32, which is a multiple of the capacity. The
+ * producer owns head, the consumer owns tail. Each side publishes its own index with release semantics
+ * and observes the other one with acquire semantics, so record contents never race.
+ */
+
+void PKLogRingInitialize(PKLogRing *ring)
+{
+    ring->head = 0;
+    ring->tail = 0;
+    ring->droppedCount = 0;
+}
+
+PKLogRecord *PKLogRingBeginWrite(PKLogRing *ring)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    
+    if (head - tail >= PKLogRingCapacity)
+    {
+        __atomic_fetch_add(&ring->droppedCount, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    
+    return &ring->records[head % PKLogRingCapacity];
+}
+
+void PKLogRingCommitWrite(PKLogRing *ring)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+bool PKLogRingRead(PKLogRing *ring, PKLogRecord *record)
+{
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    
+    if (head == tail)
+    {
+        return false;
+    }
+    
+    memcpy(record, &ring->records[tail % PKLogRingCapacity], sizeof(PKLogRecord));
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    
+    return true;
+}
+
+uint32_t PKLogRingTakeDroppedCount(PKLogRing *ring)
+{
+    return __atomic_exchange_n(&ring->droppedCount, 0, __ATOMIC_RELAXED);
+}
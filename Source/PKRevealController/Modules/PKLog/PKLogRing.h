@@ -0,0 +1,90 @@
+/*
+    PKRevealController > PKLogRing.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * A fixed-size, lock-free single producer / single consumer ring of log records. PKLog keeps one ring per
+ * logging thread, so the producer never contends with other threads, and drains all rings from a single
+ * background thread. Plain C99 with GCC/Clang atomic builtins, so it can be tested on any platform.
+ */
+
+#ifndef PKLogRing_h
+#define PKLogRing_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PKLogRingCapacity 128
+#define PKLogRingMessageLength 192
+
+typedef struct
+{
+    double timestamp;
+    const char *file;
+    uint32_t line;
+    uint32_t level;
+    char message[PKLogRingMessageLength];
+} PKLogRecord;
+
+typedef struct
+{
+    PKLogRecord records[PKLogRingCapacity];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t droppedCount;
+} PKLogRing;
+
+/// Resets the ring to its empty state.
+void PKLogRingInitialize(PKLogRing *ring);
+
+/**
+ Reserves the next record for writing. Producer only.
+ 
+ @return The record to fill in, or NULL if the ring is full, in which case the dropped count is incremented.
+ */
+PKLogRecord *PKLogRingBeginWrite(PKLogRing *ring);
+
+/// Publishes the record returned by the last call to PKLogRingBeginWrite to the consumer. Producer only.
+void PKLogRingCommitWrite(PKLogRing *ring);
+
+/**
+ Copies the oldest record out of the ring. Consumer only.
+ 
+ @return false if the ring is empty.
+ */
+bool PKLogRingRead(PKLogRing *ring, PKLogRecord *record);
+
+/// @return The number of records dropped because the ring was full, and resets it. Consumer only.
+uint32_t PKLogRingTakeDroppedCount(PKLogRing *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
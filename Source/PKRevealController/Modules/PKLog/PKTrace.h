@@ -0,0 +1,82 @@
+/*
+    PKRevealController > PKTrace.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+/*
+ * An optional tracing sink for reveal controller activity, i.e. state changes, animation segments, child
+ * controller attach/detach and pan gestures. Events are recorded into a preallocated in-memory buffer and
+ * written on request in the Chrome trace event JSON format, which about:tracing and Perfetto open.
+ * Timestamps are CACurrentMediaTime() in microseconds and events carry the process id and the thread id
+ * reported by pthread_threadid_np(), so they can be lined up with other traces of the app. Recording is
+ * off until PKTraceStart() is called and costs a single branch per event site while off.
+ */
+
+/// Whether events are currently being recorded. Do not set directly.
+FOUNDATION_EXTERN volatile BOOL PKTraceIsEnabled;
+
+/**
+ Starts recording into a newly allocated buffer of the given capacity, discarding previously recorded events. Events beyond the capacity are dropped. Call on the main thread.
+ */
+FOUNDATION_EXTERN void PKTraceStart(NSUInteger capacity);
+
+/**
+ Stops recording. Recorded events are kept until the next call to PKTraceStart(). Call on the main thread.
+ */
+FOUNDATION_EXTERN void PKTraceStop(void);
+
+/**
+ Writes all recorded events to a file in the Chrome trace event JSON format. Call on the main thread.
+ 
+ @param path The path of the file, which is replaced if it exists.
+ @param error Receives the error if the file could not be written.
+ @return YES if the file was written.
+ */
+FOUNDATION_EXTERN BOOL PKTraceWriteToFile(NSString *path, NSError **error);
+
+/**
+ Records an event. Strings are not copied and must stay valid until the trace is written, e.g. string literals or class names. Use the macros below instead of calling this function directly.
+ */
+FOUNDATION_EXTERN void PKTraceRecord(char phase,
+                                     const char *name,
+                                     const void *identifier,
+                                     const char *detail,
+                                     const char *argumentName0,
+                                     long long argument0,
+                                     const char *argumentName1,
+                                     long long argument1);
+
+/// Records an instant event with up to two named integer arguments. Pass NULL names for unused arguments.
+#define PKTraceInstant(name, detail, argumentName0, argument0, argumentName1, argument1) \
+    do { if (PKTraceIsEnabled) PKTraceRecord('i', name, NULL, detail, argumentName0, argument0, argumentName1, argument1); } while (0)
+
+/// Begins an asynchronous slice. Slices with the same identifier nest.
+#define PKTraceBegin(name, identifier, argumentName, argument) \
+    do { if (PKTraceIsEnabled) PKTraceRecord('b', name, (__bridge const void *)(identifier), NULL, argumentName, argument, NULL, 0); } while (0)
+
+/// Ends the innermost asynchronous slice with the given name and identifier.
+#define PKTraceEnd(name, identifier, argumentName, argument) \
+    do { if (PKTraceIsEnabled) PKTraceRecord('e', name, (__bridge const void *)(identifier), NULL, argumentName, argument, NULL, 0); } while (0)
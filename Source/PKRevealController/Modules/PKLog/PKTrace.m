@@ -0,0 +1,104 @@
+/*
+    PKRevealController > PKTrace.m
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PKTrace.h"
+#import "PKTraceBuffer.h"
+#import <QuartzCore/QuartzCore.h>
+#import <pthread.h>
+#import <unistd.h>
+
+static const char * const PKTraceCategory = "PKRevealController";
+
+volatile BOOL PKTraceIsEnabled = NO;
+static PKTraceBuffer PKTraceActiveBuffer;
+
+void PKTraceStart(NSUInteger capacity)
+{
+    PKTraceIsEnabled = NO;
+    PKTraceBufferDestroy(&PKTraceActiveBuffer);
+    PKTraceIsEnabled = PKTraceBufferInitialize(&PKTraceActiveBuffer, capacity);
+}
+
+void PKTraceStop(void)
+{
+    PKTraceIsEnabled = NO;
+}
+
+BOOL PKTraceWriteToFile(NSString *path, NSError **error)
+{
+    FILE *file = fopen([path fileSystemRepresentation], "w");
+    
+    if (!file)
+    {
+        if (error)
+        {
+            *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{ NSFilePathErrorKey : path }];
+        }
+        
+        return NO;
+    }
+    
+    PKTraceBufferWriteJSON(&PKTraceActiveBuffer, file, getpid());
+    
+    BOOL isWritten = (ferror(file) == 0);
+    isWritten = (fclose(file) == 0) && isWritten;
+    
+    if (!isWritten && error)
+    {
+        *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{ NSFilePathErrorKey : path }];
+    }
+    
+    return isWritten;
+}
+
+void PKTraceRecord(char phase,
+                   const char *name,
+                   const void *identifier,
+                   const char *detail,
+                   const char *argumentName0,
+                   long long argument0,
+                   const char *argumentName1,
+                   long long argument1)
+{
+    PKTraceEvent event;
+    uint64_t threadID = 0;
+    
+    pthread_threadid_np(NULL, &threadID);
+    
+    event.phase = (PKTraceEventPhase)phase;
+    event.category = PKTraceCategory;
+    event.name = name;
+    event.detail = detail;
+    event.identifier = (uint64_t)(uintptr_t)identifier;
+    event.argumentNames[0] = argumentName0;
+    event.arguments[0] = argument0;
+    event.argumentNames[1] = argumentName1;
+    event.arguments[1] = argument1;
+    event.timestamp = CACurrentMediaTime();
+    event.threadID = threadID;
+    
+    PKTraceBufferAppend(&PKTraceActiveBuffer, &event);
+}
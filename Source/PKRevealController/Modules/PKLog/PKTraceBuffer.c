@@ -0,0 +1,187 @@
+/*
+    PKRevealController > PKTraceBuffer.c
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PKTraceBuffer.h"
+#include <stdlib.h>
+
+/*
+ * Appending threads reserve a slot by incrementing count, which may therefore exceed the capacity, and
+ * publish it by setting its committed flag with release semantics. The writer only reads slots whose flag
+ * it observes with acquire semantics.
+ */
+
+struct PKTraceSlot
+{
+    PKTraceEvent event;
+    uint32_t isCommitted;
+};
+
+#pragma mark - Lifecycle
+
+bool PKTraceBufferInitialize(PKTraceBuffer *buffer, size_t capacity)
+{
+    buffer->slots = calloc(capacity, sizeof(PKTraceSlot));
+    buffer->capacity = buffer->slots ? capacity : 0;
+    buffer->count = 0;
+    buffer->droppedCount = 0;
+    
+    return (buffer->slots != NULL);
+}
+
+void PKTraceBufferDestroy(PKTraceBuffer *buffer)
+{
+    free(buffer->slots);
+    
+    buffer->slots = NULL;
+    buffer->capacity = 0;
+    buffer->count = 0;
+}
+
+void PKTraceBufferReset(PKTraceBuffer *buffer)
+{
+    for (size_t index = 0; index < buffer->capacity; index++)
+    {
+        __atomic_store_n(&buffer->slots[index].isCommitted, 0, __ATOMIC_RELAXED);
+    }
+    
+    __atomic_store_n(&buffer->count, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&buffer->droppedCount, 0, __ATOMIC_RELAXED);
+}
+
+#pragma mark - Recording
+
+bool PKTraceBufferAppend(PKTraceBuffer *buffer, const PKTraceEvent *event)
+{
+    size_t index = __atomic_fetch_add(&buffer->count, 1, __ATOMIC_RELAXED);
+    
+    if (index >= buffer->capacity)
+    {
+        __atomic_fetch_add(&buffer->droppedCount, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    
+    buffer->slots[index].event = *event;
+    __atomic_store_n(&buffer->slots[index].isCommitted, 1, __ATOMIC_RELEASE);
+    
+    return true;
+}
+
+#pragma mark - Export
+
+static void PKTraceWriteString(FILE *file, const char *string)
+{
+    fputc('"', file);
+    
+    for (const unsigned char *character = (const unsigned char *)string; *character; character++)
+    {
+        if (*character == '"' || *character == '\\')
+        {
+            fputc('\\', file);
+            fputc(*character, file);
+        }
+        else if (*character < 0x20)
+        {
+            fprintf(file, "\\u%04x", *character);
+        }
+        else
+        {
+            fputc(*character, file);
+        }
+    }
+    
+    fputc('"', file);
+}
+
+static void PKTraceWriteEvent(FILE *file, const PKTraceEvent *event, int processID)
+{
+    fputs("{\"name\":", file);
+    PKTraceWriteString(file, event->name ? event->name : "");
+    fputs(",\"cat\":", file);
+    PKTraceWriteString(file, event->category ? event->category : "");
+    fprintf(file, ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%llu",
+            (char)event->phase,
+            event->timestamp * 1e6,
+            processID,
+            (unsigned long long)event->threadID);
+    
+    if (event->phase == PKTraceEventPhaseInstant)
+    {
+        fputs(",\"s\":\"t\"", file);
+    }
+    else
+    {
+        fprintf(file, ",\"id\":\"0x%llx\"", (unsigned long long)event->identifier);
+    }
+    
+    fputs(",\"args\":{", file);
+    
+    bool hasArgument = false;
+    
+    if (event->detail)
+    {
+        fputs("\"detail\":", file);
+        PKTraceWriteString(file, event->detail);
+        hasArgument = true;
+    }
+    
+    for (int index = 0; index < PKTraceEventArgumentCount; index++)
+    {
+        if (event->argumentNames[index])
+        {
+            fputs(hasArgument ? "," : "", file);
+            PKTraceWriteString(file, event->argumentNames[index]);
+            fprintf(file, ":%lld", (long long)event->arguments[index]);
+            hasArgument = true;
+        }
+    }
+    
+    fputs("}}", file);
+}
+
+size_t PKTraceBufferWriteJSON(PKTraceBuffer *buffer, FILE *file, int processID)
+{
+    size_t count = __atomic_load_n(&buffer->count, __ATOMIC_ACQUIRE);
+    size_t writtenCount = 0;
+    
+    count = (count < buffer->capacity) ? count : buffer->capacity;
+    
+    fputs("{\"traceEvents\":[", file);
+    
+    for (size_t index = 0; index < count; index++)
+    {
+        if (__atomic_load_n(&buffer->slots[index].isCommitted, __ATOMIC_ACQUIRE))
+        {
+            fputs((writtenCount > 0) ? ",\n" : "\n", file);
+            PKTraceWriteEvent(file, &buffer->slots[index].event, processID);
+            writtenCount++;
+        }
+    }
+    
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":%llu}}\n",
+            (unsigned long long)__atomic_load_n(&buffer->droppedCount, __ATOMIC_RELAXED));
+    
+    return writtenCount;
+}
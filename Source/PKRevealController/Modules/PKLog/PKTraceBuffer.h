@@ -0,0 +1,117 @@
+/*
+    PKRevealController > PKTraceBuffer.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * A preallocated, append-only buffer of trace events that can be written out in the Chrome trace event JSON
+ * format understood by about:tracing and Perfetto. Appending never allocates or locks; events beyond the
+ * capacity are counted and dropped. Plain C99 with GCC/Clang atomic builtins, so it can be tested on any
+ * platform.
+ */
+
+#ifndef PKTraceBuffer_h
+#define PKTraceBuffer_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    PKTraceEventPhaseInstant    = 'i',
+    PKTraceEventPhaseAsyncBegin = 'b',
+    PKTraceEventPhaseAsyncEnd   = 'e'
+} PKTraceEventPhase;
+
+#define PKTraceEventArgumentCount 2
+
+/// Strings are not copied and must outlive the buffer, e.g. string literals or class names.
+typedef struct
+{
+    PKTraceEventPhase phase;
+    const char *category;
+    const char *name;
+    /// Optional. Written as the "detail" argument.
+    const char *detail;
+    /// Async begin and end events with the same category and identifier form one slice.
+    uint64_t identifier;
+    /// Optional. Unused arguments have a NULL name.
+    const char *argumentNames[PKTraceEventArgumentCount];
+    int64_t arguments[PKTraceEventArgumentCount];
+    /// In seconds.
+    double timestamp;
+    uint64_t threadID;
+} PKTraceEvent;
+
+typedef struct PKTraceSlot PKTraceSlot;
+
+typedef struct
+{
+    PKTraceSlot *slots;
+    size_t capacity;
+    size_t count;
+    size_t droppedCount;
+} PKTraceBuffer;
+
+/**
+ Allocates room for capacity events. This is the only allocation the buffer ever makes.
+ 
+ @return false if the allocation failed.
+ */
+bool PKTraceBufferInitialize(PKTraceBuffer *buffer, size_t capacity);
+
+/// Frees the events.
+void PKTraceBufferDestroy(PKTraceBuffer *buffer);
+
+/// Discards all events. Must not race with PKTraceBufferAppend.
+void PKTraceBufferReset(PKTraceBuffer *buffer);
+
+/**
+ Copies an event into the buffer. Safe to call from any number of threads.
+ 
+ @return false if the buffer is full, in which case the dropped count is incremented.
+ */
+bool PKTraceBufferAppend(PKTraceBuffer *buffer, const PKTraceEvent *event);
+
+/**
+ Writes all completely appended events as a Chrome trace event JSON object.
+ 
+ @param buffer The buffer.
+ @param file The file to write to.
+ @param processID The pid all events are attributed to.
+ @return The number of events written.
+ */
+size_t PKTraceBufferWriteJSON(PKTraceBuffer *buffer, FILE *file, int processID);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
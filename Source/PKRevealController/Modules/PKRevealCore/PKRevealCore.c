@@ -0,0 +1,658 @@
+/*
+    PKRevealController > PKRevealCore.c
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PKRevealCore.h"
+#include <math.h>
+
+#pragma mark - Geometry
+
+PKRevealCoreGeometry PKRevealCoreGeometryMake(double midX,
+                                              PKRevealCoreWidthRange leftRange,
+                                              PKRevealCoreWidthRange rightRange,
+                                              bool hasLeft,
+                                              bool hasRight,
+                                              const PKRevealCoreDampening *dampening)
+{
+    PKRevealCoreGeometry geometry;
+    
+    geometry.midX = midX;
+    geometry.anchors[PKRevealCoreStateLeftPresentation - 1] = midX + leftRange.maximum;
+    geometry.anchors[PKRevealCoreStateLeft - 1] = midX + leftRange.minimum;
+    geometry.anchors[PKRevealCoreStateFront - 1] = midX;
+    geometry.anchors[PKRevealCoreStateRight - 1] = midX - rightRange.minimum;
+    geometry.anchors[PKRevealCoreStateRightPresentation - 1] = midX - rightRange.maximum;
+    geometry.leftRange = leftRange;
+    geometry.rightRange = rightRange;
+    geometry.leftSnapThreshold = midX + (leftRange.minimum / 2.0);
+    geometry.rightSnapThreshold = midX - (rightRange.minimum / 2.0);
+    geometry.hasLeft = hasLeft;
+    geometry.hasRight = hasRight;
+    geometry.dampening = dampening ? *dampening : PKRevealCoreDampeningMake(PKRevealCoreDampeningCurveArctangent,
+                                                                            PKRevealCoreDampeningDefaultLimit);
+    
+    return geometry;
+}
+
+#pragma mark - Math
+
+double PKRevealCoreDampenedValue(const PKRevealCoreDampening *dampening, double realValue, PKRevealCoreWidthRange range)
+{
+    double width = range.maximum - range.minimum;
+    double distance = fabs(realValue);
+    
+    if (distance <= range.minimum || width <= 0.0)
+    {
+        return (distance <= range.minimum) ? realValue : copysign(range.minimum, realValue);
+    }
+    
+    // [min, max] -> [0, 1] -> dampened -> [min, max]
+    double result = PKRevealCoreDampeningValue(dampening, (distance - range.minimum) / width) * width + range.minimum;
+    
+    return copysign(result, realValue);
+}
+
+double PKRevealCoreUndampenedValue(const PKRevealCoreDampening *dampening, double dampenedValue, PKRevealCoreWidthRange range)
+{
+    double width = range.maximum - range.minimum;
+    double distance = fabs(dampenedValue);
+    
+    if (distance <= range.minimum || width <= 0.0)
+    {
+        return dampenedValue;
+    }
+    
+    double result = PKRevealCoreDampeningInverse(dampening, (distance - range.minimum) / width) * width + range.minimum;
+    
+    return copysign(result, dampenedValue);
+}
+
+#pragma mark - Gestures
+
+double PKRevealCoreFrontViewPositionForPan(const PKRevealCoreGeometry *geometry, double proposedX, double currentX)
+{
+    double frontX = PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateFront);
+    
+    if (!geometry->hasLeft && proposedX >= frontX)
+    {
+        return frontX;
+    }
+    else if (!geometry->hasRight && proposedX <= frontX)
+    {
+        return frontX;
+    }
+    
+    double leftX = PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateLeft);
+    double rightX = PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateRight);
+    
+    // Only the side the front view is on needs to be dampened.
+    if (proposedX >= leftX)
+    {
+        double leftPresentationX = PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateLeftPresentation);
+        double dampenedLeft = PKRevealCoreDampenedValue(&geometry->dampening, proposedX - geometry->midX, geometry->leftRange) + geometry->midX;
+        
+        return (proposedX >= leftPresentationX && dampenedLeft > leftPresentationX) ? currentX : dampenedLeft;
+    }
+    else if (proposedX <= rightX)
+    {
+        double rightPresentationX = PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateRightPresentation);
+        double dampenedRight = PKRevealCoreDampenedValue(&geometry->dampening, proposedX - geometry->midX, geometry->rightRange) + geometry->midX;
+        
+        return (proposedX <= rightPresentationX && dampenedRight < rightPresentationX) ? currentX : dampenedRight;
+    }
+    
+    return proposedX;
+}
+
+double PKRevealCorePanOrigin(const PKRevealCoreGeometry *geometry, double x)
+{
+    if (geometry->hasLeft && x > PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateLeft))
+    {
+        return PKRevealCoreUndampenedValue(&geometry->dampening, x - geometry->midX, geometry->leftRange) + geometry->midX;
+    }
+    else if (geometry->hasRight && x < PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateRight))
+    {
+        return PKRevealCoreUndampenedValue(&geometry->dampening, x - geometry->midX, geometry->rightRange) + geometry->midX;
+    }
+    
+    return x;
+}
+
+bool PKRevealCoreIsEdgePanTouch(const PKRevealCoreGeometry *geometry,
+                                PKRevealCoreState state,
+                                double x,
+                                double width,
+                                double leftInset,
+                                double rightInset)
+{
+    if (state != PKRevealCoreStateFront)
+    {
+        return true;
+    }
+    
+    return ((geometry->hasLeft && x <= leftInset) ||
+            (geometry->hasRight && x >= width - rightInset));
+}
+
+PKRevealCoreState PKRevealCoreStateForPosition(const PKRevealCoreGeometry *geometry, double x)
+{
+    if (x <= PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateRightPresentation))
+    {
+        return PKRevealCoreStateRightPresentation;
+    }
+    else if (x < geometry->midX)
+    {
+        return PKRevealCoreStateRight;
+    }
+    else if (x == geometry->midX)
+    {
+        return PKRevealCoreStateFront;
+    }
+    else if (x < PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateLeftPresentation))
+    {
+        return PKRevealCoreStateLeft;
+    }
+    
+    return PKRevealCoreStateLeftPresentation;
+}
+
+PKRevealCoreState PKRevealCoreSnapState(const PKRevealCoreGeometry *geometry, double x)
+{
+    if (x > geometry->midX && x > geometry->leftSnapThreshold)
+    {
+        return PKRevealCoreStateLeft;
+    }
+    else if (x < geometry->midX && x < geometry->rightSnapThreshold)
+    {
+        return PKRevealCoreStateRight;
+    }
+    
+    return PKRevealCoreStateFront;
+}
+
+PKRevealCoreState PKRevealCoreStateForPanRelease(const PKRevealCoreGeometry *geometry,
+                                                 PKRevealCoreState state,
+                                                 double x,
+                                                 double velocity,
+                                                 double quickSwipeVelocity)
+{
+    if (PKRevealCoreShouldMoveLeftwards(velocity, quickSwipeVelocity))
+    {
+        if (state == PKRevealCoreStateRight || state == PKRevealCoreStateRightPresentation)
+        {
+            return state;
+        }
+        else if (state == PKRevealCoreStateFront && geometry->hasRight)
+        {
+            return PKRevealCoreStateRight;
+        }
+        
+        return PKRevealCoreStateFront;
+    }
+    else if (PKRevealCoreShouldMoveRightwards(velocity, quickSwipeVelocity))
+    {
+        if (state == PKRevealCoreStateLeft || state == PKRevealCoreStateLeftPresentation)
+        {
+            return state;
+        }
+        else if (state == PKRevealCoreStateFront && geometry->hasLeft)
+        {
+            return PKRevealCoreStateLeft;
+        }
+        
+        return PKRevealCoreStateFront;
+    }
+    
+    return PKRevealCoreSnapState(geometry, x);
+}
+
+#pragma mark - Routes
+
+#define PKDirect(to) { 1, { PKRevealCoreState##to } }
+#define PKViaFront(to) { 2, { PKRevealCoreStateFront, PKRevealCoreState##to } }
+
+const PKRevealCoreRoute PKRevealCoreRoutes[PKRevealCoreStateCount][PKRevealCoreStateCount] =
+{
+    /* from LeftPresentation  */ { PKDirect(LeftPresentation),   PKDirect(Left),   PKDirect(Front), PKViaFront(Right), PKViaFront(RightPresentation) },
+    /* from Left              */ { PKDirect(LeftPresentation),   PKDirect(Left),   PKDirect(Front), PKViaFront(Right), PKViaFront(RightPresentation) },
+    /* from Front             */ { PKDirect(LeftPresentation),   PKDirect(Left),   PKDirect(Front), PKDirect(Right),   PKDirect(RightPresentation)   },
+    /* from Right             */ { PKViaFront(LeftPresentation), PKViaFront(Left), PKDirect(Front), PKDirect(Right),   PKDirect(RightPresentation)   },
+    /* from RightPresentation */ { PKViaFront(LeftPresentation), PKViaFront(Left), PKDirect(Front), PKDirect(Right),   PKDirect(RightPresentation)   }
+};
+
+#undef PKDirect
+#undef PKViaFront
+
+PKRevealCoreWaypoints PKRevealCorePlanRoute(const PKRevealCoreGeometry *geometry,
+                                            PKRevealCoreState fromState,
+                                            PKRevealCoreState toState)
+{
+    const PKRevealCoreRoute *route = PKRevealCoreRouteForTransition(fromState, toState);
+    PKRevealCoreWaypoints waypoints;
+    
+    waypoints.count = route->count;
+    
+    for (size_t index = 0; index < route->count; index++)
+    {
+        waypoints.positions[index] = PKRevealCoreGeometryAnchor(geometry, route->waypoints[index]);
+    }
+    
+    return waypoints;
+}
+
+#pragma mark - Reveal Effects
+
+static inline double PKRevealCoreRevealFraction(double offset, double minimum)
+{
+    if (offset <= 0.0)
+    {
+        return 0.0;
+    }
+    
+    return (minimum > 0.0) ? fmin(offset / minimum, 1.0) : 1.0;
+}
+
+PKRevealCoreRevealProgress PKRevealCoreRevealProgressForPosition(const PKRevealCoreGeometry *geometry, double x)
+{
+    PKRevealCoreRevealProgress progress;
+    
+    progress.left = PKRevealCoreRevealFraction(x - geometry->midX, geometry->leftRange.minimum);
+    progress.right = PKRevealCoreRevealFraction(geometry->midX - x, geometry->rightRange.minimum);
+    
+    return progress;
+}
+
+PKRevealCoreRevealTransform PKRevealCoreRevealTransformForPosition(const PKRevealCoreGeometry *geometry,
+                                                                   PKRevealCoreRevealEffect effect,
+                                                                   double x)
+{
+    PKRevealCoreRevealTransform transform;
+    double offset = x - geometry->midX;
+    // Rear views stay at rest while the front view is overdrawn.
+    double leftOffset = fmin(fmax(offset, 0.0), geometry->leftRange.minimum);
+    double rightOffset = fmax(fmin(offset, 0.0), -geometry->rightRange.minimum);
+    
+    transform.leftTranslation = (leftOffset - geometry->leftRange.minimum) * effect.parallaxRatio;
+    transform.rightTranslation = (rightOffset + geometry->rightRange.minimum) * effect.parallaxRatio;
+    
+    // The front view shrinks linearly until a rear view is revealed to its minimum width.
+    double minimum = (offset > 0.0) ? geometry->leftRange.minimum : geometry->rightRange.minimum;
+    double progress = (minimum > 0.0) ? fmin(fabs(offset) / minimum, 1.0) : ((offset != 0.0) ? 1.0 : 0.0);
+    
+    transform.frontScale = 1.0 - (1.0 - effect.frontScale) * progress;
+    
+    return transform;
+}
+
+static inline void PKRevealCoreRevealKeyframesAdd(PKRevealCoreRevealKeyframes *keyframes, double position)
+{
+    if (keyframes->count < PKRevealCoreRevealKeyframeCapacity)
+    {
+        keyframes->positions[keyframes->count] = position;
+        keyframes->count++;
+    }
+}
+
+PKRevealCoreRevealKeyframes PKRevealCoreRevealKeyframesForRoute(const PKRevealCoreGeometry *geometry,
+                                                                double x,
+                                                                const PKRevealCoreWaypoints *waypoints)
+{
+    PKRevealCoreRevealKeyframes keyframes;
+    double breakpoints[3] =
+    {
+        PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateRight),
+        geometry->midX,
+        PKRevealCoreGeometryAnchor(geometry, PKRevealCoreStateLeft)
+    };
+    double from = x;
+    
+    keyframes.count = 0;
+    PKRevealCoreRevealKeyframesAdd(&keyframes, from);
+    
+    for (size_t index = 0; index < waypoints->count; index++)
+    {
+        double to = waypoints->positions[index];
+        
+        // Breakpoints are ascending, hence they are visited backwards when moving to the left.
+        for (size_t step = 0; step < 3; step++)
+        {
+            double breakpoint = (to > from) ? breakpoints[step] : breakpoints[2 - step];
+            
+            if ((breakpoint - from) * (to - breakpoint) > 0.0)
+            {
+                PKRevealCoreRevealKeyframesAdd(&keyframes, breakpoint);
+            }
+        }
+        
+        PKRevealCoreRevealKeyframesAdd(&keyframes, to);
+        from = to;
+    }
+    
+    double totalDistance = 0.0;
+    
+    for (size_t index = 1; index < keyframes.count; index++)
+    {
+        totalDistance += fabs(keyframes.positions[index] - keyframes.positions[index - 1]);
+    }
+    
+    double distance = 0.0;
+    keyframes.keyTimes[0] = 0.0;
+    
+    for (size_t index = 1; index < keyframes.count; index++)
+    {
+        distance += fabs(keyframes.positions[index] - keyframes.positions[index - 1]);
+        keyframes.keyTimes[index] = (totalDistance > 0.0) ? (distance / totalDistance) : ((double)index / (double)(keyframes.count - 1));
+    }
+    
+    return keyframes;
+}
+
+double PKRevealCoreRouteVelocity(double x,
+                                 const PKRevealCoreWaypoints *waypoints,
+                                 const PKRevealCoreCurve *curve,
+                                 double duration,
+                                 double time)
+{
+    if (!(duration > 0.0) || time < 0.0 || time >= duration)
+    {
+        return 0.0;
+    }
+    
+    double totalDistance = 0.0;
+    double from = x;
+    
+    for (size_t index = 0; index < waypoints->count; index++)
+    {
+        totalDistance += fabs(waypoints->positions[index] - from);
+        from = waypoints->positions[index];
+    }
+    
+    double fraction = time / duration;
+    double distance = PKRevealCoreCurveValue(curve, fraction) * totalDistance;
+    double speed = PKRevealCoreCurveSlope(curve, fraction) * totalDistance / duration;
+    from = x;
+    
+    // The direction is the one of the segment the front view is on.
+    for (size_t index = 0; index < waypoints->count; index++)
+    {
+        double to = waypoints->positions[index];
+        double length = fabs(to - from);
+        
+        if (distance < length || index == waypoints->count - 1)
+        {
+            return (to < from) ? -speed : ((to > from) ? speed : 0.0);
+        }
+        
+        distance -= length;
+        from = to;
+    }
+    
+    return 0.0;
+}
+
+#pragma mark - Momentum Projection
+
+double PKRevealCoreProjectedPosition(double x, double velocity, double decelerationRate)
+{
+    if (decelerationRate <= 0.0 || decelerationRate >= 1.0)
+    {
+        return x;
+    }
+    
+    // The sum of the geometric series v/1000 * (r + r^2 + ...) travelled in one millisecond steps.
+    return x + (velocity / 1000.0) * decelerationRate / (1.0 - decelerationRate);
+}
+
+PKRevealCoreState PKRevealCoreStateForProjectedRelease(const PKRevealCoreGeometry *geometry,
+                                                       double x,
+                                                       double velocity,
+                                                       double decelerationRate,
+                                                       bool includesPresentationModes)
+{
+    double projectedX = PKRevealCoreProjectedPosition(x, velocity, decelerationRate);
+    
+    PKRevealCoreState result = PKRevealCoreStateFront;
+    double closestDistance = fabs(projectedX - geometry->midX);
+    
+    for (int state = PKRevealCoreStateLeftPresentation; state <= PKRevealCoreStateRightPresentation; state++)
+    {
+        bool isLeft = (state < PKRevealCoreStateFront);
+        bool isRight = (state > PKRevealCoreStateFront);
+        bool isPresentation = (state == PKRevealCoreStateLeftPresentation || state == PKRevealCoreStateRightPresentation);
+        
+        if ((isLeft && !geometry->hasLeft) ||
+            (isRight && !geometry->hasRight) ||
+            (isPresentation && !includesPresentationModes) ||
+            (!isLeft && !isRight))
+        {
+            continue;
+        }
+        
+        double distance = fabs(projectedX - PKRevealCoreGeometryAnchor(geometry, (PKRevealCoreState)state));
+        
+        if (distance < closestDistance)
+        {
+            closestDistance = distance;
+            result = (PKRevealCoreState)state;
+        }
+    }
+    
+    return result;
+}
+
+#pragma mark - Motion
+
+/*
+ * The Hermite motion uses the start velocity as its initial tangent and ends at rest. The curve stays
+ * monotonic as long as the initial tangent points towards the target and does not exceed three times
+ * the distance.
+ */
+PKRevealCoreMotion PKRevealCoreMotionMake(double from, double to, double velocity, double duration)
+{
+    PKRevealCoreMotion motion = { 0 };
+    
+    motion.curve = PKRevealCoreMotionCurveHermite;
+    motion.from = from;
+    motion.to = to;
+    motion.duration = (duration > 0.0) ? duration : 0.0;
+    motion.velocity = velocity;
+    
+    // Only a velocity towards the target can overshoot it. A velocity away from it is kept as is so that
+    // a retargeted motion continues smoothly before it turns around.
+    if ((to - from) * velocity > 0.0)
+    {
+        double limit = (motion.duration > 0.0) ? (3.0 * fabs(to - from) / motion.duration) : 0.0;
+        motion.velocity = fmax(-limit, fmin(velocity, limit));
+    }
+    
+    return motion;
+}
+
+/*
+ * The spring motion is the closed-form solution of m x'' + c x' + k x = 0 for the displacement x from the
+ * target, with x(0) = from - to and x'(0) = velocity:
+ *
+ *   underdamped:        x(t) = e^(-decay t) (a cos(frequency t) + b sin(frequency t))
+ *   critically damped:  x(t) = e^(-decay t) (a + b t)
+ *   overdamped:         x(t) = a e^(rootA t) + b e^(rootB t)
+ *
+ * The settling time is derived from the envelope of the solution, so no numeric integration is required
+ * when creating or evaluating the motion.
+ */
+PKRevealCoreSpring PKRevealCoreSpringClamped(PKRevealCoreSpring spring)
+{
+    // fmax returns the minimum for NaN inputs.
+    spring.mass = fmax(spring.mass, PKRevealCoreSpringMinimumMass);
+    spring.stiffness = fmax(spring.stiffness, PKRevealCoreSpringMinimumStiffness);
+    spring.damping = fmax(spring.damping, 2.0 * PKRevealCoreSpringMinimumDampingRatio * sqrt(spring.stiffness * spring.mass));
+    
+    return spring;
+}
+
+PKRevealCoreMotion PKRevealCoreMotionMakeSpring(double from,
+                                                double to,
+                                                double velocity,
+                                                PKRevealCoreSpring spring,
+                                                double restingDistance)
+{
+    PKRevealCoreMotion motion = { 0 };
+    
+    spring = PKRevealCoreSpringClamped(spring);
+    
+    motion.curve = PKRevealCoreMotionCurveSpring;
+    motion.from = from;
+    motion.to = to;
+    motion.velocity = velocity;
+    
+    double x0 = from - to;
+    double epsilon = (restingDistance > 0.0) ? restingDistance : 0.5;
+    double naturalFrequency = sqrt(spring.stiffness / spring.mass);
+    double dampingRatio = spring.damping / (2.0 * sqrt(spring.stiffness * spring.mass));
+    
+    if (fabs(x0) <= epsilon && fabs(velocity) <= epsilon * naturalFrequency)
+    {
+        return motion;
+    }
+    
+    if (dampingRatio < 1.0 - 1e-6)
+    {
+        motion.decay = dampingRatio * naturalFrequency;
+        motion.frequency = naturalFrequency * sqrt(1.0 - dampingRatio * dampingRatio);
+        motion.a = x0;
+        motion.b = (velocity + motion.decay * x0) / motion.frequency;
+        
+        double amplitude = sqrt(motion.a * motion.a + motion.b * motion.b);
+        motion.duration = (amplitude > epsilon && motion.decay > 0.0) ? log(amplitude / epsilon) / motion.decay : 0.0;
+    }
+    else if (dampingRatio <= 1.0 + 1e-6)
+    {
+        motion.decay = naturalFrequency;
+        motion.a = x0;
+        motion.b = velocity + naturalFrequency * x0;
+        
+        // Solves (|a| + |b| t) e^(-decay t) = epsilon with a few Newton steps, starting beyond the envelope's peak.
+        double a = fabs(motion.a);
+        double b = fabs(motion.b);
+        double t = fmax(0.0, 1.0 / motion.decay - a / fmax(b, 1e-9)) + log(fmax(a, epsilon) / epsilon + 1.0) / motion.decay;
+        
+        for (int iteration = 0; iteration < 8; iteration++)
+        {
+            double f = log(a + b * t) - motion.decay * t - log(epsilon);
+            double df = b / (a + b * t) - motion.decay;
+            t = fmax(0.0, t - f / df);
+        }
+        
+        motion.duration = t;
+    }
+    else
+    {
+        double root = naturalFrequency * sqrt(dampingRatio * dampingRatio - 1.0);
+        motion.rootA = -naturalFrequency * dampingRatio + root;
+        motion.rootB = -naturalFrequency * dampingRatio - root;
+        motion.a = (velocity - motion.rootB * x0) / (motion.rootA - motion.rootB);
+        motion.b = x0 - motion.a;
+        
+        double amplitude = fabs(motion.a) + fabs(motion.b);
+        motion.duration = (amplitude > epsilon) ? log(amplitude / epsilon) / -motion.rootA : 0.0;
+    }
+    
+    return motion;
+}
+
+static double PKRevealCoreSpringDisplacement(const PKRevealCoreMotion *motion, double time, double *velocity)
+{
+    if (motion->rootA != 0.0 || motion->rootB != 0.0)
+    {
+        double termA = motion->a * exp(motion->rootA * time);
+        double termB = motion->b * exp(motion->rootB * time);
+        *velocity = motion->rootA * termA + motion->rootB * termB;
+        
+        return termA + termB;
+    }
+    
+    double envelope = exp(-motion->decay * time);
+    
+    if (motion->frequency > 0.0)
+    {
+        double cosine = cos(motion->frequency * time);
+        double sine = sin(motion->frequency * time);
+        double oscillation = motion->a * cosine + motion->b * sine;
+        *velocity = envelope * (motion->frequency * (motion->b * cosine - motion->a * sine) - motion->decay * oscillation);
+        
+        return envelope * oscillation;
+    }
+    
+    *velocity = envelope * (motion->b - motion->decay * (motion->a + motion->b * time));
+    
+    return envelope * (motion->a + motion->b * time);
+}
+
+double PKRevealCoreMotionPosition(const PKRevealCoreMotion *motion, double time)
+{
+    if (time <= 0.0)
+    {
+        return motion->from;
+    }
+    else if (time >= motion->duration)
+    {
+        return motion->to;
+    }
+    
+    if (motion->curve == PKRevealCoreMotionCurveSpring)
+    {
+        double velocity;
+        return motion->to + PKRevealCoreSpringDisplacement(motion, time, &velocity);
+    }
+    
+    double s = time / motion->duration;
+    double s2 = s * s;
+    double s3 = s2 * s;
+    
+    return ((2.0 * s3 - 3.0 * s2 + 1.0) * motion->from +
+            (s3 - 2.0 * s2 + s) * motion->velocity * motion->duration +
+            (-2.0 * s3 + 3.0 * s2) * motion->to);
+}
+
+double PKRevealCoreMotionVelocity(const PKRevealCoreMotion *motion, double time)
+{
+    if (time < 0.0 || time >= motion->duration)
+    {
+        return (time < 0.0) ? motion->velocity : 0.0;
+    }
+    
+    if (motion->curve == PKRevealCoreMotionCurveSpring)
+    {
+        double velocity;
+        PKRevealCoreSpringDisplacement(motion, time, &velocity);
+        
+        return velocity;
+    }
+    
+    double s = time / motion->duration;
+    double s2 = s * s;
+    
+    return ((6.0 * s2 - 6.0 * s) * (motion->from - motion->to) / motion->duration +
+            (3.0 * s2 - 4.0 * s + 1.0) * motion->velocity);
+}
@@ -0,0 +1,454 @@
+/*
+    PKRevealController > PKRevealCore.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * The reveal core contains the gesture and positioning math of the PKRevealController.
+ * It is plain C99 without any UIKit or QuartzCore dependency and operates on value types
+ * only, which allows it to be built, tested and profiled on any platform.
+ */
+
+#ifndef PKRevealCore_h
+#define PKRevealCore_h
+
+#include "PKRevealCoreCurve.h"
+#include "PKRevealCoreDampening.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Mirrors PKRevealControllerState. The numeric values must stay in sync.
+typedef enum
+{
+    PKRevealCoreStateLeftPresentation   = 1,
+    PKRevealCoreStateLeft               = 2,
+    PKRevealCoreStateFront              = 3,
+    PKRevealCoreStateRight              = 4,
+    PKRevealCoreStateRightPresentation  = 5
+} PKRevealCoreState;
+
+#define PKRevealCoreStateCount 5
+
+/// The minimum and maximum reveal width of a rear view.
+typedef struct
+{
+    double minimum;
+    double maximum;
+} PKRevealCoreWidthRange;
+
+/// Everything the gesture math derives from the bounds and the width ranges.
+typedef struct
+{
+    double midX;
+    double anchors[PKRevealCoreStateCount];
+    PKRevealCoreWidthRange leftRange;
+    PKRevealCoreWidthRange rightRange;
+    double leftSnapThreshold;
+    double rightSnapThreshold;
+    bool hasLeft;
+    bool hasRight;
+    PKRevealCoreDampening dampening;
+} PKRevealCoreGeometry;
+
+static inline PKRevealCoreWidthRange PKRevealCoreWidthRangeMake(double minimum, double maximum)
+{
+    PKRevealCoreWidthRange range = { minimum, maximum };
+    return range;
+}
+
+/**
+ Builds the geometry table for a container whose horizontal center is located at midX.
+ 
+ @param midX The x coordinate of the front view's position when the front view is focused.
+ @param leftRange The reveal width range of the left view.
+ @param rightRange The reveal width range of the right view.
+ @param hasLeft Whether a left view is present.
+ @param hasRight Whether a right view is present.
+ @param dampening The overdraw dampening, copied into the geometry. NULL selects the arctangent curve.
+ */
+PKRevealCoreGeometry PKRevealCoreGeometryMake(double midX,
+                                              PKRevealCoreWidthRange leftRange,
+                                              PKRevealCoreWidthRange rightRange,
+                                              bool hasLeft,
+                                              bool hasRight,
+                                              const PKRevealCoreDampening *dampening);
+
+/// @return The front view's x position for the given state.
+static inline double PKRevealCoreGeometryAnchor(const PKRevealCoreGeometry *geometry, PKRevealCoreState state)
+{
+    return geometry->anchors[state - PKRevealCoreStateLeftPresentation];
+}
+
+/**
+ Dampens a distance from the center once it exceeds the minimum width of the given range, such that it approaches the curve's limit.
+ 
+ @param dampening The dampening curve.
+ @param realValue The signed, undampened distance from the center.
+ @param range The width range to dampen within.
+ */
+double PKRevealCoreDampenedValue(const PKRevealCoreDampening *dampening, double realValue, PKRevealCoreWidthRange range);
+
+/**
+ The exact inverse of PKRevealCoreDampenedValue.
+ 
+ @param dampening The dampening curve.
+ @param dampenedValue The signed, dampened distance from the center.
+ @param range The width range that was dampened within.
+ */
+double PKRevealCoreUndampenedValue(const PKRevealCoreDampening *dampening, double dampenedValue, PKRevealCoreWidthRange range);
+
+/**
+ Resolves the front view position for a pan gesture.
+ 
+ @param geometry The current geometry.
+ @param proposedX The undampened position derived from the initial position and the translation.
+ @param currentX The front view's current position. Returned if the proposed position would exceed the dampening limits.
+ */
+double PKRevealCoreFrontViewPositionForPan(const PKRevealCoreGeometry *geometry, double proposedX, double currentX);
+
+/**
+ @return The undampened position that PKRevealCoreFrontViewPositionForPan maps to the front view's position x.
+ A pan beginning at x starts from it, such that a pan resumed during overdraw does not make the front view jump.
+ */
+double PKRevealCorePanOrigin(const PKRevealCoreGeometry *geometry, double x);
+
+/**
+ @return The undampened front view position for a pan gesture's translation.
+ 
+ @param initialPosition The front view's position when the pan began.
+ @param initialTranslation The translation reported when the pan began.
+ @param translation The current translation.
+ */
+static inline double PKRevealCoreProposedPanPosition(double initialPosition, double initialTranslation, double translation)
+{
+    return initialPosition + (initialTranslation + translation);
+}
+
+/**
+ @return Whether a pan touching down at x may move the front view when pans are limited to its edges. While the
+ front view is focused, only touches within leftInset of its left edge or rightInset of its right edge are accepted,
+ and only if the rear view on that side exists. Once a rear view is revealed, touches anywhere are accepted.
+ 
+ @param geometry The current geometry.
+ @param state The current state.
+ @param x The horizontal touch location in the front view's coordinates.
+ @param width The width of the front view.
+ @param leftInset The width of the region along the left edge that reveals the left view.
+ @param rightInset The width of the region along the right edge that reveals the right view.
+ */
+bool PKRevealCoreIsEdgePanTouch(const PKRevealCoreGeometry *geometry,
+                                PKRevealCoreState state,
+                                double x,
+                                double width,
+                                double leftInset,
+                                double rightInset);
+
+/// @return The state corresponding to the front view's x position.
+PKRevealCoreState PKRevealCoreStateForPosition(const PKRevealCoreGeometry *geometry, double x);
+
+/// The largest number of waypoints on a route between two states.
+#define PKRevealCoreRouteCapacity 2
+
+/// The states the front view passes when transitioning between two states, ending with the destination.
+typedef struct
+{
+    uint8_t count;
+    PKRevealCoreState waypoints[PKRevealCoreRouteCapacity];
+} PKRevealCoreRoute;
+
+/// The front view positions along a route.
+typedef struct
+{
+    size_t count;
+    double positions[PKRevealCoreRouteCapacity];
+} PKRevealCoreWaypoints;
+
+/**
+ The route of every transition, indexed by source and destination state. Transitions between opposite sides
+ pass the front view on their way, all others are direct. Adding a state only takes a new row and column.
+ */
+extern const PKRevealCoreRoute PKRevealCoreRoutes[PKRevealCoreStateCount][PKRevealCoreStateCount];
+
+/// @return The route from one state to another.
+static inline const PKRevealCoreRoute *PKRevealCoreRouteForTransition(PKRevealCoreState fromState, PKRevealCoreState toState)
+{
+    return &PKRevealCoreRoutes[fromState - PKRevealCoreStateLeftPresentation][toState - PKRevealCoreStateLeftPresentation];
+}
+
+/// @return The front view positions along the route from one state to another. Never allocates.
+PKRevealCoreWaypoints PKRevealCorePlanRoute(const PKRevealCoreGeometry *geometry,
+                                            PKRevealCoreState fromState,
+                                            PKRevealCoreState toState);
+
+/// @return The state to snap to when the front view is released at position x without a quick swipe.
+PKRevealCoreState PKRevealCoreSnapState(const PKRevealCoreGeometry *geometry, double x);
+
+/// @return true if the velocity qualifies as a quick swipe towards the left.
+static inline bool PKRevealCoreShouldMoveLeftwards(double velocity, double quickSwipeVelocity)
+{
+    return (velocity < 0 && -velocity > quickSwipeVelocity);
+}
+
+/// @return true if the velocity qualifies as a quick swipe towards the right.
+static inline bool PKRevealCoreShouldMoveRightwards(double velocity, double quickSwipeVelocity)
+{
+    return (velocity > 0 && velocity > quickSwipeVelocity);
+}
+
+/**
+ Decides which state the front view settles in after a pan gesture ended.
+ 
+ @param geometry The current geometry.
+ @param state The state at the time of release.
+ @param x The front view's position at the time of release.
+ @param velocity The horizontal release velocity in points per second.
+ @param quickSwipeVelocity The minimum velocity required for a swipe to trigger a state change.
+ */
+PKRevealCoreState PKRevealCoreStateForPanRelease(const PKRevealCoreGeometry *geometry,
+                                                 PKRevealCoreState state,
+                                                 double x,
+                                                 double velocity,
+                                                 double quickSwipeVelocity);
+
+#pragma mark - Reveal Effects
+
+/// How the front and rear views are transformed as the front view moves.
+typedef struct
+{
+    /// The fraction of the front view's velocity the rear views move at. 0 keeps them in place.
+    double parallaxRatio;
+    /// The scale of the front view once a rear view is revealed to its minimum width. 1 keeps its size.
+    double frontScale;
+} PKRevealCoreRevealEffect;
+
+static inline PKRevealCoreRevealEffect PKRevealCoreRevealEffectMake(double parallaxRatio, double frontScale)
+{
+    PKRevealCoreRevealEffect effect = { parallaxRatio, frontScale };
+    return effect;
+}
+
+/// How far each rear view is revealed, from 0 while it is hidden to 1 once it is revealed to its minimum width.
+typedef struct
+{
+    double left;
+    double right;
+} PKRevealCoreRevealProgress;
+
+/// @return The reveal progress of both rear views for the front view's position x. Overdraw is reported as 1.
+PKRevealCoreRevealProgress PKRevealCoreRevealProgressForPosition(const PKRevealCoreGeometry *geometry, double x);
+
+/// The transforms for a front view position. Rear views are translated horizontally, the front view is scaled around its center.
+typedef struct
+{
+    double frontScale;
+    double leftTranslation;
+    double rightTranslation;
+} PKRevealCoreRevealTransform;
+
+/**
+ @return The transforms for the front view's position x. A rear view is at its resting position once it is
+ revealed to its minimum width, including during overdraw, and is offset by the parallax ratio times the
+ remaining distance otherwise.
+ */
+PKRevealCoreRevealTransform PKRevealCoreRevealTransformForPosition(const PKRevealCoreGeometry *geometry,
+                                                                   PKRevealCoreRevealEffect effect,
+                                                                   double x);
+
+/// The largest number of keyframes PKRevealCoreRevealKeyframesForRoute returns.
+#define PKRevealCoreRevealKeyframeCapacity (1 + 4 * PKRevealCoreRouteCapacity)
+
+/// Front view positions along a route at which the reveal transforms stop changing linearly, and their key times.
+typedef struct
+{
+    size_t count;
+    double positions[PKRevealCoreRevealKeyframeCapacity];
+    double keyTimes[PKRevealCoreRevealKeyframeCapacity];
+} PKRevealCoreRevealKeyframes;
+
+/**
+ Splits a route at the center and the minimum width anchors, between which the reveal transforms change
+ linearly. Key times are proportional to the distance travelled, like the key times of the front view's
+ keyframe animation, such that keyframe animations of the transforms stay in step with it.
+ 
+ @param geometry The current geometry.
+ @param x The front view's position at the start of the route.
+ @param waypoints The route.
+ */
+PKRevealCoreRevealKeyframes PKRevealCoreRevealKeyframesForRoute(const PKRevealCoreGeometry *geometry,
+                                                                double x,
+                                                                const PKRevealCoreWaypoints *waypoints);
+
+/**
+ @return The velocity of the front view in points per second during a keyframe transition along a route, whose
+ key times are proportional to the distance travelled. Zero outside of the transition.
+ 
+ @param x The front view's position at the start of the route.
+ @param waypoints The route.
+ @param curve The timing curve the transition follows across all segments.
+ @param duration The duration of the transition.
+ @param time The time elapsed since the transition began.
+ */
+double PKRevealCoreRouteVelocity(double x,
+                                 const PKRevealCoreWaypoints *waypoints,
+                                 const PKRevealCoreCurve *curve,
+                                 double duration,
+                                 double time);
+
+#pragma mark - Momentum Projection
+
+/// The deceleration rate of a scroll view with normal deceleration, per millisecond.
+#define PKRevealCoreDecelerationRateNormal 0.998
+
+/// The deceleration rate of a scroll view with fast deceleration, per millisecond.
+#define PKRevealCoreDecelerationRateFast 0.99
+
+/**
+ Predicts where a released view would come to rest if it kept decelerating at the given rate.
+ 
+ @param x The position at the time of release.
+ @param velocity The release velocity in points per second.
+ @param decelerationRate The factor the velocity is multiplied with every millisecond, in the range (0, 1).
+ */
+double PKRevealCoreProjectedPosition(double x, double velocity, double decelerationRate);
+
+/**
+ Decides which state the front view settles in after a pan gesture ended by projecting its momentum and
+ picking the anchor closest to the projected resting position.
+ 
+ @param geometry The current geometry.
+ @param x The front view's position at the time of release.
+ @param velocity The horizontal release velocity in points per second.
+ @param decelerationRate The factor the velocity is multiplied with every millisecond, in the range (0, 1).
+ @param includesPresentationModes Whether the presentation mode anchors may be picked.
+ */
+PKRevealCoreState PKRevealCoreStateForProjectedRelease(const PKRevealCoreGeometry *geometry,
+                                                       double x,
+                                                       double velocity,
+                                                       double decelerationRate,
+                                                       bool includesPresentationModes);
+
+#pragma mark - Motion
+
+/// The parameters of a damped harmonic oscillator.
+typedef struct
+{
+    double mass;
+    double stiffness;
+    double damping;
+} PKRevealCoreSpring;
+
+/// The smallest mass and stiffness a spring is solved with. Smaller values, including 0 and NaN, are raised to them.
+#define PKRevealCoreSpringMinimumMass 0.01
+#define PKRevealCoreSpringMinimumStiffness 1.0
+
+/// The smallest damping ratio a spring is solved with, such that an undamped spring still comes to rest.
+#define PKRevealCoreSpringMinimumDampingRatio 0.05
+
+static inline PKRevealCoreSpring PKRevealCoreSpringMake(double mass, double stiffness, double damping)
+{
+    PKRevealCoreSpring spring = { mass, stiffness, damping };
+    return spring;
+}
+
+/// @return The spring with mass, stiffness and damping raised to the minimums above.
+PKRevealCoreSpring PKRevealCoreSpringClamped(PKRevealCoreSpring spring);
+
+typedef enum
+{
+    /// A cubic Hermite curve of fixed duration.
+    PKRevealCoreMotionCurveHermite,
+    /// The analytic solution of a damped spring. The duration is its settling time.
+    PKRevealCoreMotionCurveSpring
+} PKRevealCoreMotionCurve;
+
+/**
+ A retargetable one dimensional motion from a start position to a target position. The start velocity
+ is carried into the motion and decays to zero at the target, which allows a release velocity or the
+ velocity of an interrupted motion to be handed off without a visible discontinuity.
+ */
+typedef struct
+{
+    PKRevealCoreMotionCurve curve;
+    double from;
+    double to;
+    double velocity;
+    double duration;
+    
+    /// Spring coefficients, precomputed such that evaluating a frame does not depend on the elapsed time.
+    double decay;
+    double frequency;
+    double a;
+    double b;
+    double rootA;
+    double rootB;
+} PKRevealCoreMotion;
+
+/**
+ Creates a Hermite motion. A start velocity towards the target is clamped such that the motion never overshoots it.
+ 
+ @param from The start position.
+ @param to The target position.
+ @param velocity The start velocity in points per second.
+ @param duration The duration in seconds.
+ */
+PKRevealCoreMotion PKRevealCoreMotionMake(double from, double to, double velocity, double duration);
+
+/**
+ Creates a spring motion. Its duration is the time after which the oscillation stays within the resting
+ distance of the target, and therefore grows with the distance and the start velocity.
+ 
+ @param from The start position.
+ @param to The target position.
+ @param velocity The start velocity in points per second.
+ @param spring The spring parameters. Clamped with PKRevealCoreSpringClamped.
+ @param restingDistance The distance to the target below which the motion is considered finished.
+ */
+PKRevealCoreMotion PKRevealCoreMotionMakeSpring(double from,
+                                                double to,
+                                                double velocity,
+                                                PKRevealCoreSpring spring,
+                                                double restingDistance);
+
+/// @return The position of the motion at the given time. Times beyond the duration return the target.
+double PKRevealCoreMotionPosition(const PKRevealCoreMotion *motion, double time);
+
+/// @return The velocity of the motion at the given time in points per second.
+double PKRevealCoreMotionVelocity(const PKRevealCoreMotion *motion, double time);
+
+/// @return true once the motion has reached its target.
+static inline bool PKRevealCoreMotionIsFinished(const PKRevealCoreMotion *motion, double time)
+{
+    return (time >= motion->duration);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
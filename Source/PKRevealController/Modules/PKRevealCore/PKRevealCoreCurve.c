@@ -0,0 +1,190 @@
+/*
+    PKRevealController > PKRevealCoreCurve.c
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PKRevealCoreCurve.h"
+#include <math.h>
+
+/// Newton iterations stop once the curve's time is this close to the requested time.
+#define PKRevealCoreCurveEpsilon 1e-9
+
+#pragma mark - Bezier
+
+static inline double PKRevealCoreBezier(double p1, double p2, double t)
+{
+    double u = 1.0 - t;
+    return 3.0 * u * u * t * p1 + 3.0 * u * t * t * p2 + t * t * t;
+}
+
+static inline double PKRevealCoreBezierDerivative(double p1, double p2, double t)
+{
+    double u = 1.0 - t;
+    return 3.0 * u * u * p1 + 6.0 * u * t * (p2 - p1) + 3.0 * t * t * (1.0 - p2);
+}
+
+/*
+ * Solves x(t) = time for the bezier parameter t. Newton's method converges in a few steps for typical
+ * curves but may stall where the curve is flat, in which case bisection finishes the job. With both
+ * control point times in [0, 1], x(t) is monotonic and the bisection always converges.
+ */
+static double PKRevealCoreCurveParameter(const PKRevealCoreCurve *curve, double time)
+{
+    double t = time;
+    
+    for (int iteration = 0; iteration < 10; iteration++)
+    {
+        double error = PKRevealCoreBezier(curve->x1, curve->x2, t) - time;
+        
+        if (fabs(error) < PKRevealCoreCurveEpsilon)
+        {
+            return t;
+        }
+        
+        double derivative = PKRevealCoreBezierDerivative(curve->x1, curve->x2, t);
+        
+        if (fabs(derivative) < 1e-6)
+        {
+            break;
+        }
+        
+        t -= error / derivative;
+    }
+    
+    double lower = 0.0;
+    double upper = 1.0;
+    t = time;
+    
+    while (upper - lower > PKRevealCoreCurveEpsilon)
+    {
+        if (PKRevealCoreBezier(curve->x1, curve->x2, t) < time)
+        {
+            lower = t;
+        }
+        else
+        {
+            upper = t;
+        }
+        
+        t = 0.5 * (lower + upper);
+    }
+    
+    return t;
+}
+
+#pragma mark - Curve
+
+PKRevealCoreCurve PKRevealCoreCurveMake(double x1, double y1, double x2, double y2)
+{
+    PKRevealCoreCurve curve;
+    
+    curve.x1 = fmax(0.0, fmin(x1, 1.0));
+    curve.y1 = y1;
+    curve.x2 = fmax(0.0, fmin(x2, 1.0));
+    curve.y2 = y2;
+    
+    for (size_t index = 0; index <= PKRevealCoreCurveSampleCount; index++)
+    {
+        double time = (double)index / PKRevealCoreCurveSampleCount;
+        curve.samples[index] = PKRevealCoreBezier(curve.y1, curve.y2, PKRevealCoreCurveParameter(&curve, time));
+    }
+    
+    curve.samples[0] = 0.0;
+    curve.samples[PKRevealCoreCurveSampleCount] = 1.0;
+    
+    return curve;
+}
+
+double PKRevealCoreCurveTime(const PKRevealCoreCurve *curve, double value)
+{
+    if (!(value > 0.0))
+    {
+        return 0.0;
+    }
+    
+    if (value >= 1.0)
+    {
+        return 1.0;
+    }
+    
+    // Finds the first sample that is not below the value. Curves that overshoot are searched up to
+    // their first crossing only, which is where a monotonic search of the samples ends up.
+    size_t lower = 0;
+    size_t upper = PKRevealCoreCurveSampleCount;
+    
+    while (upper - lower > 1)
+    {
+        size_t middle = (lower + upper) / 2;
+        
+        if (curve->samples[middle] < value)
+        {
+            lower = middle;
+        }
+        else
+        {
+            upper = middle;
+        }
+    }
+    
+    double span = curve->samples[upper] - curve->samples[lower];
+    double fraction = (span > 0.0) ? ((value - curve->samples[lower]) / span) : 0.0;
+    
+    return ((double)lower + fraction) / PKRevealCoreCurveSampleCount;
+}
+
+/*
+ * The part of a cubic bezier between two parameters is itself a cubic bezier. Its inner control points lie
+ * on the tangents at both ends, a third of the parameter span away from them. Normalizing both axes to
+ * [0, 1] is an affine map and therefore keeps it a bezier, which makes the segment's curve exact.
+ */
+void PKRevealCoreCurveSegment(const PKRevealCoreCurve *curve, double startTime, double endTime, double controlPoints[4])
+{
+    double start = PKRevealCoreCurveParameter(curve, fmax(0.0, fmin(startTime, 1.0)));
+    double end = PKRevealCoreCurveParameter(curve, fmax(0.0, fmin(endTime, 1.0)));
+    double span = (end - start) / 3.0;
+    
+    double x0 = PKRevealCoreBezier(curve->x1, curve->x2, start);
+    double x3 = PKRevealCoreBezier(curve->x1, curve->x2, end);
+    double y0 = PKRevealCoreBezier(curve->y1, curve->y2, start);
+    double y3 = PKRevealCoreBezier(curve->y1, curve->y2, end);
+    
+    if (x3 - x0 < PKRevealCoreCurveEpsilon || fabs(y3 - y0) < PKRevealCoreCurveEpsilon)
+    {
+        controlPoints[0] = 1.0 / 3.0;
+        controlPoints[1] = 1.0 / 3.0;
+        controlPoints[2] = 2.0 / 3.0;
+        controlPoints[3] = 2.0 / 3.0;
+        return;
+    }
+    
+    double x1 = x0 + span * PKRevealCoreBezierDerivative(curve->x1, curve->x2, start);
+    double y1 = y0 + span * PKRevealCoreBezierDerivative(curve->y1, curve->y2, start);
+    double x2 = x3 - span * PKRevealCoreBezierDerivative(curve->x1, curve->x2, end);
+    double y2 = y3 - span * PKRevealCoreBezierDerivative(curve->y1, curve->y2, end);
+    
+    controlPoints[0] = fmax(0.0, fmin((x1 - x0) / (x3 - x0), 1.0));
+    controlPoints[1] = (y1 - y0) / (y3 - y0);
+    controlPoints[2] = fmax(0.0, fmin((x2 - x0) / (x3 - x0), 1.0));
+    controlPoints[3] = (y2 - y0) / (y3 - y0);
+}
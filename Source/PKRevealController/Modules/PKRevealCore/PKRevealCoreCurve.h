@@ -0,0 +1,128 @@
+/*
+    PKRevealController > PKRevealCoreCurve.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Timing curves map the elapsed fraction of an animation's duration to the fraction of its distance.
+ * A cubic-bezier curve is sampled once into a fixed-size lookup table, after which evaluating it on
+ * every frame is a table lookup and a linear interpolation, independent of the curve's shape.
+ */
+
+#ifndef PKRevealCoreCurve_h
+#define PKRevealCoreCurve_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The number of intervals the lookup table divides the time axis into.
+#define PKRevealCoreCurveSampleCount 128
+
+/// A cubic-bezier timing curve from (0, 0) to (1, 1), as defined by CAMediaTimingFunction.
+typedef struct
+{
+    double x1;
+    double y1;
+    double x2;
+    double y2;
+    
+    /// The curve's value at time i / PKRevealCoreCurveSampleCount.
+    double samples[PKRevealCoreCurveSampleCount + 1];
+} PKRevealCoreCurve;
+
+/// The control points of the curves of UIViewAnimationCurve and kCAMediaTimingFunction.
+#define PKRevealCoreCurveControlPointsLinear        0.0, 0.0, 1.0, 1.0
+#define PKRevealCoreCurveControlPointsEaseIn        0.42, 0.0, 1.0, 1.0
+#define PKRevealCoreCurveControlPointsEaseOut       0.0, 0.0, 0.58, 1.0
+#define PKRevealCoreCurveControlPointsEaseInEaseOut 0.42, 0.0, 0.58, 1.0
+
+/**
+ Samples a cubic-bezier timing curve into its lookup table.
+ 
+ @param x1 The time of the first control point, clamped to [0, 1].
+ @param y1 The value of the first control point.
+ @param x2 The time of the second control point, clamped to [0, 1].
+ @param y2 The value of the second control point.
+ */
+PKRevealCoreCurve PKRevealCoreCurveMake(double x1, double y1, double x2, double y2);
+
+/// @return The curve's value at the given time. Times are clamped to [0, 1].
+static inline double PKRevealCoreCurveValue(const PKRevealCoreCurve *curve, double time)
+{
+    if (!(time > 0.0))
+    {
+        return 0.0;
+    }
+    
+    if (time >= 1.0)
+    {
+        return 1.0;
+    }
+    
+    double position = time * PKRevealCoreCurveSampleCount;
+    size_t index = (size_t)position;
+    double fraction = position - (double)index;
+    
+    return curve->samples[index] + (curve->samples[index + 1] - curve->samples[index]) * fraction;
+}
+
+/// @return The curve's slope at the given time, derived from the lookup table. Times are clamped to [0, 1].
+static inline double PKRevealCoreCurveSlope(const PKRevealCoreCurve *curve, double time)
+{
+    double position = ((time > 0.0) ? ((time < 1.0) ? time : 1.0) : 0.0) * PKRevealCoreCurveSampleCount;
+    size_t index = (size_t)position;
+    
+    if (index >= PKRevealCoreCurveSampleCount)
+    {
+        index = PKRevealCoreCurveSampleCount - 1;
+    }
+    
+    return (curve->samples[index + 1] - curve->samples[index]) * PKRevealCoreCurveSampleCount;
+}
+
+/**
+ @return The earliest time at which the curve reaches the given value, found by a binary search of the
+ lookup table. Values are clamped to [0, 1].
+ */
+double PKRevealCoreCurveTime(const PKRevealCoreCurve *curve, double value);
+
+/**
+ Computes the curve of the part of a curve between two times, such that a transition split into
+ consecutive segments follows the original curve exactly.
+ 
+ @param curve The curve to split.
+ @param startTime The start of the segment.
+ @param endTime The end of the segment.
+ @param controlPoints Receives x1, y1, x2 and y2 of the segment's curve.
+ */
+void PKRevealCoreCurveSegment(const PKRevealCoreCurve *curve, double startTime, double endTime, double controlPoints[4]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
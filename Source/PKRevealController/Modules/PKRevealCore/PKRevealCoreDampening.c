@@ -0,0 +1,242 @@
+/*
+    PKRevealController > PKRevealCoreDampening.c
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PKRevealCoreDampening.h"
+#include <math.h>
+
+/// The slope of the rubber band at zero overdraw, as used by scroll views.
+#define PKRevealCoreDampeningRubberBandCoefficient 0.55
+
+/// The fraction of the limit the samples extend to if the curve never reaches the maximum width.
+#define PKRevealCoreDampeningReach 0.99
+
+#pragma mark - Curves
+
+void PKRevealCoreDampeningEvaluate(PKRevealCoreDampeningCurve curve,
+                                   double limit,
+                                   const double *overdraws,
+                                   double *results,
+                                   size_t count)
+{
+    switch (curve)
+    {
+        case PKRevealCoreDampeningCurveRubberBand:
+        {
+            double scale = PKRevealCoreDampeningRubberBandCoefficient / limit;
+            
+            for (size_t index = 0; index < count; index++)
+            {
+                results[index] = limit - limit / (overdraws[index] * scale + 1.0);
+            }
+        }
+            break;
+            
+        case PKRevealCoreDampeningCurveExponential:
+        {
+            double scale = -1.0 / limit;
+            
+            for (size_t index = 0; index < count; index++)
+            {
+                results[index] = limit - limit * exp(overdraws[index] * scale);
+            }
+        }
+            break;
+            
+        case PKRevealCoreDampeningCurveArctangent:
+        case PKRevealCoreDampeningCurveTable:
+        default:
+        {
+            double scale = 2.0 * limit / M_PI;
+            
+            for (size_t index = 0; index < count; index++)
+            {
+                results[index] = scale * atan(overdraws[index]);
+            }
+        }
+            break;
+    }
+}
+
+static double PKRevealCoreDampeningCurveInverse(PKRevealCoreDampeningCurve curve, double limit, double value)
+{
+    value = fmin(value, limit * PKRevealCoreDampeningReach);
+    
+    switch (curve)
+    {
+        case PKRevealCoreDampeningCurveRubberBand:
+            return (limit / PKRevealCoreDampeningRubberBandCoefficient) * (value / (limit - value));
+            
+        case PKRevealCoreDampeningCurveExponential:
+            return -limit * log(1.0 - value / limit);
+            
+        case PKRevealCoreDampeningCurveArctangent:
+        case PKRevealCoreDampeningCurveTable:
+        default:
+            return tan(value * M_PI / (2.0 * limit));
+    }
+}
+
+#pragma mark - Tables
+
+PKRevealCoreDampening PKRevealCoreDampeningMake(PKRevealCoreDampeningCurve curve, double limit)
+{
+    PKRevealCoreDampening dampening;
+    double overdraws[PKRevealCoreDampeningSampleCount + 1];
+    
+    dampening.curve = (curve == PKRevealCoreDampeningCurveTable) ? PKRevealCoreDampeningCurveArctangent : curve;
+    dampening.limit = (limit > 0.0) ? limit : PKRevealCoreDampeningDefaultLimit;
+    dampening.extent = PKRevealCoreDampeningCurveInverse(dampening.curve, dampening.limit, 1.0);
+    
+    for (size_t index = 0; index <= PKRevealCoreDampeningSampleCount; index++)
+    {
+        overdraws[index] = dampening.extent * (double)index / PKRevealCoreDampeningSampleCount;
+    }
+    
+    PKRevealCoreDampeningEvaluate(dampening.curve, dampening.limit, overdraws, dampening.samples, PKRevealCoreDampeningSampleCount + 1);
+    
+    return dampening;
+}
+
+bool PKRevealCoreDampeningIsValidTable(const double *values, size_t count, double extent)
+{
+    if (!values || count < 2 || !(extent > 0.0) || !isfinite(extent))
+    {
+        return false;
+    }
+    
+    for (size_t index = 0; index < count; index++)
+    {
+        // The inverse binary-searches the samples, which requires them to be sorted.
+        if (!isfinite(values[index]) || (index > 0 && values[index] < values[index - 1]))
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+PKRevealCoreDampening PKRevealCoreDampeningMakeTable(const double *values, size_t count, double extent)
+{
+    if (!PKRevealCoreDampeningIsValidTable(values, count, extent))
+    {
+        return PKRevealCoreDampeningMake(PKRevealCoreDampeningCurveArctangent, PKRevealCoreDampeningDefaultLimit);
+    }
+    
+    PKRevealCoreDampening dampening;
+    
+    dampening.curve = PKRevealCoreDampeningCurveTable;
+    dampening.limit = values[count - 1];
+    dampening.extent = extent;
+    
+    for (size_t index = 0; index <= PKRevealCoreDampeningSampleCount; index++)
+    {
+        double position = (double)index * (double)(count - 1) / PKRevealCoreDampeningSampleCount;
+        size_t lower = (size_t)position;
+        
+        if (lower >= count - 1)
+        {
+            dampening.samples[index] = values[count - 1];
+        }
+        else
+        {
+            double fraction = position - (double)lower;
+            dampening.samples[index] = values[lower] + (values[lower + 1] - values[lower]) * fraction;
+        }
+    }
+    
+    return dampening;
+}
+
+#pragma mark - Evaluation
+
+double PKRevealCoreDampeningValue(const PKRevealCoreDampening *dampening, double overdraw)
+{
+    if (!(overdraw > 0.0))
+    {
+        return 0.0;
+    }
+    
+    if (overdraw >= dampening->extent)
+    {
+        if (dampening->curve == PKRevealCoreDampeningCurveTable)
+        {
+            return dampening->samples[PKRevealCoreDampeningSampleCount];
+        }
+        
+        double value;
+        PKRevealCoreDampeningEvaluate(dampening->curve, dampening->limit, &overdraw, &value, 1);
+        
+        return value;
+    }
+    
+    double position = overdraw * PKRevealCoreDampeningSampleCount / dampening->extent;
+    size_t index = (size_t)position;
+    double fraction = position - (double)index;
+    
+    return dampening->samples[index] + (dampening->samples[index + 1] - dampening->samples[index]) * fraction;
+}
+
+double PKRevealCoreDampeningInverse(const PKRevealCoreDampening *dampening, double value)
+{
+    if (!(value > 0.0))
+    {
+        return 0.0;
+    }
+    
+    if (value >= dampening->samples[PKRevealCoreDampeningSampleCount])
+    {
+        if (dampening->curve == PKRevealCoreDampeningCurveTable)
+        {
+            return dampening->extent;
+        }
+        
+        return fmax(dampening->extent, PKRevealCoreDampeningCurveInverse(dampening->curve, dampening->limit, value));
+    }
+    
+    // Finds the interval containing the value, whose linear interpolation is inverted exactly.
+    size_t lower = 0;
+    size_t upper = PKRevealCoreDampeningSampleCount;
+    
+    while (upper - lower > 1)
+    {
+        size_t middle = (lower + upper) / 2;
+        
+        if (dampening->samples[middle] <= value)
+        {
+            lower = middle;
+        }
+        else
+        {
+            upper = middle;
+        }
+    }
+    
+    double span = dampening->samples[upper] - dampening->samples[lower];
+    double fraction = (span > 0.0) ? ((value - dampening->samples[lower]) / span) : 0.0;
+    
+    return ((double)lower + fraction) * dampening->extent / PKRevealCoreDampeningSampleCount;
+}
@@ -0,0 +1,129 @@
+/*
+    PKRevealController > PKRevealCoreDampening.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Overdraw dampening maps how far the front view is dragged beyond a rear view's minimum width to how
+ * far it actually moves. Distances are measured in units of the width range, i.e. 1 is the distance
+ * between minimum and maximum width. Every curve is sampled into a lookup table once, when the geometry
+ * is built, so a pan event costs a table lookup. The table is inverted exactly, which maps a dampened
+ * position back to the finger position that produced it.
+ */
+
+#ifndef PKRevealCoreDampening_h
+#define PKRevealCoreDampening_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Mirrors PKRevealControllerOverdrawDampening. The numeric values must stay in sync.
+typedef enum
+{
+    /// (2 limit / pi) atan(x). The curve used before dampening became configurable.
+    PKRevealCoreDampeningCurveArctangent,
+    /// The rubber band of a scroll view, limit (1 - 1 / (0.55 x / limit + 1)).
+    PKRevealCoreDampeningCurveRubberBand,
+    /// limit (1 - e^(-x / limit)).
+    PKRevealCoreDampeningCurveExponential,
+    /// Linear interpolation of user-supplied samples.
+    PKRevealCoreDampeningCurveTable
+} PKRevealCoreDampeningCurve;
+
+/// The number of intervals a dampening curve is sampled at.
+#define PKRevealCoreDampeningSampleCount 256
+
+/// The limit of the built-in curves. A limit above 1 lets the front view reach the maximum width.
+#define PKRevealCoreDampeningDefaultLimit 1.25
+
+typedef struct
+{
+    PKRevealCoreDampeningCurve curve;
+    
+    /// The dampened distance the curve approaches as the overdraw grows.
+    double limit;
+    
+    /// The overdraw covered by the samples. Beyond it, built-in curves are evaluated directly and tables hold their last sample.
+    double extent;
+    
+    /// The dampened distance at overdraw i * extent / PKRevealCoreDampeningSampleCount.
+    double samples[PKRevealCoreDampeningSampleCount + 1];
+} PKRevealCoreDampening;
+
+/**
+ Samples one of the built-in curves. The samples extend to the overdraw at which the curve reaches the
+ maximum width, or nearly reaches its limit if the limit does not exceed 1.
+ 
+ @param curve The curve. PKRevealCoreDampeningCurveTable falls back to the arctangent.
+ @param limit The curve's limit, must be positive.
+ */
+PKRevealCoreDampening PKRevealCoreDampeningMake(PKRevealCoreDampeningCurve curve, double limit);
+
+/**
+ @return true if the values describe a curve that can be inverted: at least 2 finite values that never
+ decrease, and a finite, positive extent.
+ */
+bool PKRevealCoreDampeningIsValidTable(const double *values, size_t count, double extent);
+
+/**
+ Resamples a user-supplied curve. Tables rejected by PKRevealCoreDampeningIsValidTable fall back to the arctangent.
+ The values should start at 0.
+ 
+ @param values The dampened distances at evenly spaced overdraws from 0 to extent.
+ @param count The number of values, at least 2.
+ @param extent The overdraw of the last value, must be positive.
+ */
+PKRevealCoreDampening PKRevealCoreDampeningMakeTable(const double *values, size_t count, double extent);
+
+/**
+ Evaluates a built-in curve for many overdraws at once. The loops are free of data-dependent branches
+ and written for the compiler to vectorize. Used to sample the lookup tables.
+ 
+ @param curve The curve. PKRevealCoreDampeningCurveTable falls back to the arctangent.
+ @param limit The curve's limit.
+ @param overdraws The undampened distances.
+ @param results Receives the dampened distances. Must not overlap the overdraws.
+ @param count The number of distances.
+ */
+void PKRevealCoreDampeningEvaluate(PKRevealCoreDampeningCurve curve,
+                                   double limit,
+                                   const double *overdraws,
+                                   double *results,
+                                   size_t count);
+
+/// @return The dampened distance for a non-negative overdraw.
+double PKRevealCoreDampeningValue(const PKRevealCoreDampening *dampening, double overdraw);
+
+/// @return The overdraw that is dampened to the given non-negative distance. Distances at or beyond the curve's reach return the largest overdraw that is still finite.
+double PKRevealCoreDampeningInverse(const PKRevealCoreDampening *dampening, double value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
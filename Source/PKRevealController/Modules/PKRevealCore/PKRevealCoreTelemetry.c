@@ -0,0 +1,190 @@
+/*
+    PKRevealController > PKRevealCoreTelemetry.c
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PKRevealCoreTelemetry.h"
+#include <math.h>
+#include <string.h>
+
+/// Positions closer than this to the start position do not count as movement.
+#define PKRevealCoreTransitionMovementThreshold 0.01
+
+/// A frame counts as dropped once the interval to its predecessor exceeds the refresh interval by this factor.
+#define PKRevealCoreTransitionDeadlineTolerance 1.5
+
+#pragma mark - Histogram
+
+double PKRevealCoreHistogramBucketUpperBound(size_t bucket)
+{
+    if (bucket >= PKRevealCoreHistogramBucketCount - 1)
+    {
+        return INFINITY;
+    }
+    
+    return ldexp(1.0, (int)bucket);
+}
+
+static size_t PKRevealCoreHistogramBucket(double value)
+{
+    if (!(value >= 1.0))
+    {
+        return 0;
+    }
+    
+    int exponent;
+    frexp(value, &exponent);
+    
+    return (exponent < PKRevealCoreHistogramBucketCount) ? (size_t)exponent : (PKRevealCoreHistogramBucketCount - 1);
+}
+
+void PKRevealCoreHistogramAdd(PKRevealCoreHistogram *histogram, double value)
+{
+    value = fmax(value, 0.0);
+    
+    histogram->counts[PKRevealCoreHistogramBucket(value)]++;
+    histogram->count++;
+    histogram->sum += value;
+    histogram->maximum = fmax(histogram->maximum, value);
+}
+
+double PKRevealCoreHistogramPercentile(const PKRevealCoreHistogram *histogram, double percentile)
+{
+    if (histogram->count == 0)
+    {
+        return 0.0;
+    }
+    
+    double rank = ceil(fmin(fmax(percentile, 0.0), 1.0) * histogram->count);
+    uint32_t cumulativeCount = 0;
+    
+    for (size_t bucket = 0; bucket < PKRevealCoreHistogramBucketCount; bucket++)
+    {
+        cumulativeCount += histogram->counts[bucket];
+        
+        if (cumulativeCount >= rank && cumulativeCount > 0)
+        {
+            return PKRevealCoreHistogramBucketUpperBound(bucket);
+        }
+    }
+    
+    return INFINITY;
+}
+
+#pragma mark - Transition Tracking
+
+void PKRevealCoreTransitionTrackerBegin(PKRevealCoreTransitionTracker *tracker,
+                                        PKRevealCoreState fromState,
+                                        double startTime,
+                                        double startPosition,
+                                        bool isInteractive)
+{
+    memset(tracker, 0, sizeof(*tracker));
+    
+    tracker->fromState = fromState;
+    tracker->startTime = startTime;
+    tracker->startPosition = startPosition;
+    tracker->isInteractive = isInteractive;
+    tracker->isActive = true;
+}
+
+void PKRevealCoreTransitionTrackerFrame(PKRevealCoreTransitionTracker *tracker, double timestamp, double frameDuration, double position)
+{
+    if (!tracker->isActive)
+    {
+        return;
+    }
+    
+    if (tracker->frameCount > 0 && frameDuration > 0.0)
+    {
+        double interval = timestamp - tracker->previousFrameTime;
+        
+        if (interval > frameDuration * PKRevealCoreTransitionDeadlineTolerance)
+        {
+            tracker->droppedFrameCount += (uint32_t)(floor((interval / frameDuration) + 0.5) - 1.0);
+        }
+    }
+    
+    if (!tracker->hasMoved && fabs(position - tracker->startPosition) > PKRevealCoreTransitionMovementThreshold)
+    {
+        tracker->hasMoved = true;
+        tracker->firstFrameTime = timestamp;
+    }
+    
+    tracker->previousFrameTime = timestamp;
+    tracker->frameCount++;
+}
+
+bool PKRevealCoreTransitionTrackerEnd(PKRevealCoreTransitionTracker *tracker,
+                                      PKRevealCoreState toState,
+                                      double endTime,
+                                      PKRevealCoreTransitionSample *sample)
+{
+    if (!tracker->isActive)
+    {
+        return false;
+    }
+    
+    sample->fromState = tracker->fromState;
+    sample->toState = toState;
+    sample->isInteractive = tracker->isInteractive;
+    sample->latency = tracker->hasMoved ? fmax(tracker->firstFrameTime - tracker->startTime, 0.0) : -1.0;
+    sample->droppedFrameCount = tracker->droppedFrameCount;
+    sample->frameCount = tracker->frameCount;
+    sample->duration = fmax(endTime - tracker->startTime, 0.0);
+    
+    tracker->isActive = false;
+    
+    return true;
+}
+
+#pragma mark - Aggregation
+
+void PKRevealCoreTelemetryReset(PKRevealCoreTelemetry *telemetry)
+{
+    memset(telemetry, 0, sizeof(*telemetry));
+}
+
+void PKRevealCoreTelemetryRecord(PKRevealCoreTelemetry *telemetry, const PKRevealCoreTransitionSample *sample)
+{
+    if (sample->fromState < PKRevealCoreStateLeftPresentation || sample->fromState > PKRevealCoreStateRightPresentation ||
+        sample->toState < PKRevealCoreStateLeftPresentation || sample->toState > PKRevealCoreStateRightPresentation)
+    {
+        return;
+    }
+    
+    PKRevealCoreTransitionStatistics *statistics = (PKRevealCoreTransitionStatistics *)PKRevealCoreTelemetryStatistics(telemetry, sample->fromState, sample->toState);
+    
+    statistics->transitionCount++;
+    statistics->interactiveCount += sample->isInteractive ? 1 : 0;
+    statistics->jankyCount += (sample->droppedFrameCount > 0) ? 1 : 0;
+    
+    if (sample->latency >= 0.0)
+    {
+        PKRevealCoreHistogramAdd(&statistics->latency, sample->latency * 1000.0);
+    }
+    
+    PKRevealCoreHistogramAdd(&statistics->droppedFrames, sample->droppedFrameCount);
+    PKRevealCoreHistogramAdd(&statistics->duration, sample->duration * 1000.0);
+}
@@ -0,0 +1,175 @@
+/*
+    PKRevealController > PKRevealCoreTelemetry.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Per-transition performance telemetry. A transition tracker follows a single animated or interactive
+ * transition frame by frame and measures its latency, missed frame deadlines and duration. Completed
+ * transitions are aggregated into fixed-bucket histograms per pair of states.
+ */
+
+#ifndef PKRevealCoreTelemetry_h
+#define PKRevealCoreTelemetry_h
+
+#include "PKRevealCore.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Bucket 0 counts values below 1, bucket n counts values in [2^(n-1), 2^n). The last bucket has no upper bound.
+#define PKRevealCoreHistogramBucketCount 12
+
+typedef struct
+{
+    uint32_t counts[PKRevealCoreHistogramBucketCount];
+    uint32_t count;
+    double sum;
+    double maximum;
+} PKRevealCoreHistogram;
+
+/// @return The exclusive upper bound of the given bucket, or INFINITY for the last bucket.
+double PKRevealCoreHistogramBucketUpperBound(size_t bucket);
+
+/// Adds a non-negative value to the histogram.
+void PKRevealCoreHistogramAdd(PKRevealCoreHistogram *histogram, double value);
+
+/**
+ @return The upper bound of the bucket containing the given percentile, or 0 if the histogram is empty.
+ 
+ @param histogram The histogram.
+ @param percentile The percentile in the range [0, 1].
+ */
+double PKRevealCoreHistogramPercentile(const PKRevealCoreHistogram *histogram, double percentile);
+
+/// The measurements of a single completed transition.
+typedef struct
+{
+    PKRevealCoreState fromState;
+    PKRevealCoreState toState;
+    bool isInteractive;
+    /// The time from the start of the transition until the first frame that moved the front view, in seconds. Negative if the front view never moved.
+    double latency;
+    /// The number of frames that missed their deadline.
+    uint32_t droppedFrameCount;
+    /// The number of frames that were displayed.
+    uint32_t frameCount;
+    /// The time from the start to the end of the transition, in seconds.
+    double duration;
+} PKRevealCoreTransitionSample;
+
+/// Follows a single transition. Zero-initialize or call PKRevealCoreTransitionTrackerBegin before use.
+typedef struct
+{
+    PKRevealCoreState fromState;
+    double startTime;
+    double startPosition;
+    double firstFrameTime;
+    double previousFrameTime;
+    uint32_t droppedFrameCount;
+    uint32_t frameCount;
+    bool hasMoved;
+    bool isInteractive;
+    bool isActive;
+} PKRevealCoreTransitionTracker;
+
+/**
+ Starts tracking a transition. A transition that is still being tracked is discarded.
+ 
+ @param tracker The tracker.
+ @param fromState The state the transition starts in.
+ @param startTime The time the transition was triggered, e.g. the time a gesture was recognized.
+ @param startPosition The front view's position when the transition was triggered.
+ @param isInteractive Whether the transition is driven by a pan gesture.
+ */
+void PKRevealCoreTransitionTrackerBegin(PKRevealCoreTransitionTracker *tracker,
+                                        PKRevealCoreState fromState,
+                                        double startTime,
+                                        double startPosition,
+                                        bool isInteractive);
+
+/**
+ Records a displayed frame.
+ 
+ @param tracker The tracker.
+ @param timestamp The time the frame was displayed.
+ @param frameDuration The display's refresh interval. Frames displayed later than one interval after the previous frame count as dropped.
+ @param position The front view's displayed position.
+ */
+void PKRevealCoreTransitionTrackerFrame(PKRevealCoreTransitionTracker *tracker, double timestamp, double frameDuration, double position);
+
+/**
+ Stops tracking the current transition.
+ 
+ @param tracker The tracker.
+ @param toState The state the transition ended in.
+ @param endTime The time the transition ended.
+ @param sample Receives the measurements of the transition.
+ @return false if no transition was being tracked.
+ */
+bool PKRevealCoreTransitionTrackerEnd(PKRevealCoreTransitionTracker *tracker,
+                                      PKRevealCoreState toState,
+                                      double endTime,
+                                      PKRevealCoreTransitionSample *sample);
+
+/// Aggregated measurements of all transitions between one pair of states.
+typedef struct
+{
+    uint32_t transitionCount;
+    uint32_t interactiveCount;
+    /// The number of transitions that dropped at least one frame.
+    uint32_t jankyCount;
+    /// In milliseconds.
+    PKRevealCoreHistogram latency;
+    PKRevealCoreHistogram droppedFrames;
+    /// In milliseconds.
+    PKRevealCoreHistogram duration;
+} PKRevealCoreTransitionStatistics;
+
+typedef struct
+{
+    PKRevealCoreTransitionStatistics transitions[PKRevealCoreStateCount][PKRevealCoreStateCount];
+} PKRevealCoreTelemetry;
+
+/// Discards all recorded measurements.
+void PKRevealCoreTelemetryReset(PKRevealCoreTelemetry *telemetry);
+
+/// Adds a completed transition to the statistics of its pair of states.
+void PKRevealCoreTelemetryRecord(PKRevealCoreTelemetry *telemetry, const PKRevealCoreTransitionSample *sample);
+
+/// @return The statistics of all transitions from one state to another.
+static inline const PKRevealCoreTransitionStatistics *PKRevealCoreTelemetryStatistics(const PKRevealCoreTelemetry *telemetry,
+                                                                                     PKRevealCoreState fromState,
+                                                                                     PKRevealCoreState toState)
+{
+    return &telemetry->transitions[fromState - PKRevealCoreStateLeftPresentation][toState - PKRevealCoreStateLeftPresentation];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,452 @@
+/*
+    PKRevealController > PKRevealCoreTrace.c
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PKRevealCoreTrace.h"
+#include <math.h>
+#include <string.h>
+
+#define PKRevealCoreTraceMagic "PKGT"
+#define PKRevealCoreTraceRestingDistance 0.5
+#define PKRevealCoreReplayMaximumSettleDuration 60.0
+
+enum
+{
+    PKRevealCoreTraceFlagHasLeft                    = 1 << 0,
+    PKRevealCoreTraceFlagHasRight                   = 1 << 1,
+    PKRevealCoreTraceFlagProjectsMomentum           = 1 << 2,
+    PKRevealCoreTraceFlagIncludesPresentationModes  = 1 << 3,
+    PKRevealCoreTraceFlagUsesSpring                 = 1 << 4
+};
+
+#pragma mark - Encoding
+
+static void PKWriteUInt16(uint8_t *bytes, uint16_t value)
+{
+    bytes[0] = (uint8_t)(value & 0xFF);
+    bytes[1] = (uint8_t)(value >> 8);
+}
+
+static void PKWriteUInt32(uint8_t *bytes, uint32_t value)
+{
+    for (int index = 0; index < 4; index++)
+    {
+        bytes[index] = (uint8_t)((value >> (8 * index)) & 0xFF);
+    }
+}
+
+static void PKWriteUInt64(uint8_t *bytes, uint64_t value)
+{
+    for (int index = 0; index < 8; index++)
+    {
+        bytes[index] = (uint8_t)((value >> (8 * index)) & 0xFF);
+    }
+}
+
+static void PKWriteFloat(uint8_t *bytes, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    PKWriteUInt32(bytes, bits);
+}
+
+static void PKWriteDouble(uint8_t *bytes, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    PKWriteUInt64(bytes, bits);
+}
+
+static uint16_t PKReadUInt16(const uint8_t *bytes)
+{
+    return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+static uint32_t PKReadUInt32(const uint8_t *bytes)
+{
+    uint32_t value = 0;
+    
+    for (int index = 0; index < 4; index++)
+    {
+        value |= ((uint32_t)bytes[index]) << (8 * index);
+    }
+    
+    return value;
+}
+
+static uint64_t PKReadUInt64(const uint8_t *bytes)
+{
+    uint64_t value = 0;
+    
+    for (int index = 0; index < 8; index++)
+    {
+        value |= ((uint64_t)bytes[index]) << (8 * index);
+    }
+    
+    return value;
+}
+
+static float PKReadFloat(const uint8_t *bytes)
+{
+    uint32_t bits = PKReadUInt32(bytes);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static double PKReadDouble(const uint8_t *bytes)
+{
+    uint64_t bits = PKReadUInt64(bytes);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/*
+ * Header layout:
+ *
+ *   0  magic "PKGT"           4  version (u16)        6  flags (u16)
+ *   8  initial state (u32)   12  dampening curve (u32)
+ *  16  twelve doubles: midX, initial position, left minimum, left maximum, right minimum, right maximum,
+ *      quick swipe velocity, deceleration rate, animation duration, spring mass, stiffness and damping
+ *
+ * A table curve is followed by its extent, its limit and its samples, all doubles.
+ */
+size_t PKRevealCoreTraceHeaderLength(const PKRevealCoreTraceHeader *header)
+{
+    bool hasTable = (header->dampening.curve == PKRevealCoreDampeningCurveTable);
+    return PKRevealCoreTraceHeaderSize + (hasTable ? PKRevealCoreTraceDampeningTableSize : 0);
+}
+
+void PKRevealCoreTraceEncodeHeader(const PKRevealCoreTraceHeader *header, uint8_t *bytes)
+{
+    uint16_t flags = ((header->hasLeft ? PKRevealCoreTraceFlagHasLeft : 0) |
+                      (header->hasRight ? PKRevealCoreTraceFlagHasRight : 0) |
+                      (header->projectsMomentum ? PKRevealCoreTraceFlagProjectsMomentum : 0) |
+                      (header->includesPresentationModes ? PKRevealCoreTraceFlagIncludesPresentationModes : 0) |
+                      (header->usesSpring ? PKRevealCoreTraceFlagUsesSpring : 0));
+    
+    double values[12] = {
+        header->midX, header->initialPosition,
+        header->leftRange.minimum, header->leftRange.maximum,
+        header->rightRange.minimum, header->rightRange.maximum,
+        header->quickSwipeVelocity, header->decelerationRate, header->animationDuration,
+        header->spring.mass, header->spring.stiffness, header->spring.damping
+    };
+    
+    memcpy(bytes, PKRevealCoreTraceMagic, 4);
+    PKWriteUInt16(bytes + 4, PKRevealCoreTraceVersion);
+    PKWriteUInt16(bytes + 6, flags);
+    PKWriteUInt32(bytes + 8, (uint32_t)header->initialState);
+    PKWriteUInt32(bytes + 12, (uint32_t)header->dampening.curve);
+    
+    for (int index = 0; index < 12; index++)
+    {
+        PKWriteDouble(bytes + 16 + (8 * index), values[index]);
+    }
+    
+    if (header->dampening.curve == PKRevealCoreDampeningCurveTable)
+    {
+        uint8_t *table = bytes + PKRevealCoreTraceHeaderSize;
+        
+        PKWriteDouble(table, header->dampening.extent);
+        PKWriteDouble(table + 8, header->dampening.limit);
+        
+        for (int index = 0; index <= PKRevealCoreDampeningSampleCount; index++)
+        {
+            PKWriteDouble(table + 16 + (8 * index), header->dampening.samples[index]);
+        }
+    }
+}
+
+/*
+ * Sample layout:
+ *
+ *   0  time (double)   8  translation (float)   12  velocity (float)
+ *  16  kind (u8)      17  state (u8)            18  reserved
+ */
+void PKRevealCoreTraceEncodeSample(const PKRevealCoreTraceSample *sample, uint8_t *bytes)
+{
+    memset(bytes, 0, PKRevealCoreTraceSampleSize);
+    
+    PKWriteDouble(bytes, sample->time);
+    PKWriteFloat(bytes + 8, sample->translation);
+    PKWriteFloat(bytes + 12, sample->velocity);
+    bytes[16] = (uint8_t)sample->kind;
+    bytes[17] = (uint8_t)sample->state;
+}
+
+long PKRevealCoreTraceDecode(const uint8_t *bytes,
+                             size_t length,
+                             PKRevealCoreTraceHeader *header,
+                             PKRevealCoreTraceSample *samples,
+                             size_t capacity)
+{
+    if (length < PKRevealCoreTraceHeaderSize ||
+        memcmp(bytes, PKRevealCoreTraceMagic, 4) != 0 ||
+        PKReadUInt16(bytes + 4) != PKRevealCoreTraceVersion ||
+        PKReadUInt32(bytes + 12) > PKRevealCoreDampeningCurveTable)
+    {
+        return -1;
+    }
+    
+    PKRevealCoreDampeningCurve curve = (PKRevealCoreDampeningCurve)PKReadUInt32(bytes + 12);
+    size_t headerLength = PKRevealCoreTraceHeaderSize + ((curve == PKRevealCoreDampeningCurveTable) ? PKRevealCoreTraceDampeningTableSize : 0);
+    
+    if (length < headerLength || (length - headerLength) % PKRevealCoreTraceSampleSize != 0)
+    {
+        return -1;
+    }
+    
+    if (curve == PKRevealCoreDampeningCurveTable)
+    {
+        const uint8_t *table = bytes + PKRevealCoreTraceHeaderSize;
+        
+        header->dampening.curve = curve;
+        header->dampening.extent = PKReadDouble(table);
+        header->dampening.limit = PKReadDouble(table + 8);
+        
+        for (int index = 0; index <= PKRevealCoreDampeningSampleCount; index++)
+        {
+            header->dampening.samples[index] = PKReadDouble(table + 16 + (8 * index));
+        }
+        
+        if (!PKRevealCoreDampeningIsValidTable(header->dampening.samples, PKRevealCoreDampeningSampleCount + 1, header->dampening.extent))
+        {
+            return -1;
+        }
+    }
+    else
+    {
+        header->dampening = PKRevealCoreDampeningMake(curve, PKRevealCoreDampeningDefaultLimit);
+    }
+    
+    uint16_t flags = PKReadUInt16(bytes + 6);
+    double values[12];
+    
+    for (int index = 0; index < 12; index++)
+    {
+        values[index] = PKReadDouble(bytes + 16 + (8 * index));
+    }
+    
+    header->initialState = (PKRevealCoreState)PKReadUInt32(bytes + 8);
+    header->hasLeft = (flags & PKRevealCoreTraceFlagHasLeft) != 0;
+    header->hasRight = (flags & PKRevealCoreTraceFlagHasRight) != 0;
+    header->projectsMomentum = (flags & PKRevealCoreTraceFlagProjectsMomentum) != 0;
+    header->includesPresentationModes = (flags & PKRevealCoreTraceFlagIncludesPresentationModes) != 0;
+    header->usesSpring = (flags & PKRevealCoreTraceFlagUsesSpring) != 0;
+    header->midX = values[0];
+    header->initialPosition = values[1];
+    header->leftRange = PKRevealCoreWidthRangeMake(values[2], values[3]);
+    header->rightRange = PKRevealCoreWidthRangeMake(values[4], values[5]);
+    header->quickSwipeVelocity = values[6];
+    header->decelerationRate = values[7];
+    header->animationDuration = values[8];
+    header->spring = PKRevealCoreSpringMake(values[9], values[10], values[11]);
+    
+    if (header->initialState < PKRevealCoreStateLeftPresentation || header->initialState > PKRevealCoreStateRightPresentation)
+    {
+        return -1;
+    }
+    
+    size_t count = (length - headerLength) / PKRevealCoreTraceSampleSize;
+    
+    for (size_t index = 0; samples && index < count && index < capacity; index++)
+    {
+        const uint8_t *sampleBytes = bytes + headerLength + (index * PKRevealCoreTraceSampleSize);
+        
+        samples[index].time = PKReadDouble(sampleBytes);
+        samples[index].translation = PKReadFloat(sampleBytes + 8);
+        samples[index].velocity = PKReadFloat(sampleBytes + 12);
+        samples[index].kind = (PKRevealCoreTraceSampleKind)sampleBytes[16];
+        samples[index].state = (PKRevealCoreState)sampleBytes[17];
+    }
+    
+    return (long)count;
+}
+
+#pragma mark - Replay
+
+typedef struct
+{
+    PKRevealCoreGeometry geometry;
+    PKRevealCoreMotion motion;
+    PKRevealCoreState state;
+    double position;
+    double initialPosition;
+    double initialTranslation;
+    double releaseTime;
+    bool isInteracting;
+    bool isSettling;
+} PKRevealCoreReplayContext;
+
+/// Mirrors the pan handling of PKRevealController.
+static void PKRevealCoreReplayApplySample(PKRevealCoreReplayContext *context,
+                                          const PKRevealCoreTraceHeader *header,
+                                          const PKRevealCoreTraceSample *sample)
+{
+    switch (sample->kind)
+    {
+        case PKRevealCoreTraceSampleKindPanBegan:
+        {
+            context->isSettling = false;
+            context->isInteracting = true;
+            context->initialPosition = PKRevealCorePanOrigin(&context->geometry, context->position);
+            context->initialTranslation = sample->translation;
+        }
+            break;
+            
+        case PKRevealCoreTraceSampleKindPanChanged:
+        {
+            if (context->isInteracting)
+            {
+                double proposedX = PKRevealCoreProposedPanPosition(context->initialPosition, context->initialTranslation, sample->translation);
+                context->position = PKRevealCoreFrontViewPositionForPan(&context->geometry, proposedX, context->position);
+                context->state = PKRevealCoreStateForPosition(&context->geometry, context->position);
+            }
+        }
+            break;
+            
+        case PKRevealCoreTraceSampleKindPanEnded:
+        {
+            PKRevealCoreState toState;
+            
+            if (header->projectsMomentum)
+            {
+                toState = PKRevealCoreStateForProjectedRelease(&context->geometry,
+                                                               context->position,
+                                                               sample->velocity,
+                                                               header->decelerationRate,
+                                                               header->includesPresentationModes);
+            }
+            else
+            {
+                toState = PKRevealCoreStateForPanRelease(&context->geometry,
+                                                         context->state,
+                                                         context->position,
+                                                         sample->velocity,
+                                                         header->quickSwipeVelocity);
+            }
+            
+            double target = PKRevealCoreGeometryAnchor(&context->geometry, toState);
+            
+            if (header->usesSpring)
+            {
+                context->motion = PKRevealCoreMotionMakeSpring(context->position, target, sample->velocity, header->spring, PKRevealCoreTraceRestingDistance);
+            }
+            else
+            {
+                context->motion = PKRevealCoreMotionMake(context->position, target, sample->velocity, header->animationDuration);
+            }
+            
+            context->isInteracting = false;
+            context->isSettling = true;
+            context->releaseTime = sample->time;
+        }
+            break;
+            
+        case PKRevealCoreTraceSampleKindStateChange:
+        default:
+            break;
+    }
+}
+
+void PKRevealCoreReplay(const PKRevealCoreTraceHeader *header,
+                        const PKRevealCoreTraceSample *samples,
+                        size_t sampleCount,
+                        double frameInterval,
+                        double *positions,
+                        size_t positionCapacity,
+                        PKRevealCoreReplayResult *result)
+{
+    PKRevealCoreReplayContext context;
+    memset(&context, 0, sizeof(context));
+    memset(result, 0, sizeof(*result));
+    
+    PKRevealCoreDampening dampening = header->dampening;
+    
+    if (dampening.curve != PKRevealCoreDampeningCurveTable)
+    {
+        dampening = PKRevealCoreDampeningMake(dampening.curve, PKRevealCoreDampeningDefaultLimit);
+    }
+    
+    context.geometry = PKRevealCoreGeometryMake(header->midX, header->leftRange, header->rightRange, header->hasLeft, header->hasRight, &dampening);
+    context.position = header->initialPosition;
+    context.state = header->initialState;
+    
+    double startTime = (sampleCount > 0) ? samples[0].time : 0.0;
+    double endTime = (sampleCount > 0) ? samples[sampleCount - 1].time : 0.0;
+    double previousPosition = context.position;
+    size_t nextSample = 0;
+    
+    if (frameInterval <= 0.0)
+    {
+        frameInterval = 1.0 / 60.0;
+    }
+    
+    for (size_t frame = 0; ; frame++)
+    {
+        double time = startTime + ((double)frame * frameInterval);
+        
+        while (nextSample < sampleCount && samples[nextSample].time <= time)
+        {
+            PKRevealCoreReplayApplySample(&context, header, &samples[nextSample]);
+            nextSample++;
+        }
+        
+        if (context.isSettling)
+        {
+            double elapsed = time - context.releaseTime;
+            context.position = PKRevealCoreMotionPosition(&context.motion, elapsed);
+            
+            if (PKRevealCoreMotionIsFinished(&context.motion, elapsed))
+            {
+                context.isSettling = false;
+                result->settleDuration = elapsed;
+            }
+            
+            context.state = PKRevealCoreStateForPosition(&context.geometry, context.position);
+        }
+        
+        if (positions && frame < positionCapacity)
+        {
+            positions[frame] = context.position;
+        }
+        
+        result->maximumFrameDistance = fmax(result->maximumFrameDistance, fabs(context.position - previousPosition));
+        result->frameCount = frame + 1;
+        result->totalDuration = time - startTime;
+        previousPosition = context.position;
+        
+        bool isDone = (nextSample >= sampleCount && !context.isInteracting && !context.isSettling);
+        
+        if (isDone || time - endTime > PKRevealCoreReplayMaximumSettleDuration)
+        {
+            break;
+        }
+    }
+    
+    result->finalState = PKRevealCoreStateForPosition(&context.geometry, context.position);
+}
@@ -0,0 +1,154 @@
+/*
+    PKRevealController > PKRevealCoreTrace.h
+    Copyright (c) 2013 zuui.org (Philip Kluz). All rights reserved.
+ 
+    The MIT License (MIT)
+ 
+    Copyright (c) 2013 Philip Kluz
+ 
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+ 
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+ 
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Gesture traces capture what a pan gesture recognizer delivered, together with the configuration the
+ * controller used at the time, in a compact little-endian binary format. A trace can be replayed through
+ * the reveal core's pan and settle logic with a simulated clock, so that traces recorded in the field can
+ * be turned into deterministic regression tests and benchmarks.
+ */
+
+#ifndef PKRevealCoreTrace_h
+#define PKRevealCoreTrace_h
+
+#include "PKRevealCore.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PKRevealCoreTraceVersion 2
+#define PKRevealCoreTraceHeaderSize 112
+#define PKRevealCoreTraceSampleSize 24
+
+/// The size of the dampening table that follows the header if the trace was recorded with a custom dampening curve.
+#define PKRevealCoreTraceDampeningTableSize (8 * (PKRevealCoreDampeningSampleCount + 3))
+
+typedef enum
+{
+    PKRevealCoreTraceSampleKindPanBegan     = 1,
+    PKRevealCoreTraceSampleKindPanChanged   = 2,
+    PKRevealCoreTraceSampleKindPanEnded     = 3,
+    /// The controller's state changed. The sample's state holds the new state.
+    PKRevealCoreTraceSampleKindStateChange  = 4
+} PKRevealCoreTraceSampleKind;
+
+/// The controller configuration at the time recording started.
+typedef struct
+{
+    PKRevealCoreWidthRange leftRange;
+    PKRevealCoreWidthRange rightRange;
+    double midX;
+    double initialPosition;
+    double quickSwipeVelocity;
+    double decelerationRate;
+    double animationDuration;
+    PKRevealCoreSpring spring;
+    /// The overdraw dampening. Only the curve is recorded for built-in curves, which use PKRevealCoreDampeningDefaultLimit like the controller does.
+    PKRevealCoreDampening dampening;
+    PKRevealCoreState initialState;
+    bool hasLeft;
+    bool hasRight;
+    bool projectsMomentum;
+    bool includesPresentationModes;
+    bool usesSpring;
+} PKRevealCoreTraceHeader;
+
+typedef struct
+{
+    double time;
+    float translation;
+    float velocity;
+    PKRevealCoreTraceSampleKind kind;
+    PKRevealCoreState state;
+} PKRevealCoreTraceSample;
+
+/// @return The number of bytes the encoded header takes, including a custom dampening table.
+size_t PKRevealCoreTraceHeaderLength(const PKRevealCoreTraceHeader *header);
+
+/// Encodes the header into exactly PKRevealCoreTraceHeaderLength bytes, at most PKRevealCoreTraceHeaderSize + PKRevealCoreTraceDampeningTableSize.
+void PKRevealCoreTraceEncodeHeader(const PKRevealCoreTraceHeader *header, uint8_t *bytes);
+
+/// Encodes the sample into exactly PKRevealCoreTraceSampleSize bytes.
+void PKRevealCoreTraceEncodeSample(const PKRevealCoreTraceSample *sample, uint8_t *bytes);
+
+/**
+ Decodes a trace.
+ 
+ @param bytes The encoded trace, i.e. a header, a custom dampening table if the header's curve is a table, and any number of samples.
+ @param length The length of the encoded trace in bytes.
+ @param header Receives the header.
+ @param samples Receives at most capacity samples. May be NULL to count the samples.
+ @param capacity The capacity of samples.
+ @return The number of samples in the trace, or -1 if it is malformed.
+ */
+long PKRevealCoreTraceDecode(const uint8_t *bytes,
+                             size_t length,
+                             PKRevealCoreTraceHeader *header,
+                             PKRevealCoreTraceSample *samples,
+                             size_t capacity);
+
+/// Figures describing a replay.
+typedef struct
+{
+    /// The number of simulated frames.
+    size_t frameCount;
+    /// The simulated time from the first sample until the front view came to rest, in seconds.
+    double totalDuration;
+    /// The simulated time from the last release until the front view came to rest, in seconds.
+    double settleDuration;
+    /// The largest distance the front view moved between two consecutive frames, in points.
+    double maximumFrameDistance;
+    /// The state the front view came to rest in.
+    PKRevealCoreState finalState;
+} PKRevealCoreReplayResult;
+
+/**
+ Feeds a trace through the reveal core's pan and settle logic, sampling the front view's position once
+ per simulated frame.
+ 
+ @param header The trace header.
+ @param samples The trace samples, ordered by time.
+ @param sampleCount The number of samples.
+ @param frameInterval The simulated frame interval in seconds, e.g. 1/60.
+ @param positions Receives the front view position of at most positionCapacity frames. May be NULL.
+ @param positionCapacity The capacity of positions.
+ @param result Receives the replay figures.
+ */
+void PKRevealCoreReplay(const PKRevealCoreTraceHeader *header,
+                        const PKRevealCoreTraceSample *samples,
+                        size_t sampleCount,
+                        double frameInterval,
+                        double *positions,
+                        size_t positionCapacity,
+                        PKRevealCoreReplayResult *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
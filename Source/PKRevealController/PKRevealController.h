@@ -39,9 +39,52 @@ typedef enum : NSUInteger
 
 typedef enum : NSUInteger
 {
-    PKRevealControllerAnimationTypeStatic
+    /// Rear views stay in place while the front view slides over them.
+    PKRevealControllerAnimationTypeStatic,
+    /// Rear views follow the front view at parallaxRatio of its speed until they are revealed to their minimum width.
+    PKRevealControllerAnimationTypeParallax,
+    /// The front view shrinks to frontViewScale while it reveals a rear view to its minimum width.
+    PKRevealControllerAnimationTypeScale
 } PKRevealControllerAnimationType;
 
+typedef enum : NSUInteger
+{
+    /// Transitions take animationDuration, regardless of the distance travelled.
+    PKRevealControllerAnimationTimingFixed,
+    /// Transitions follow a damped spring. Their duration depends on the distance travelled and the release velocity.
+    PKRevealControllerAnimationTimingSpring
+} PKRevealControllerAnimationTiming;
+
+typedef enum : NSUInteger
+{
+    /// Rear view controllers are removed from the controller hierarchy as soon as their view is hidden.
+    PKRevealControllerRearContainmentPolicyDetachWhenHidden,
+    /// Rear view controllers stay attached once they have been revealed. Hidden ones are only detached on memory warnings.
+    PKRevealControllerRearContainmentPolicyKeepAttached,
+    /// Rear view controllers are detached once their view has been hidden for rearDetachTimeout seconds.
+    PKRevealControllerRearContainmentPolicyDetachAfterTimeout
+} PKRevealControllerRearContainmentPolicy;
+
+typedef enum : NSUInteger
+{
+    /// An arctangent that lets the front view reach the maximum width. The curve used by earlier versions.
+    PKRevealControllerOverdrawDampeningArctangent,
+    /// The rubber band of a scroll view, scaled to reach the maximum width.
+    PKRevealControllerOverdrawDampeningRubberBand,
+    /// An exponential decay that reaches the maximum width sooner than the arctangent.
+    PKRevealControllerOverdrawDampeningExponential,
+    /// The values passed to -setOverdrawDampeningValues:extent:.
+    PKRevealControllerOverdrawDampeningCustom
+} PKRevealControllerOverdrawDampening;
+
+typedef enum : NSUInteger
+{
+    /// A blurred layer shadow along the front view's cached shadow path.
+    PKRevealControllerShadowStyleLayer,
+    /// Pre-rendered gradient strips along the front view's edges. Cheaper to composite, as no offscreen pass is required.
+    PKRevealControllerShadowStyleGradient
+} PKRevealControllerShadowStyle;
+
 typedef enum : NSUInteger
 {
     PKRevealControllerTypeNone  = 0,
@@ -50,7 +93,32 @@ typedef enum : NSUInteger
     PKRevealControllerTypeBoth  = (PKRevealControllerTypeLeft | PKRevealControllerTypeRight)
 } PKRevealControllerType;
 
+typedef enum : NSUInteger
+{
+    /// Pans anywhere on the front view move it.
+    PKRevealControllerPanRegionFrontView,
+    /// While the front view is focused, only pans touching down within revealPanEdgeInsets of its left or right edge reveal a rear view. Once a rear view is revealed, pans anywhere on the front view move it.
+    PKRevealControllerPanRegionEdges
+} PKRevealControllerPanRegion;
+
+typedef enum : NSUInteger
+{
+    /// The left view's reveal progress changed.
+    PKRevealControllerProgressEventLeft         = 1 << 0,
+    /// The right view's reveal progress changed.
+    PKRevealControllerProgressEventRight        = 1 << 1,
+    /// The change was driven by the user panning the front view.
+    PKRevealControllerProgressEventInteractive  = 1 << 2,
+    /// The change was driven by an animated or immediate state change.
+    PKRevealControllerProgressEventAutomatic    = 1 << 3,
+    PKRevealControllerProgressEventAll          = (PKRevealControllerProgressEventLeft |
+                                                   PKRevealControllerProgressEventRight |
+                                                   PKRevealControllerProgressEventInteractive |
+                                                   PKRevealControllerProgressEventAutomatic)
+} PKRevealControllerProgressEvents;
+
 typedef void(^PKDefaultCompletionHandler)(BOOL finished);
+typedef void(^PKRevealControllerProgressHandler)(CGFloat leftProgress, CGFloat rightProgress, PKRevealControllerProgressEvents events);
 
 FOUNDATION_EXTERN NSString * const PKRevealControllerAnimationDurationKey;
 FOUNDATION_EXTERN NSString * const PKRevealControllerAnimationCurveKey;
@@ -62,23 +130,26 @@ FOUNDATION_EXTERN NSString * const PKRevealControllerRecognizesPanningOnFrontVie
 FOUNDATION_EXTERN NSString * const PKRevealControllerRecognizesResetTapOnFrontViewKey;
 
 @protocol PKRevealing;
+@class PKRevealControllerTelemetry;
+@class PKRevealControllerTransitionMetrics;
+@class PKTimingCurve;
 
 @interface PKRevealController : UIViewController <UIGestureRecognizerDelegate>
 
 #pragma mark - Properties
 /// The view controller displayed on top of the left and right ones.
-@property (nonatomic, readwrite, weak) UIViewController *frontViewController;
+@property (nonatomic, readwrite, strong) UIViewController *frontViewController;
 
 /// The view controller on the left.
-@property (nonatomic, readwrite, weak) UIViewController *leftViewController;
+@property (nonatomic, readwrite, strong) UIViewController *leftViewController;
 
 /// The view controller on the right.
-@property (nonatomic, readwrite, weak) UIViewController *rightViewController;
+@property (nonatomic, readwrite, strong) UIViewController *rightViewController;
 
-/// The gesture recognizer that is used to enable pan based reveal. By default this recognizer is added to the front view's container. Inactive and at your disposal if front view panning is disabled.
+/// The gesture recognizer that is used to enable pan based reveal. By default this recognizer is added to the front view's container and its delegate is the controller. Inactive and at your disposal if front view panning is disabled.
 @property (nonatomic, readonly) UIPanGestureRecognizer *revealPanGestureRecognizer;
 
-/// The gesture recognizer that is used to enable snap-back-on-tap if a rear view is shown and the user taps on the front view. By default this recognizer is added to the front view's container. Inactive and at your disposal if front view tapping is disabled.
+/// The gesture recognizer that is used to enable snap-back-on-tap if a rear view is shown and the user taps on the front view. By default this recognizer stays added to the front view's container and only begins while a rear view is shown, as decided by the controller as its delegate. Inactive and at your disposal if front view tapping is disabled.
 @property (nonatomic, readonly) UITapGestureRecognizer *revealResetTapGestureRecognizer;
 
 /// The controllers current state. **Observable.**
@@ -96,30 +167,96 @@ FOUNDATION_EXTERN NSString * const PKRevealControllerRecognizesResetTapOnFrontVi
 /// The controllers automatic reveal animation duration. Defaults to 0.185.
 @property (nonatomic, assign, readwrite) CGFloat animationDuration;
 
-/// The controllers automatic reveal animation curve. Defaults to UIViewAnimationCurveLinear.
+/// The controllers automatic reveal animation curve. Applies to the whole transition, even if it passes the front view on its way. Ignored if timingCurve is set. Defaults to UIViewAnimationCurveEaseInOut.
 @property (nonatomic, assign, readwrite) UIViewAnimationCurve animationCurve;
 
-/// The controllers animation type. Currently only static is supported. Parallax and scaling support in the works.
+/// A custom cubic-bezier curve for the controllers automatic reveal animations, e.g. one defined by your design system. Overrides animationCurve. Defaults to nil.
+@property (nonatomic, strong, readwrite) PKTimingCurve *timingCurve;
+
+/// The controllers animation type. Parallax and scale effects are applied as layer transforms and never cause a relayout of the child views. Defaults to PKRevealControllerAnimationTypeStatic.
 @property (nonatomic, assign, readwrite) PKRevealControllerAnimationType animationType;
 
+/// The fraction of the front view's speed at which rear views follow it with PKRevealControllerAnimationTypeParallax. Defaults to 0.3.
+@property (nonatomic, assign, readwrite) CGFloat parallaxRatio;
+
+/// The scale of the front view once a rear view is revealed to its minimum width with PKRevealControllerAnimationTypeScale. Defaults to 0.85.
+@property (nonatomic, assign, readwrite) CGFloat frontViewScale;
+
+/// The controllers animation timing. Defaults to PKRevealControllerAnimationTimingFixed.
+@property (nonatomic, assign, readwrite) PKRevealControllerAnimationTiming animationTiming;
+
+/// The mass of the spring used by PKRevealControllerAnimationTimingSpring. Defaults to 1. Values below 0.01 are clamped.
+@property (nonatomic, assign, readwrite) CGFloat springMass;
+
+/// The stiffness of the spring used by PKRevealControllerAnimationTimingSpring. Defaults to 900. Values below 1 are clamped.
+@property (nonatomic, assign, readwrite) CGFloat springStiffness;
+
+/// The damping of the spring used by PKRevealControllerAnimationTimingSpring. Defaults to 60, which damps the default spring critically. Lower values let the front view bounce. Negative values are clamped to 0, and the spring is always damped enough to settle.
+@property (nonatomic, assign, readwrite) CGFloat springDamping;
+
 /// The minimum velocity required for a swipe to trigger a state change. Defaults to 800.
 @property (nonatomic, assign, readwrite) CGFloat quickSwipeVelocity;
 
+/// Whether a released pan picks its target state by projecting the front view's momentum onto the nearest of all reachable states, instead of comparing the release velocity against quickSwipeVelocity. Presentation modes are only reachable if allowsOverdraw is enabled. Defaults to NO.
+@property (nonatomic, assign, readwrite) BOOL projectsMomentum;
+
+/// The rate at which the front view's momentum is projected to decay, per millisecond. Defaults to 0.998, the rate of UIScrollViewDecelerationRateNormal.
+@property (nonatomic, assign, readwrite) CGFloat decelerationRate;
+
 /// Whether to allow the user to draw further than the respective controllers min width. Dampened to stop at its max width. Defaults to YES.
 @property (nonatomic, assign, readwrite) BOOL allowsOverdraw;
 
+/// The curve that dampens panning beyond a rear view's minimum width. Defaults to PKRevealControllerOverdrawDampeningArctangent.
+@property (nonatomic, assign, readwrite) PKRevealControllerOverdrawDampening overdrawDampening;
+
 /// Whether to disable front view interaction whenever the controller's state does not equal PKRevealControllerShowsFrontViewController. Recommended for smaller screens.
 @property (nonatomic, assign, readwrite) BOOL disablesFrontViewInteraction;
 
 /// Whether to use the front view's entire visible area to allow pan based reveal.
 @property (nonatomic, assign, readwrite) BOOL recognizesPanningOnFrontView;
 
+/// Where pans on the front view may start. Limiting them to the edges keeps the reveal pan from competing with horizontal scroll views, carousels and swipeable cells in the front view. Defaults to PKRevealControllerPanRegionFrontView.
+@property (nonatomic, assign, readwrite) PKRevealControllerPanRegion revealPanRegion;
+
+/// The widths of the regions along the front view's edges that reveal a rear view with PKRevealControllerPanRegionEdges. Only the left and right insets are used. Defaults to 30 points on both sides.
+@property (nonatomic, assign, readwrite) UIEdgeInsets revealPanEdgeInsets;
+
 /// Whether to allow snap-back-on-tap if a rear view is shown and the user taps on the front view.
 @property (nonatomic, assign, readwrite) BOOL recognizesResetTapOnFrontView;
 
 /// Whether to allow snap-back-on-tap if a rear view is shown in presentation mode and the user taps on the front view.
 @property (nonatomic, assign, readwrite) BOOL recognizesResetTapOnFrontViewInPresentationMode;
 
+/// How the front view's shadow is rendered. Defaults to PKRevealControllerShadowStyleLayer.
+@property (nonatomic, assign, readwrite) PKRevealControllerShadowStyle shadowStyle;
+
+/// Whether revealed rear views are replaced by a cached snapshot while the front view is panned or animated. The live view is restored once the front view settles. Call setNeedsSnapshotUpdateForViewController: when a rear controller's content changes. Defaults to NO.
+@property (nonatomic, assign, readwrite) BOOL snapshotsRearViewsWhileMoving;
+
+/// When hidden rear view controllers are removed from the controller hierarchy. Defaults to PKRevealControllerRearContainmentPolicyDetachWhenHidden.
+@property (nonatomic, assign, readwrite) PKRevealControllerRearContainmentPolicy rearContainmentPolicy;
+
+/// How long a rear view controller stays attached after its view has been hidden when using PKRevealControllerRearContainmentPolicyDetachAfterTimeout. Defaults to 10 seconds.
+@property (nonatomic, assign, readwrite) NSTimeInterval rearDetachTimeout;
+
+/// The number of times a rear view controller has been added to the controller hierarchy.
+@property (nonatomic, assign, readonly) NSUInteger rearAttachCount;
+
+/// The number of times a rear view controller has been removed from the controller hierarchy.
+@property (nonatomic, assign, readonly) NSUInteger rearDetachCount;
+
+/// The number of times pan events updated the rear view visibility or the state. Pan events are coalesced into at most one such update per frame.
+@property (nonatomic, assign, readonly) NSUInteger rearVisibilityUpdateCount;
+
+/// The number of pan events that did not cause an update of their own, because nothing changed or an update was already pending for the frame.
+@property (nonatomic, assign, readonly) NSUInteger elidedRearVisibilityUpdateCount;
+
+/// Whether every animated and interactive transition is measured and aggregated into the telemetry snapshot. Measuring runs a display link while a transition is in flight. Defaults to NO.
+@property (nonatomic, assign, readwrite) BOOL collectsTelemetry;
+
+/// Whether pan gesture samples and state changes are recorded into the gesture trace. Enabling it starts a new trace. Defaults to NO.
+@property (nonatomic, assign, readwrite) BOOL recordsGestureTrace;
+
 /// The controller's delegate, conforming to the PKRevealing protocol.
 @property (nonatomic, weak, readwrite) id<PKRevealing> delegate;
 
@@ -236,6 +373,31 @@ FOUNDATION_EXTERN NSString * const PKRevealControllerRecognizesResetTapOnFrontVi
            maximumWidth:(CGFloat)maxWidth
       forViewController:(UIViewController *)controller;
 
+/**
+ Dampens panning beyond a rear view's minimum width with a curve of your own and sets overdrawDampening to PKRevealControllerOverdrawDampeningCustom. Distances are measured in units of the width range, i.e. 1 is the distance between minimum and maximum width.
+ 
+ @param values NSNumbers describing the dampened distance at evenly spaced overdraws from 0 to extent. Must be finite, never decrease and contain at least two values, otherwise the call is ignored.
+ @param extent The overdraw of the last value, must be positive. Beyond it the front view stays at the last value.
+ */
+- (void)setOverdrawDampeningValues:(NSArray *)values extent:(CGFloat)extent;
+
+/**
+ Observes how far the rear views are revealed while the front view moves, e.g. to dim or animate their content alongside. Progress runs from 0 while a rear view is hidden to 1 once it is revealed to its minimum width, and is reported at most once per display frame. A display link only runs while the front view moves and observers are registered.
+ 
+ @param events The sides and sources to observe. The handler is called if at least one side and one source match, e.g. PKRevealControllerProgressEventLeft | PKRevealControllerProgressEventInteractive.
+ @param handler Called on the main thread with the progress of both sides and the events that caused the change.
+ @return An opaque observer to pass to -removeRevealProgressObserver:.
+ */
+- (id)addRevealProgressObserverForEvents:(PKRevealControllerProgressEvents)events
+                              usingBlock:(PKRevealControllerProgressHandler)handler;
+
+/**
+ Stops calling an observer's handler.
+ 
+ @param observer An observer returned by -addRevealProgressObserverForEvents:usingBlock:.
+ */
+- (void)removeRevealProgressObserver:(id)observer;
+
 /**
  @return Returns the currently focused controller, i.e. the one that's most prominent at any given point in time.
  */
@@ -251,6 +413,38 @@ FOUNDATION_EXTERN NSString * const PKRevealControllerRecognizesResetTapOnFrontVi
  */
 - (BOOL)hasLeftViewController;
 
+/**
+ Rear containers and rear view controller views are loaded lazily, the first time they are revealed. Call this method while the app is idle, e.g. after launch has finished, to load them ahead of time so that the first reveal does not pay for it. Does nothing until the controller's view is loaded.
+ */
+- (void)warmUpRearViewControllers;
+
+/**
+ Discards the cached snapshot of a rear view controller's view. Only relevant if snapshotsRearViewsWhileMoving is enabled.
+ 
+ @param controller The rear view controller whose content changed.
+ */
+- (void)setNeedsSnapshotUpdateForViewController:(UIViewController *)controller;
+
+
+/**
+ @return The recorded gesture trace, i.e. the configuration followed by every pan sample and state change since recording started, in the binary format described in PKRevealCoreTrace.h. nil if nothing has been recorded. Replay it with the PKRevealCoreReplay tool.
+ */
+- (NSData *)gestureTrace;
+
+/**
+ Discards the recorded gesture trace. The next recorded sample starts a new trace with the then current configuration.
+ */
+- (void)resetGestureTrace;
+
+/**
+ @return A snapshot of the latency, dropped frame and duration histograms of all transitions measured since telemetry collection started, per pair of states. See PKRevealControllerTelemetry.h.
+ */
+- (PKRevealControllerTelemetry *)telemetrySnapshot;
+
+/**
+ Discards all aggregated telemetry.
+ */
+- (void)resetTelemetry;
 @end
 
 #pragma mark - PKRevealing Protocol Definition
@@ -278,6 +472,14 @@ FOUNDATION_EXTERN NSString * const PKRevealControllerRecognizesResetTapOnFrontVi
  */
 - (void)revealController:(PKRevealController *)revealController didChangeToState:(PKRevealControllerState)state;
 
+/**
+ Implement this method to receive the measurements of every animated or interactive transition, once the front view came to rest. Only called if collectsTelemetry is enabled.
+ 
+ @param revealController The controller that performed the transition.
+ @param metrics The measurements of the transition. See PKRevealControllerTelemetry.h.
+ */
+- (void)revealController:(PKRevealController *)revealController didFinishTransitionWithMetrics:(PKRevealControllerTransitionMetrics *)metrics;
+
 @end
 
 #pragma mark - Deprecated as of 2.0.1
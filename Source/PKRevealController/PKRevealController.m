@@ -27,18 +27,44 @@
 #import "PKRevealController.h"
 #import "NSObject+PKBlocks.h"
 #import "PKLayerAnimator.h"
+#import "PKInteractiveAnimator.h"
+#import "PKAnimationPool.h"
+#import "PKTimingCurve.h"
 #import "PKRevealControllerView.h"
+#import "PKRevealControllerRootView.h"
+#import "PKRevealControllerTelemetry.h"
+#import "PKTransitionMonitor.h"
+#import "PKRevealProgressMonitor.h"
+#import "PKFrameUpdateScheduler.h"
+#import "PKRevealCore.h"
+#import "PKRevealCoreTrace.h"
 #import "PKLog.h"
+#import "PKTrace.h"
+#import <objc/runtime.h>
 
 #define DEFAULT_ANIMATION_DURATION_VALUE 0.185
-#define DEFAULT_ANIMATION_CURVE_VALUE UIViewAnimationCurveLinear
+#define DEFAULT_ANIMATION_CURVE_VALUE UIViewAnimationCurveEaseInOut
 #define DEFAULT_LEFT_VIEW_WIDTH_RANGE NSMakeRange(260, 40)
 #define DEFAULT_RIGHT_VIEW_WIDTH_RANGE DEFAULT_LEFT_VIEW_WIDTH_RANGE
 #define DEFAULT_ALLOWS_OVERDRAW_VALUE YES
+#define DEFAULT_OVERDRAW_DAMPENING_VALUE PKRevealControllerOverdrawDampeningArctangent
 #define DEFAULT_ANIMATION_TYPE_VALUE PKRevealControllerAnimationTypeStatic
+#define DEFAULT_PARALLAX_RATIO_VALUE 0.3f
+#define DEFAULT_FRONT_VIEW_SCALE_VALUE 0.85f
+#define DEFAULT_ANIMATION_TIMING_VALUE PKRevealControllerAnimationTimingFixed
+#define DEFAULT_SPRING_MASS_VALUE 1.0f
+#define DEFAULT_SPRING_STIFFNESS_VALUE 900.0f
+#define DEFAULT_SPRING_DAMPING_VALUE 60.0f
+#define DEFAULT_PROJECTS_MOMENTUM_VALUE NO
+#define DEFAULT_DECELERATION_RATE_VALUE PKRevealCoreDecelerationRateNormal
+#define DEFAULT_REAR_CONTAINMENT_POLICY_VALUE PKRevealControllerRearContainmentPolicyDetachWhenHidden
+#define DEFAULT_REAR_DETACH_TIMEOUT_VALUE 10.0
+#define DEFAULT_SHADOW_STYLE_VALUE PKRevealControllerShadowStyleLayer
 #define DEFAULT_QUICK_SWIPE_TOGGLE_VELOCITY_VALUE 800.0f
 #define DEFAULT_DISABLES_FRONT_VIEW_INTERACTION_VALUE YES
 #define DEFAULT_RECOGNIZES_PAN_ON_FRONT_VIEW_VALUE YES
+#define DEFAULT_REVEAL_PAN_REGION_VALUE PKRevealControllerPanRegionFrontView
+#define DEFAULT_REVEAL_PAN_EDGE_INSETS UIEdgeInsetsMake(0.0f, 30.0f, 0.0f, 30.0f)
 #define DEFAULT_RECOGNIZES_RESET_TAP_ON_FRONT_VIEW_VALUE YES
 #define DEFAULT_RECOGNIZES_RESET_TAP_ON_FRONT_VIEW_IN_PRESENTATION_MODE_VALUE YES
 
@@ -53,6 +79,16 @@ NSString * const PKRevealControllerRecognizesResetTapOnFrontViewKey = @"recogniz
 NSString * const PKRevealControllerRecognizesResetTapOnFrontViewInPresentationModeKey = @"recognizesResetTapOnFrontViewInPresentationMode";
 
 static NSString *kPKRevealControllerFrontViewTranslationAnimationKey = @"frontViewTranslation";
+static NSString *kPKRevealControllerRevealTransformAnimationKey = @"revealTransform";
+
+// One running animation, plus one that was interrupted but has not reported its completion yet.
+static const NSUInteger kPKRevealControllerAnimationPoolCapacity = 2;
+
+typedef enum : NSUInteger
+{
+    PKRevealControllerUpdateRearVisibility  = 1 << 0,
+    PKRevealControllerUpdateState           = 1 << 1
+} PKRevealControllerUpdates;
 
 typedef struct
 {
@@ -66,11 +102,65 @@ typedef struct
     UIGestureRecognizerInteractionFlags recognizerFlags;
     CGPoint initialFrontViewPosition;
     BOOL isInteracting;
+    BOOL isMoving;
+    NSUInteger movingGeneration;
+    CGFloat interruptedVelocity;
 } PKRevealControllerFrontViewInteractionFlags;
 
+/*
+ * The keyframe transition the front view is on. Core Animation does not report the velocity of a running
+ * animation, hence it is derived from the route and the elapsed time when the transition is interrupted.
+ */
+typedef struct
+{
+    CFTimeInterval beginTime;
+    NSTimeInterval duration;
+    CGFloat fromX;
+    PKRevealCoreWaypoints waypoints;
+} PKRevealControllerKeyframeTransition;
+
+/*
+ * The optional PKRevealing methods the delegate implements, resolved once whenever the delegate is set.
+ * Add a flag for every new optional callback and set it in -setDelegate:.
+ */
+typedef struct
+{
+    unsigned int willChangeToState : 1;
+    unsigned int didChangeToState : 1;
+    unsigned int didFinishTransitionWithMetrics : 1;
+} PKRevealControllerDelegateFlags;
+
+typedef struct
+{
+    CGRect bounds;
+    CGFloat midY;
+    PKRevealCoreGeometry core;
+    BOOL isValid;
+} PKRevealControllerGeometry;
+
+/*
+ * The geometry table caches every value the gesture and animation code derives from the
+ * view's bounds and the configured width ranges. It is rebuilt lazily after being invalidated,
+ * which happens whenever the bounds, the width ranges or the child controllers change.
+ */
+NS_INLINE CGPoint PKRevealControllerGeometryCenterPoint(const PKRevealControllerGeometry *geometry, PKRevealControllerState state)
+{
+    return CGPointMake(PKRevealCoreGeometryAnchor(&geometry->core, (PKRevealCoreState)state), geometry->midY);
+}
+
+NS_INLINE PKRevealCoreWidthRange PKRevealCoreWidthRangeFromRange(NSRange range)
+{
+    return PKRevealCoreWidthRangeMake(range.location, (range.location + range.length));
+}
+
 @interface PKRevealController()
 {
     PKRevealControllerFrontViewInteractionFlags _frontViewInteraction;
+    PKRevealControllerDelegateFlags _delegateFlags;
+    PKRevealControllerGeometry _geometry;
+    PKRevealCoreTelemetry _telemetry;
+    PKRevealControllerKeyframeTransition _keyframeTransition;
+    NSUInteger _rearDetachGeneration;
 }
 
 #pragma mark - Properties
@@ -86,7 +176,22 @@ typedef struct
 @property (nonatomic, assign, readwrite) NSRange leftViewWidthRange;
 @property (nonatomic, assign, readwrite) NSRange rightViewWidthRange;
 
+/// The resampled PKRevealCoreDampening of the custom dampening values.
+@property (nonatomic, copy, readwrite) NSData *customOverdrawDampening;
+
+@property (nonatomic, assign, readwrite) NSUInteger rearAttachCount;
+@property (nonatomic, assign, readwrite) NSUInteger rearDetachCount;
+
 @property (nonatomic, strong, readwrite) PKLayerAnimator *animator;
+@property (nonatomic, strong, readwrite) PKAnimationPool *animationPool;
+@property (nonatomic, strong, readwrite) PKInteractiveAnimator *interactiveAnimator;
+@property (nonatomic, strong, readwrite) PKTimingCurve *keyframeTimingCurve;
+
+@property (nonatomic, strong, readwrite) NSMutableData *gestureTraceData;
+@property (nonatomic, strong, readwrite) PKTransitionMonitor *transitionMonitor;
+@property (nonatomic, strong, readwrite) PKRevealProgressMonitor *progressMonitor;
+@property (nonatomic, strong, readwrite) PKFrameUpdateScheduler *updateScheduler;
+@property (nonatomic, strong, readwrite) NSMapTable *embeddedScrollViewRecognizers;
 
 #pragma mark - Methods
 - (instancetype)initWithFrontViewController:(UIViewController *)frontViewController
@@ -420,6 +525,9 @@ typedef struct
         {
             [self addViewController:_frontViewController container:self.frontView];
         }
+        
+        [self.embeddedScrollViewRecognizers removeAllObjects];
+        [self invalidateGeometry];
     }
 }
 
@@ -433,11 +541,14 @@ typedef struct
         }
         
         _leftViewController = leftViewController;
+        self.leftView.viewController = _leftViewController;
         
-        if (_leftViewController)
+        if (_leftViewController && self.leftView && !self.leftView.hidden)
         {
             [self addViewController:_leftViewController container:self.leftView];
         }
+        
+        [self invalidateGeometry];
     }
 }
 
@@ -451,11 +562,14 @@ typedef struct
         }
         
         _rightViewController = rightViewController;
+        self.rightView.viewController = _rightViewController;
         
-        if (_rightViewController)
+        if (_rightViewController && self.rightView && !self.rightView.hidden)
         {
             [self addViewController:_rightViewController container:self.rightView];
         }
+        
+        [self invalidateGeometry];
     }
 }
 
@@ -474,6 +588,106 @@ typedef struct
     {
         self.rightViewWidthRange = range;
     }
+    
+    [self invalidateGeometry];
+}
+
+- (void)setRearContainmentPolicy:(PKRevealControllerRearContainmentPolicy)rearContainmentPolicy
+{
+    _rearContainmentPolicy = rearContainmentPolicy;
+    [self cancelScheduledRearDetach];
+    
+    if (rearContainmentPolicy == PKRevealControllerRearContainmentPolicyDetachWhenHidden)
+    {
+        [self detachHiddenRearViewControllers];
+    }
+}
+
+- (void)setDelegate:(id<PKRevealing>)delegate
+{
+    _delegate = delegate;
+    
+    BOOL isRevealing = [delegate conformsToProtocol:@protocol(PKRevealing)];
+    
+    _delegateFlags.willChangeToState = (isRevealing && [delegate respondsToSelector:@selector(revealController:willChangeToState:)]);
+    _delegateFlags.didChangeToState = (isRevealing && [delegate respondsToSelector:@selector(revealController:didChangeToState:)]);
+    _delegateFlags.didFinishTransitionWithMetrics = (isRevealing && [delegate respondsToSelector:@selector(revealController:didFinishTransitionWithMetrics:)]);
+}
+
+- (void)setOverdrawDampening:(PKRevealControllerOverdrawDampening)overdrawDampening
+{
+    if (overdrawDampening != _overdrawDampening)
+    {
+        _overdrawDampening = overdrawDampening;
+        [self invalidateGeometry];
+    }
+}
+
+- (void)setAnimationType:(PKRevealControllerAnimationType)animationType
+{
+    if (animationType != _animationType)
+    {
+        _animationType = animationType;
+        
+        // Also resets the transforms of the previous type when switching to static.
+        [self applyRevealTransformsForFrontViewPosition:self.frontView.layer.position.x];
+    }
+}
+
+- (void)setParallaxRatio:(CGFloat)parallaxRatio
+{
+    _parallaxRatio = parallaxRatio;
+    [self updateRevealTransforms];
+}
+
+- (void)setFrontViewScale:(CGFloat)frontViewScale
+{
+    _frontViewScale = frontViewScale;
+    [self updateRevealTransforms];
+}
+
+- (void)setSpringMass:(CGFloat)springMass
+{
+    _springMass = fmax(springMass, PKRevealCoreSpringMinimumMass);
+}
+
+- (void)setSpringStiffness:(CGFloat)springStiffness
+{
+    _springStiffness = fmax(springStiffness, PKRevealCoreSpringMinimumStiffness);
+}
+
+- (void)setSpringDamping:(CGFloat)springDamping
+{
+    // The core raises damping that is too weak for the spring to settle, which depends on mass and stiffness.
+    _springDamping = fmax(springDamping, 0.0);
+}
+
+/*
+ * The values are resampled once, here, into the fixed-size table the core works with, such that rebuilding the
+ * geometry neither depends on nor copies a table of arbitrary length.
+ */
+- (void)setOverdrawDampeningValues:(NSArray *)values extent:(CGFloat)extent
+{
+    NSUInteger count = [values count];
+    NSMutableData *buffer = [NSMutableData dataWithLength:(count * sizeof(double))];
+    double *samples = [buffer mutableBytes];
+    
+    for (NSUInteger index = 0; index < count; index++)
+    {
+        samples[index] = [values[index] doubleValue];
+    }
+    
+    if (!PKRevealCoreDampeningIsValidTable(samples, count, extent))
+    {
+        PKLog(@"%@ ERROR - %s : Overdraw dampening values must be at least two finite, non-decreasing numbers and the extent must be positive.", [self class], __PRETTY_FUNCTION__);
+        return;
+    }
+    
+    PKRevealCoreDampening dampening = PKRevealCoreDampeningMakeTable(samples, count, extent);
+    self.customOverdrawDampening = [NSData dataWithBytes:&dampening length:sizeof(dampening)];
+    
+    _overdrawDampening = PKRevealControllerOverdrawDampeningCustom;
+    [self invalidateGeometry];
 }
 
 - (void)setOptions:(NSDictionary *)options
@@ -548,10 +762,24 @@ typedef struct
     _animationDuration = DEFAULT_ANIMATION_DURATION_VALUE;
     _animationCurve = DEFAULT_ANIMATION_CURVE_VALUE;
     _animationType = DEFAULT_ANIMATION_TYPE_VALUE;
+    _parallaxRatio = DEFAULT_PARALLAX_RATIO_VALUE;
+    _frontViewScale = DEFAULT_FRONT_VIEW_SCALE_VALUE;
+    _animationTiming = DEFAULT_ANIMATION_TIMING_VALUE;
+    _springMass = DEFAULT_SPRING_MASS_VALUE;
+    _springStiffness = DEFAULT_SPRING_STIFFNESS_VALUE;
+    _springDamping = DEFAULT_SPRING_DAMPING_VALUE;
     _quickSwipeVelocity = DEFAULT_QUICK_SWIPE_TOGGLE_VELOCITY_VALUE;
+    _projectsMomentum = DEFAULT_PROJECTS_MOMENTUM_VALUE;
+    _decelerationRate = DEFAULT_DECELERATION_RATE_VALUE;
+    _rearContainmentPolicy = DEFAULT_REAR_CONTAINMENT_POLICY_VALUE;
+    _rearDetachTimeout = DEFAULT_REAR_DETACH_TIMEOUT_VALUE;
+    _shadowStyle = DEFAULT_SHADOW_STYLE_VALUE;
     _allowsOverdraw = DEFAULT_ALLOWS_OVERDRAW_VALUE;
+    _overdrawDampening = DEFAULT_OVERDRAW_DAMPENING_VALUE;
     _disablesFrontViewInteraction = DEFAULT_DISABLES_FRONT_VIEW_INTERACTION_VALUE;
     _recognizesPanningOnFrontView = DEFAULT_RECOGNIZES_PAN_ON_FRONT_VIEW_VALUE;
+    _revealPanRegion = DEFAULT_REVEAL_PAN_REGION_VALUE;
+    _revealPanEdgeInsets = DEFAULT_REVEAL_PAN_EDGE_INSETS;
     _recognizesResetTapOnFrontView = DEFAULT_RECOGNIZES_RESET_TAP_ON_FRONT_VIEW_VALUE;
     _leftViewWidthRange = DEFAULT_LEFT_VIEW_WIDTH_RANGE;
     _rightViewWidthRange = DEFAULT_RIGHT_VIEW_WIDTH_RANGE;
@@ -560,30 +788,102 @@ typedef struct
 
 - (void)setupContainerViews
 {
+    self.frontView = [[PKRevealControllerView alloc] initWithFrame:self.view.bounds];
+    self.frontView.autoresizingMask = (UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight);
+    self.frontView.viewController = self.frontViewController;
+    self.frontView.shadowStyle = self.shadowStyle;
+    self.frontView.shadow = YES;
+    
+    [self.view addSubview:self.frontView];
+    [self rootView].frontView = self.frontView;
+    
+    [self addViewController:self.frontViewController container:self.frontView];
+}
+
+/*
+ * The rear containers are created the first time a rear view is about to be revealed, and the rear
+ * controllers are only attached while their container is visible. Launch therefore only pays for the
+ * front view controller.
+ */
+- (void)setupRearContainerViewsIfNeeded
+{
+    if (self.leftView && self.rightView)
+    {
+        return;
+    }
+    
     self.rightView = [[PKRevealControllerView alloc] initWithFrame:self.view.bounds];
     self.leftView = [[PKRevealControllerView alloc] initWithFrame:self.view.bounds];
-    self.frontView = [[PKRevealControllerView alloc] initWithFrame:self.view.bounds];
     
     self.rightView.autoresizingMask = (UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight);
     self.leftView.autoresizingMask = (UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight);
-    self.frontView.autoresizingMask = (UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight);
     
     self.rightView.viewController = self.rightViewController;
     self.leftView.viewController = self.leftViewController;
-    self.frontView.viewController = self.frontViewController;
     
-    self.frontView.shadow = YES;
+    self.rightView.usesSnapshots = self.snapshotsRearViewsWhileMoving;
+    self.leftView.usesSnapshots = self.snapshotsRearViewsWhileMoving;
     
     self.leftView.hidden = YES;
     self.rightView.hidden = YES;
     
-    [self.view addSubview:self.rightView];
-    [self.view addSubview:self.leftView];
-    [self.view addSubview:self.frontView];
+    [self.view insertSubview:self.rightView belowSubview:self.frontView];
+    [self.view insertSubview:self.leftView belowSubview:self.frontView];
+    [self rootView].leftView = self.leftView;
+    [self rootView].rightView = self.rightView;
     
-    [self addViewController:self.frontViewController container:self.frontView];
-    [self addViewController:self.leftViewController container:self.leftView];
-    [self addViewController:self.rightViewController container:self.rightView];
+    [self updateRevealTransforms];
+}
+
+- (void)setShadowStyle:(PKRevealControllerShadowStyle)shadowStyle
+{
+    if (_shadowStyle != shadowStyle)
+    {
+        _shadowStyle = shadowStyle;
+        self.frontView.shadowStyle = shadowStyle;
+    }
+}
+
+- (void)setSnapshotsRearViewsWhileMoving:(BOOL)snapshotsRearViewsWhileMoving
+{
+    if (_snapshotsRearViewsWhileMoving != snapshotsRearViewsWhileMoving)
+    {
+        _snapshotsRearViewsWhileMoving = snapshotsRearViewsWhileMoving;
+        
+        self.leftView.usesSnapshots = snapshotsRearViewsWhileMoving;
+        self.rightView.usesSnapshots = snapshotsRearViewsWhileMoving;
+        
+        if (!snapshotsRearViewsWhileMoving)
+        {
+            [self.leftView invalidateSnapshot];
+            [self.rightView invalidateSnapshot];
+        }
+    }
+}
+
+- (void)setNeedsSnapshotUpdateForViewController:(UIViewController *)controller
+{
+    if ([controller isEqual:self.leftViewController])
+    {
+        [self.leftView invalidateSnapshot];
+    }
+    else if ([controller isEqual:self.rightViewController])
+    {
+        [self.rightView invalidateSnapshot];
+    }
+}
+
+- (void)warmUpRearViewControllers
+{
+    if (![self isViewLoaded])
+    {
+        return;
+    }
+    
+    [self setupRearContainerViewsIfNeeded];
+    
+    [self.leftViewController view];
+    [self.rightViewController view];
 }
 
 - (void)setupGestureRecognizers
@@ -596,6 +896,13 @@ typedef struct
     self.revealResetTapGestureRecognizer = [[UITapGestureRecognizer alloc] initWithTarget:self
                                                                                    action:@selector(didRecognizeTapGesture:)];
     
+    // Both recognizers stay installed across transitions and are gated by -gestureRecognizerShouldBegin:.
+    self.revealPanGestureRecognizer.delegate = self;
+    self.revealResetTapGestureRecognizer.delegate = self;
+    [self.revealResetTapGestureRecognizer requireGestureRecognizerToFail:self.revealPanGestureRecognizer];
+    
+    self.embeddedScrollViewRecognizers = [NSMapTable weakToWeakObjectsMapTable];
+    
     [self updatePanGestureRecognizerPresence];
     [self updateTapGestureRecognizerPrecence];
 }
@@ -629,16 +936,66 @@ typedef struct
 
 #pragma mark - View Lifecycle
 
+- (void)loadView
+{
+    // Views loaded from a nib keep UIKit's hit testing.
+    if (self.nibName)
+    {
+        [super loadView];
+        return;
+    }
+    
+    PKRevealControllerRootView *view = [[PKRevealControllerRootView alloc] initWithFrame:[[UIScreen mainScreen] bounds]];
+    view.autoresizingMask = (UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight);
+    
+    self.view = view;
+}
+
 - (void)viewDidLoad
 {
     [super viewDidLoad];
     
     _state = PKRevealControllerShowsFrontViewController;
     
+    [self invalidateGeometry];
     [self setupContainerViews];
     [self setupGestureRecognizers];
     
     self.animator = [PKLayerAnimator animatorForLayer:self.frontView.layer];
+    self.interactiveAnimator = [PKInteractiveAnimator animatorForLayer:self.frontView.layer];
+    self.animationPool = [PKAnimationPool poolWithCapacity:kPKRevealControllerAnimationPoolCapacity];
+    self.progressMonitor.layer = self.frontView.layer;
+    
+    __weak PKRevealController *weakSelf = self;
+    self.updateScheduler = [PKFrameUpdateScheduler schedulerWithHandler:^(NSUInteger updates)
+    {
+        [weakSelf performUpdates:(PKRevealControllerUpdates)updates];
+    }];
+}
+
+- (void)didReceiveMemoryWarning
+{
+    [super didReceiveMemoryWarning];
+    
+    [self cancelScheduledRearDetach];
+    [self detachHiddenRearViewControllers];
+}
+
+- (void)viewWillDisappear:(BOOL)animated
+{
+    [super viewWillDisappear:animated];
+    [self cancelScheduledRearDetach];
+}
+
+- (void)viewWillLayoutSubviews
+{
+    [super viewWillLayoutSubviews];
+    
+    if (!CGRectEqualToRect(_geometry.bounds, self.view.bounds))
+    {
+        [self invalidateGeometry];
+        [self updateRevealTransforms];
+    }
 }
 
 #if __IPHONE_OS_VERSION_MAX_ALLOWED >= __IPHONE_7_0
@@ -702,6 +1059,11 @@ typedef struct
 
 - (void)didRecognizePanGesture:(UIPanGestureRecognizer *)recognizer
 {
+    if (self.recordsGestureTrace)
+    {
+        [self recordGestureTraceSampleWithRecognizer:recognizer];
+    }
+    
     switch (recognizer.state)
     {
         case UIGestureRecognizerStateBegan:
@@ -730,15 +1092,109 @@ typedef struct
     }
 }
 
+#pragma mark Gesture Gating
+
+- (BOOL)gestureRecognizerShouldBegin:(UIGestureRecognizer *)gestureRecognizer
+{
+    if (gestureRecognizer == self.revealResetTapGestureRecognizer)
+    {
+        switch (self.state)
+        {
+            case PKRevealControllerShowsLeftViewController:
+            case PKRevealControllerShowsRightViewController:
+                return self.recognizesResetTapOnFrontView;
+                
+            case PKRevealControllerShowsLeftViewControllerInPresentationMode:
+            case PKRevealControllerShowsRightViewControllerInPresentationMode:
+                return self.recognizesResetTapOnFrontViewInPresentationMode;
+                
+            default:
+                return NO;
+        }
+    }
+    
+    return YES;
+}
+
+/*
+ * With the pan limited to the edges, touches elsewhere never reach the recognizer while the front view is
+ * focused, so it does not take part in the arbitration of ordinary scrolling.
+ */
+- (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldReceiveTouch:(UITouch *)touch
+{
+    if (gestureRecognizer != self.revealPanGestureRecognizer || self.revealPanRegion != PKRevealControllerPanRegionEdges)
+    {
+        return YES;
+    }
+    
+    return PKRevealCoreIsEdgePanTouch(&[self geometry]->core,
+                                      (PKRevealCoreState)self.state,
+                                      [touch locationInView:self.frontView].x,
+                                      CGRectGetWidth(self.frontView.bounds),
+                                      self.revealPanEdgeInsets.left,
+                                      self.revealPanEdgeInsets.right);
+}
+
+/*
+ * Horizontally scrolling content embedded in the front view, e.g. a carousel, takes precedence over the
+ * reveal pan, unless the pan is limited to the edges and therefore already started at one. Whether a
+ * recognizer belongs to such a scroll view is resolved once per recognizer and cached until the front view
+ * controller changes, as UIKit asks for every pair of recognizers on a touch.
+ */
+- (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldRequireFailureOfGestureRecognizer:(UIGestureRecognizer *)otherGestureRecognizer
+{
+    if (gestureRecognizer != self.revealPanGestureRecognizer || self.revealPanRegion == PKRevealControllerPanRegionEdges)
+    {
+        return NO;
+    }
+    
+    UIScrollView *scrollView = [self embeddedScrollViewForGestureRecognizer:otherGestureRecognizer];
+    
+    return (scrollView && scrollView.contentSize.width > CGRectGetWidth(scrollView.bounds));
+}
+
+- (UIScrollView *)embeddedScrollViewForGestureRecognizer:(UIGestureRecognizer *)gestureRecognizer
+{
+    id scrollView = [self.embeddedScrollViewRecognizers objectForKey:gestureRecognizer];
+    
+    if (!scrollView)
+    {
+        UIView *view = gestureRecognizer.view;
+        BOOL isEmbedded = ([view isKindOfClass:[UIScrollView class]] &&
+                           gestureRecognizer == ((UIScrollView *)view).panGestureRecognizer &&
+                           [view isDescendantOfView:self.frontView]);
+        
+        scrollView = isEmbedded ? view : [NSNull null];
+        [self.embeddedScrollViewRecognizers setObject:scrollView forKey:gestureRecognizer];
+    }
+    
+    return (scrollView != [NSNull null]) ? scrollView : nil;
+}
+
 #pragma mark Gesture Handling
 
 - (void)handlePanGestureBeganWithRecognizer:(UIPanGestureRecognizer *)recognizer
 {
-    [self.animator stopAnimationForKey:kPKRevealControllerFrontViewTranslationAnimationKey];
+    PKTraceBegin("pan", self, "state", self.state);
+    
+    if (self.collectsTelemetry)
+    {
+        [self beginTransitionTelemetryInteractive:YES];
+    }
+    
+    _frontViewInteraction.interruptedVelocity = [self frontViewVelocity];
+    [self.interactiveAnimator interruptAnimation];
+    [self stopKeyframeTransition];
+    [self setupRearContainerViewsIfNeeded];
+    [self updateRevealTransforms];
+    [self setFrontViewMoving:YES];
     
     _frontViewInteraction.recognizerFlags.initialTouchPoint = [recognizer translationInView:self.frontView];
     _frontViewInteraction.recognizerFlags.previousTouchPoint = _frontViewInteraction.recognizerFlags.initialTouchPoint;
-    _frontViewInteraction.initialFrontViewPosition = self.frontView.layer.position;
+    
+    // Starts from the undampened position, such that a pan resumed during overdraw does not make the front view jump.
+    CGPoint position = self.frontView.layer.position;
+    _frontViewInteraction.initialFrontViewPosition = CGPointMake(PKRevealCorePanOrigin(&[self geometry]->core, position.x), position.y);
     _frontViewInteraction.isInteracting = YES;
     
     [self updateRearViewVisibility];
@@ -746,140 +1202,245 @@ typedef struct
 
 - (void)handlePanGestureChangedWithRecognizer:(UIPanGestureRecognizer *)recognizer
 {
-    _frontViewInteraction.recognizerFlags.currentTouchPoint = [recognizer translationInView:self.frontView];
-    CGFloat newX = _frontViewInteraction.initialFrontViewPosition.x + (_frontViewInteraction.recognizerFlags.initialTouchPoint.x + _frontViewInteraction.recognizerFlags.currentTouchPoint.x);
+    CALayer *frontLayer = self.frontView.layer;
+    CGPoint currentPosition = frontLayer.position;
     
-    if (![self hasLeftViewController] && newX >= [self centerPointForState:PKRevealControllerShowsFrontViewController].x)
-    {
-        newX = [self centerPointForState:PKRevealControllerShowsFrontViewController].x;
-    }
-    else if (![self hasRightViewController] && newX <= [self centerPointForState:PKRevealControllerShowsFrontViewController].x)
-    {
-        newX = [self centerPointForState:PKRevealControllerShowsFrontViewController].x;
-    }
-    else
-    {
-        CGFloat dampenedLeft = [self dampenedValueForRealValue:(newX - CGRectGetMidX(self.frontView.bounds)) inRange:self.leftViewWidthRange] + CGRectGetMidX(self.frontView.bounds);
-        CGFloat dampenedRight = [self dampenedValueForRealValue:(newX - CGRectGetMidX(self.frontView.bounds)) inRange:self.rightViewWidthRange] + CGRectGetMidX(self.frontView.bounds);
-        
-        if (newX >= [self centerPointForState:PKRevealControllerShowsLeftViewControllerInPresentationMode].x &&
-            !([self centerPointForState:PKRevealControllerShowsLeftViewControllerInPresentationMode].x >= dampenedLeft))
-        {
-            newX = self.frontView.layer.position.x;
-        }
-        else if (newX <= [self centerPointForState:PKRevealControllerShowsRightViewControllerInPresentationMode].x &&
-                 !([self centerPointForState:PKRevealControllerShowsRightViewControllerInPresentationMode].x <= dampenedRight))
-        {
-            newX = self.frontView.layer.position.x;
-        }
-        else if (newX >= [self centerPointForState:PKRevealControllerShowsLeftViewController].x)
-        {
-            newX = dampenedLeft;
-        }
-        else if (newX <= [self centerPointForState:PKRevealControllerShowsRightViewController].x)
-        {
-            newX = dampenedRight;
-        }
-    }
+    _frontViewInteraction.recognizerFlags.currentTouchPoint = [recognizer translationInView:self.frontView];
+    CGFloat proposedX = PKRevealCoreProposedPanPosition(_frontViewInteraction.initialFrontViewPosition.x,
+                                                        _frontViewInteraction.recognizerFlags.initialTouchPoint.x,
+                                                        _frontViewInteraction.recognizerFlags.currentTouchPoint.x);
+    CGFloat newX = PKRevealCoreFrontViewPositionForPan(&[self geometry]->core, proposedX, currentPosition.x);
     
-    self.frontView.layer.position = CGPointMake(newX, self.frontView.layer.position.y);
-    [self updateRearViewVisibility];
+    frontLayer.position = CGPointMake(newX, currentPosition.y);
+    [self.progressMonitor setNeedsUpdateWithInteractivePosition:newX];
+    [self updateRevealTransformsForFrontViewPosition:newX];
+    [self.updateScheduler setNeedsUpdate:[self updatesForFrontViewPosition:newX]];
     
     _frontViewInteraction.recognizerFlags.previousTouchPoint = _frontViewInteraction.recognizerFlags.currentTouchPoint;
 }
 
 - (void)handlePanGestureEndedWithRecognizer:(UIPanGestureRecognizer *)recognizer
 {
+    // The release is resolved against the state of the last pan event.
+    [self.updateScheduler flush];
+    
     _frontViewInteraction.recognizerFlags.initialTouchPoint = CGPointZero;
     _frontViewInteraction.recognizerFlags.previousTouchPoint = CGPointZero;
     _frontViewInteraction.recognizerFlags.currentTouchPoint = CGPointZero;
     _frontViewInteraction.initialFrontViewPosition = CGPointZero;
     _frontViewInteraction.isInteracting = NO;
     
-    if ([self shouldMoveFrontViewLeftwardsForVelocity:[recognizer velocityInView:self.view].x])
+    // A cancelled pan has no release velocity, the transition it interrupted is carried on instead.
+    CGFloat velocity = [recognizer velocityInView:self.view].x;
+    
+    if (recognizer.state == UIGestureRecognizerStateCancelled)
     {
-        PKRevealControllerState toState = PKRevealControllerShowsFrontViewController;
-        
-        if (self.state == PKRevealControllerShowsRightViewController ||
-            self.state == PKRevealControllerShowsRightViewControllerInPresentationMode)
-        {
-            toState = self.state;
-        }
-        else if (self.state == PKRevealControllerShowsFrontViewController && [self hasRightViewController])
-        {
-            toState = PKRevealControllerShowsRightViewController;
-        }
-        
-        [self animateToState:toState completion:nil];
+        velocity = _frontViewInteraction.interruptedVelocity;
     }
-    else if ([self shouldMoveFrontViewRightwardsForVelocity:[recognizer velocityInView:self.frontView].x])
+    
+    _frontViewInteraction.interruptedVelocity = 0.0;
+    
+    PKRevealControllerState toState;
+    
+    if (self.projectsMomentum)
     {
-        PKRevealControllerState toState = PKRevealControllerShowsFrontViewController;
-        
-        if (self.state == PKRevealControllerShowsFrontViewController && [self hasLeftViewController])
-        {
-            toState = PKRevealControllerShowsLeftViewController;
-        }
-        else if (self.state == PKRevealControllerShowsLeftViewController ||
-                 self.state == PKRevealControllerShowsLeftViewControllerInPresentationMode)
-        {
-            toState = self.state;
-        }
-        
-        [self animateToState:toState completion:nil];
+        toState = (PKRevealControllerState)PKRevealCoreStateForProjectedRelease(&[self geometry]->core,
+                                                                                self.frontView.layer.position.x,
+                                                                                velocity,
+                                                                                self.decelerationRate,
+                                                                                self.allowsOverdraw);
     }
     else
     {
-        [self snapFrontViewToAppropriateEdge];
+        toState = (PKRevealControllerState)PKRevealCoreStateForPanRelease(&[self geometry]->core,
+                                                                          (PKRevealCoreState)self.state,
+                                                                          self.frontView.layer.position.x,
+                                                                          velocity,
+                                                                          self.quickSwipeVelocity);
     }
+    
+    PKTraceEnd("pan", self, "state", toState);
+    
+    [self settleToState:toState velocity:velocity completion:nil];
 }
 
-#pragma mark - Math
+#pragma mark Reveal Progress
 
-- (CGFloat)dampenedValueForRealValue:(CGFloat)realValue inRange:(NSRange)absoluteRange
+- (PKRevealProgressMonitor *)progressMonitor
 {
-    BOOL isNegative = (realValue < 0);
-    
-    realValue = fabs(realValue);
-    
-    // PKLog(@"Range: [%u, %u], Real Value: %f", absoluteRange.location, (absoluteRange.location + absoluteRange.length), realValue);
-    
-    NSRange unitRange = NSMakeRange(0.0, 1.0);
-    
-    CGFloat (^LinearMap)(CGFloat x, NSRange from, NSRange to) = ^(CGFloat x, NSRange from, NSRange to)
+    if (!_progressMonitor)
     {
-        // [a1, b1] -> [a2, b2]
-        CGFloat a1 = from.location;
-        CGFloat b1 = from.location + from.length;
-        
-        CGFloat a2 = to.location;
-        CGFloat b2 = to.location + to.length;
+        _progressMonitor = [PKRevealProgressMonitor monitorForLayer:self.frontView.layer];
         
-        return ((x - a1) * (b2 - a2) / (b1 - a1)) + a2;
-    };
+        __weak PKRevealController *weakSelf = self;
+        _progressMonitor.progressForPosition = ^PKRevealCoreRevealProgress(CGFloat position)
+        {
+            PKRevealController *strongSelf = weakSelf;
+            PKRevealCoreRevealProgress progress = { 0.0, 0.0 };
+            
+            return strongSelf ? PKRevealCoreRevealProgressForPosition(&[strongSelf geometry]->core, position) : progress;
+        };
+    }
     
-    CGFloat unitValue = LinearMap(realValue, absoluteRange, unitRange);
+    return _progressMonitor;
+}
+
+- (id)addRevealProgressObserverForEvents:(PKRevealControllerProgressEvents)events
+                              usingBlock:(PKRevealControllerProgressHandler)handler
+{
+    return [self.progressMonitor addObserverForEvents:(PKRevealProgressEvents)events usingBlock:^(PKRevealCoreRevealProgress progress, PKRevealProgressEvents progressEvents)
+    {
+        handler(progress.left, progress.right, (PKRevealControllerProgressEvents)progressEvents);
+    }];
+}
+
+- (void)removeRevealProgressObserver:(id)observer
+{
+    [self.progressMonitor removeObserver:observer];
+}
+
+#pragma mark Gesture Trace
+
+- (void)setRecordsGestureTrace:(BOOL)recordsGestureTrace
+{
+    if (recordsGestureTrace && !_recordsGestureTrace)
+    {
+        [self resetGestureTrace];
+    }
     
-    // PKLog(@"Mapped (To Unit): %f -> %f", realValue, unitValue);
+    _recordsGestureTrace = recordsGestureTrace;
+}
+
+- (NSData *)gestureTrace
+{
+    return [self.gestureTraceData copy];
+}
+
+- (void)resetGestureTrace
+{
+    self.gestureTraceData = nil;
+}
+
+- (void)recordGestureTraceSampleWithRecognizer:(UIPanGestureRecognizer *)recognizer
+{
+    PKRevealCoreTraceSampleKind kind;
     
-    CGFloat (^UnitDampening)(CGFloat x) = ^(CGFloat x)
+    switch (recognizer.state)
     {
-        // Dampening Function.
-        return (CGFloat)((2.5 / M_PI) * atanf(x));
-    };
+        case UIGestureRecognizerStateBegan:
+            kind = PKRevealCoreTraceSampleKindPanBegan;
+            break;
+            
+        case UIGestureRecognizerStateChanged:
+            kind = PKRevealCoreTraceSampleKindPanChanged;
+            break;
+            
+        default:
+            kind = PKRevealCoreTraceSampleKindPanEnded;
+            break;
+    }
+    
+    [self recordGestureTraceSampleOfKind:kind
+                                   state:self.state
+                             translation:[recognizer translationInView:self.frontView].x
+                                velocity:[recognizer velocityInView:self.view].x];
+}
+
+- (void)recordGestureTraceSampleOfKind:(PKRevealCoreTraceSampleKind)kind
+                                 state:(PKRevealControllerState)state
+                           translation:(CGFloat)translation
+                              velocity:(CGFloat)velocity
+{
+    if (!self.gestureTraceData)
+    {
+        const PKRevealControllerGeometry *geometry = [self geometry];
+        PKRevealCoreTraceHeader header;
+        uint8_t headerBytes[PKRevealCoreTraceHeaderSize + PKRevealCoreTraceDampeningTableSize];
+        
+        header.leftRange = geometry->core.leftRange;
+        header.rightRange = geometry->core.rightRange;
+        header.midX = geometry->core.midX;
+        header.initialPosition = self.frontView.layer.position.x;
+        header.quickSwipeVelocity = self.quickSwipeVelocity;
+        header.decelerationRate = self.decelerationRate;
+        header.animationDuration = self.animationDuration;
+        header.spring = PKRevealCoreSpringMake(self.springMass, self.springStiffness, self.springDamping);
+        header.dampening = geometry->core.dampening;
+        header.initialState = (PKRevealCoreState)self.state;
+        header.hasLeft = geometry->core.hasLeft;
+        header.hasRight = geometry->core.hasRight;
+        header.projectsMomentum = self.projectsMomentum;
+        header.includesPresentationModes = self.allowsOverdraw;
+        header.usesSpring = (self.animationTiming == PKRevealControllerAnimationTimingSpring);
+        
+        PKRevealCoreTraceEncodeHeader(&header, headerBytes);
+        self.gestureTraceData = [NSMutableData dataWithBytes:headerBytes length:PKRevealCoreTraceHeaderLength(&header)];
+    }
+    
+    PKRevealCoreTraceSample sample;
+    uint8_t sampleBytes[PKRevealCoreTraceSampleSize];
+    
+    sample.time = CACurrentMediaTime();
+    sample.translation = (float)translation;
+    sample.velocity = (float)velocity;
+    sample.kind = kind;
+    sample.state = (PKRevealCoreState)state;
     
-    CGFloat dampenedUnitValue = UnitDampening(unitValue);
+    PKRevealCoreTraceEncodeSample(&sample, sampleBytes);
+    [self.gestureTraceData appendBytes:sampleBytes length:sizeof(sampleBytes)];
+}
+
+#pragma mark Telemetry
+
+- (void)setCollectsTelemetry:(BOOL)collectsTelemetry
+{
+    if (!collectsTelemetry)
+    {
+        PKRevealCoreTransitionSample sample;
+        [self.transitionMonitor endTransitionToState:(PKRevealCoreState)self.state sample:&sample];
+        self.transitionMonitor = nil;
+    }
     
-    // PKLog(@"Dampened: %f -> %f", unitValue, dampenedUnitValue);
+    _collectsTelemetry = collectsTelemetry;
+}
+
+- (PKRevealControllerTelemetry *)telemetrySnapshot
+{
+    return [[PKRevealControllerTelemetry alloc] initWithTelemetry:&_telemetry];
+}
+
+- (void)resetTelemetry
+{
+    PKRevealCoreTelemetryReset(&_telemetry);
+}
+
+- (void)beginTransitionTelemetryInteractive:(BOOL)interactive
+{
+    if (!self.transitionMonitor)
+    {
+        self.transitionMonitor = [PKTransitionMonitor monitorForLayer:self.frontView.layer];
+    }
     
-    CGFloat result = LinearMap(dampenedUnitValue, unitRange, absoluteRange);
+    // A transition that is still in flight was interrupted by this one and ends where it was interrupted.
+    [self finishTransitionTelemetry];
+    [self.transitionMonitor beginTransitionFromState:(PKRevealCoreState)self.state interactive:interactive];
+}
+
+- (void)finishTransitionTelemetry
+{
+    PKRevealCoreTransitionSample sample;
     
-    if (isNegative)
+    if (![self.transitionMonitor endTransitionToState:(PKRevealCoreState)self.state sample:&sample])
     {
-        result = -result;
+        return;
     }
     
-    return result;
+    PKRevealCoreTelemetryRecord(&_telemetry, &sample);
+    
+    if (_delegateFlags.didFinishTransitionWithMetrics)
+    {
+        [self.delegate revealController:self didFinishTransitionWithMetrics:[[PKRevealControllerTransitionMetrics alloc] initWithSample:&sample]];
+    }
 }
 
 #pragma mark - Internal
@@ -890,20 +1451,24 @@ typedef struct
     {
         [self willChangeValueForKey:@"state"];
         
-        if (self.delegate &&
-            [self.delegate conformsToProtocol:@protocol(PKRevealing)] &&
-            [self.delegate respondsToSelector:@selector(revealController:willChangeToState:)])
+        if (_delegateFlags.willChangeToState)
         {
             [self.delegate revealController:self willChangeToState:state];
         }
         
+        PKTraceInstant("state", NULL, "from", _state, "to", state);
+        
+        if (self.recordsGestureTrace)
+        {
+            [self recordGestureTraceSampleOfKind:PKRevealCoreTraceSampleKindStateChange state:state translation:0.0 velocity:0.0];
+        }
+        
         _state = state;
+        [self rootView].revealState = state;
         
         [self didChangeValueForKey:@"state"];
         
-        if (self.delegate &&
-            [self.delegate conformsToProtocol:@protocol(PKRevealing)] &&
-            [self.delegate respondsToSelector:@selector(revealController:didChangeToState:)])
+        if (_delegateFlags.didChangeToState)
         {
             [self.delegate revealController:self didChangeToState:state];
         }
@@ -912,11 +1477,15 @@ typedef struct
 
 - (void)updateRearViewVisibilityForFrontViewPosition:(CGPoint)position
 {
-    if (position.x > [self centerPointForState:PKRevealControllerShowsFrontViewController].x)
+    [self.updateScheduler cancel];
+    
+    CGFloat frontX = PKRevealControllerGeometryCenterPoint([self geometry], PKRevealControllerShowsFrontViewController).x;
+    
+    if (position.x > frontX)
     {
         [self showLeftView];
     }
-    else if (position.x < [self centerPointForState:PKRevealControllerShowsFrontViewController].x)
+    else if (position.x < frontX)
     {
         [self showRightView];
     }
@@ -930,23 +1499,28 @@ typedef struct
 
 - (void)updateRearViewVisibility
 {
+    [self.updateScheduler cancel];
+    
+    BOOL isLeftViewHidden = (!self.leftView || self.leftView.hidden);
+    BOOL isRightViewHidden = (!self.rightView || self.rightView.hidden);
+    
     if ([self isLeftViewVisible])
     {
-        if (self.leftView.hidden)
+        if (isLeftViewHidden)
         {
             [self showLeftView];
         }
     }
     else if ([self isRightViewVisible])
     {
-        if (self.rightView.hidden)
+        if (isRightViewHidden)
         {
             [self showRightView];
         }
     }
     else
     {
-        if (!self.leftView.hidden || !self.rightView.hidden)
+        if (!isLeftViewHidden || !isRightViewHidden)
         {
             [self hideRearViews];
         }
@@ -955,29 +1529,71 @@ typedef struct
     self.state = [self stateForCurrentFrontViewPosition];
 }
 
-- (void)updateTapGestureRecognizerPrecence
+/*
+ * Pan events can arrive several times per display frame. They only record which of the rear view
+ * visibility and the state are out of date, and the update scheduler applies them once before the
+ * frame is committed.
+ */
+- (PKRevealControllerUpdates)updatesForFrontViewPosition:(CGFloat)x
 {
-    if ((self.state == PKRevealControllerShowsRightViewControllerInPresentationMode ||
-        self.state == PKRevealControllerShowsLeftViewControllerInPresentationMode) &&
-        self.recognizesResetTapOnFrontViewInPresentationMode)
+    const PKRevealCoreGeometry *geometry = &[self geometry]->core;
+    PKRevealControllerUpdates updates = 0;
+    
+    BOOL isLeftViewHidden = (!self.leftView || self.leftView.hidden);
+    BOOL isRightViewHidden = (!self.rightView || self.rightView.hidden);
+    
+    if ((x > geometry->midX) == isLeftViewHidden || (x < geometry->midX) == isRightViewHidden)
     {
-        if(![self.frontView.gestureRecognizers containsObject:self.revealResetTapGestureRecognizer])
-        {
-            [self.frontView addGestureRecognizer:self.revealResetTapGestureRecognizer];
-        }
+        updates |= PKRevealControllerUpdateRearVisibility;
+    }
+    
+    if ((PKRevealControllerState)PKRevealCoreStateForPosition(geometry, x) != self.state)
+    {
+        updates |= PKRevealControllerUpdateState;
+    }
+    
+    return updates;
+}
+
+- (void)performUpdates:(PKRevealControllerUpdates)updates
+{
+    if (updates & PKRevealControllerUpdateRearVisibility)
+    {
+        [self updateRearViewVisibilityForFrontViewPosition:self.frontView.layer.position];
+    }
+    else if (updates & PKRevealControllerUpdateState)
+    {
+        self.state = (PKRevealControllerState)PKRevealCoreStateForPosition(&[self geometry]->core, self.frontView.layer.position.x);
     }
-    else if ((self.state == PKRevealControllerShowsLeftViewController ||
-              self.state == PKRevealControllerShowsRightViewController) &&
-             self.recognizesResetTapOnFrontView)
+}
+
+- (NSUInteger)rearVisibilityUpdateCount
+{
+    return self.updateScheduler.updateCount;
+}
+
+- (NSUInteger)elidedRearVisibilityUpdateCount
+{
+    return self.updateScheduler.elidedCount;
+}
+
+/*
+ * Recognizers are only added or removed when the recognizesPanningOnFrontView and recognizesResetTapOnFrontView
+ * properties change, never per transition.
+ * Whether the reset tap applies to the current state is decided in -gestureRecognizerShouldBegin:.
+ */
+- (void)updateTapGestureRecognizerPrecence
+{
+    if (self.recognizesResetTapOnFrontView || self.recognizesResetTapOnFrontViewInPresentationMode)
     {
-        if(![self.frontView.gestureRecognizers containsObject:self.revealResetTapGestureRecognizer])
+        if (self.revealResetTapGestureRecognizer.view != self.frontView)
         {
             [self.frontView addGestureRecognizer:self.revealResetTapGestureRecognizer];
         }
     }
     else
     {
-        if ([self.frontView.gestureRecognizers containsObject:self.revealResetTapGestureRecognizer])
+        if (self.revealResetTapGestureRecognizer.view == self.frontView)
         {
             [self.frontView removeGestureRecognizer:self.revealResetTapGestureRecognizer];
         }
@@ -988,14 +1604,14 @@ typedef struct
 {
     if (self.recognizesPanningOnFrontView)
     {
-        if (![self.frontView.gestureRecognizers containsObject:self.revealPanGestureRecognizer])
+        if (self.revealPanGestureRecognizer.view != self.frontView)
         {
             [self.frontView addGestureRecognizer:self.revealPanGestureRecognizer];
         }
     }
     else
     {
-        if ([self.frontView.gestureRecognizers containsObject:self.revealPanGestureRecognizer])
+        if (self.revealPanGestureRecognizer.view == self.frontView)
         {
             [self.frontView removeGestureRecognizer:self.revealPanGestureRecognizer];
         }
@@ -1006,86 +1622,172 @@ typedef struct
 {
     self.rightView.hidden = YES;
     self.leftView.hidden = YES;
-    [self removeViewController:self.leftViewController];
-    [self removeViewController:self.rightViewController];
+    [self rearViewControllerDidHide:self.leftViewController];
+    [self rearViewControllerDidHide:self.rightViewController];
     [self.frontView setUserInteractionForContainedViewEnabled:YES];
 }
 
 - (void)showRightView
 {
+    [self setupRearContainerViewsIfNeeded];
+    [self cancelScheduledRearDetach];
+    
     self.rightView.hidden = NO;
     self.leftView.hidden = YES;
-    [self removeViewController:self.leftViewController];
+    [self rearViewControllerDidHide:self.leftViewController];
     [self addViewController:self.rightViewController container:self.rightView];
     [self.frontView setUserInteractionForContainedViewEnabled:NO];
+    
+    if (_frontViewInteraction.isMoving)
+    {
+        [self.rightView beginSnapshotting];
+    }
 }
 
 - (void)showLeftView
 {
+    [self setupRearContainerViewsIfNeeded];
+    [self cancelScheduledRearDetach];
+    
     self.rightView.hidden = YES;
     self.leftView.hidden = NO;
-    [self removeViewController:self.rightViewController];
+    [self rearViewControllerDidHide:self.rightViewController];
     [self addViewController:self.leftViewController container:self.leftView];
     [self.frontView setUserInteractionForContainedViewEnabled:NO];
+    
+    if (_frontViewInteraction.isMoving)
+    {
+        [self.leftView beginSnapshotting];
+    }
+}
+
+- (void)setFrontViewMoving:(BOOL)moving
+{
+    _frontViewInteraction.isMoving = moving;
+    [self rootView].routesTouches = !moving;
+    
+    if (moving)
+    {
+        _frontViewInteraction.movingGeneration++;
+        
+        [self.leftView beginSnapshotting];
+        [self.rightView beginSnapshotting];
+        [self.progressMonitor beginMonitoring];
+    }
+    else
+    {
+        [self.leftView endSnapshotting];
+        [self.rightView endSnapshotting];
+        [self.progressMonitor endMonitoring];
+    }
+}
+
+- (void)endFrontViewMovingOfGeneration:(NSUInteger)generation
+{
+    if (_frontViewInteraction.isMoving && _frontViewInteraction.movingGeneration == generation)
+    {
+        [self setFrontViewMoving:NO];
+    }
 }
 
 - (BOOL)isLeftViewVisible
 {
     CALayer *layer = [self frontViewLayer];
-    return (layer.position.x > CGRectGetMidX(self.view.bounds));
+    return (layer.position.x > [self geometry]->core.midX);
 }
 
 - (BOOL)isRightViewVisible
 {
     CALayer *layer = [self frontViewLayer];
-    return (layer.position.x < CGRectGetMidX(self.view.bounds));
+    return (layer.position.x < [self geometry]->core.midX);
 }
 
 - (void)snapFrontViewToAppropriateEdge
 {
-    CGFloat visibleWidth = 0.0;
-    
-    PKRevealControllerState toState = PKRevealControllerShowsFrontViewController;
-    
-    if ([self isLeftViewVisible])
+    PKRevealCoreState toState = PKRevealCoreSnapState(&[self geometry]->core, self.frontView.layer.position.x);
+    [self animateToState:(PKRevealControllerState)toState completion:nil];
+}
+
+#pragma mark - View Controller Containment
+
+- (void)rearViewControllerDidHide:(UIViewController *)childController
+{
+    switch (self.rearContainmentPolicy)
     {
-        visibleWidth = self.frontView.layer.position.x - self.leftView.layer.position.x;
-        
-        if (visibleWidth > ([self leftViewMinWidth] / 2.0))
+        case PKRevealControllerRearContainmentPolicyDetachWhenHidden:
         {
-            toState = PKRevealControllerShowsLeftViewController;
+            [self removeViewController:childController];
         }
-    }
-    else if ([self isRightViewVisible])
-    {
-        visibleWidth = self.rightView.layer.position.x - self.frontView.layer.position.x;
-        
-        if (visibleWidth > ([self rightViewMinWidth] / 2.0))
+            break;
+            
+        case PKRevealControllerRearContainmentPolicyDetachAfterTimeout:
         {
-            toState = PKRevealControllerShowsRightViewController;
+            if ([self.childViewControllers containsObject:childController])
+            {
+                [self scheduleRearDetach];
+            }
         }
+            break;
+            
+        case PKRevealControllerRearContainmentPolicyKeepAttached:
+        default:
+            break;
     }
+}
+
+/*
+ * A pending detach holds the controller weakly and is cancelled by advancing the generation, such that neither
+ * a long timeout nor a disappearing controller keeps the controller and its rear view controllers alive.
+ */
+- (void)scheduleRearDetach
+{
+    NSUInteger generation = ++_rearDetachGeneration;
+    __weak PKRevealController *weakSelf = self;
     
-    [self animateToState:toState completion:nil];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.rearDetachTimeout * NSEC_PER_SEC)), dispatch_get_main_queue(), ^
+    {
+        [weakSelf detachHiddenRearViewControllersOfGeneration:generation];
+    });
 }
 
-- (BOOL)shouldMoveFrontViewRightwardsForVelocity:(CGFloat)velocity
+- (void)cancelScheduledRearDetach
 {
-    return (velocity > 0 && velocity > self.quickSwipeVelocity);
+    _rearDetachGeneration++;
 }
 
-- (BOOL)shouldMoveFrontViewLeftwardsForVelocity:(CGFloat)velocity
+- (void)detachHiddenRearViewControllersOfGeneration:(NSUInteger)generation
 {
-    return (velocity < 0 && fabs(velocity) > self.quickSwipeVelocity);
+    if (generation == _rearDetachGeneration)
+    {
+        [self detachHiddenRearViewControllers];
+    }
 }
 
-#pragma mark - View Controller Containment
+- (void)detachHiddenRearViewControllers
+{
+    if (!self.leftView || self.leftView.hidden)
+    {
+        [self removeViewController:self.leftViewController];
+    }
+    
+    if (!self.rightView || self.rightView.hidden)
+    {
+        [self removeViewController:self.rightViewController];
+    }
+}
 
 - (void)addViewController:(UIViewController *)childController container:(UIView *)container
 {
     if (childController &&
         ![self.childViewControllers containsObject:childController])
     {
+        if (childController != self.frontViewController)
+        {
+            self.rearAttachCount++;
+        }
+        
+        PKTraceInstant("attach", object_getClassName(childController), NULL, 0, NULL, 0);
+        
         [self addChildViewController:childController];
         childController.view.frame = container.bounds;
         childController.view.autoresizingMask = (UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight);
@@ -1102,6 +1804,13 @@ typedef struct
 {
     if (childController && [self.childViewControllers containsObject:childController])
     {
+        if (childController != self.frontViewController)
+        {
+            self.rearDetachCount++;
+        }
+        
+        PKTraceInstant("detach", object_getClassName(childController), NULL, 0, NULL, 0);
+        
         [childController willMoveToParentViewController:nil];
         [childController.view removeFromSuperview];
         [childController removeFromParentViewController];
@@ -1113,17 +1822,40 @@ typedef struct
 
 - (void)animateToState:(PKRevealControllerState)toState completion:(PKDefaultCompletionHandler)completion
 {
+    if (self.collectsTelemetry)
+    {
+        [self beginTransitionTelemetryInteractive:NO];
+    }
+    
+    if (self.animationTiming == PKRevealControllerAnimationTimingSpring)
+    {
+        [self settleToState:toState velocity:[self frontViewVelocity] completion:completion];
+        return;
+    }
+    
+    [self.interactiveAnimator interruptAnimation];
     [self updateRearViewVisibility];
-    [self.animator stopAnimationForKey:kPKRevealControllerFrontViewTranslationAnimationKey];
+    [self stopKeyframeTransition];
+    [self setFrontViewMoving:YES];
+    
+    CGFloat fromX = self.frontView.layer.position.x;
     
-    PKSequentialAnimation *animation = [PKSequentialAnimation animationForKeyPath:@"position"
-                                                                           values:[self keyPositionsToState:toState]
-                                                                         duration:self.animationDuration];
+    _keyframeTransition.beginTime = CACurrentMediaTime();
+    _keyframeTransition.duration = self.animationDuration;
+    _keyframeTransition.fromX = fromX;
+    _keyframeTransition.waypoints = PKRevealCorePlanRoute(&[self geometry]->core, (PKRevealCoreState)self.state, (PKRevealCoreState)toState);
+    self.keyframeTimingCurve = [self animationTimingCurve];
+    
+    PKSequentialAnimation *animation = [self.animationPool sequentialAnimationForKeyPath:@"position"
+                                                                                  values:[self keyPositionsToState:toState]
+                                                                                duration:self.animationDuration];
+    animation.mode = PKSequentialAnimationModeKeyframe;
+    animation.timingCurve = self.keyframeTimingCurve;
     
     __weak PKRevealController *weakSelf = self;
     animation.progressHandler = ^(NSValue *fromValue, NSValue *toValue, NSUInteger index)
     {
-        if ([fromValue CGPointValue].x == [weakSelf centerPointForState:PKRevealControllerShowsFrontViewController].x)
+        if ([fromValue CGPointValue].x == [weakSelf geometry]->core.midX)
         {
             [weakSelf updateRearViewVisibilityForFrontViewPosition:[toValue CGPointValue]];
         }
@@ -1133,15 +1865,147 @@ typedef struct
         }
     };
     
-    animation.completionHandler = ^(BOOL finished)
+    animation.completionHandler = [self animationCompletionHandlerWithCompletion:completion];
+    
+    [self.animator addSequentialAnimation:animation forKey:kPKRevealControllerFrontViewTranslationAnimationKey];
+    [self.animator startAnimationForKey:kPKRevealControllerFrontViewTranslationAnimationKey];
+    
+    [self animateRevealTransformsFromFrontViewPosition:fromX toState:toState];
+}
+
+- (void)settleToState:(PKRevealControllerState)toState velocity:(CGFloat)velocity completion:(PKDefaultCompletionHandler)completion
+{
+    [self stopKeyframeTransition];
+    [self updateRevealTransforms];
+    [self setFrontViewMoving:YES];
+    
+    __weak PKRevealController *weakSelf = self;
+    self.interactiveAnimator.progressHandler = ^(CGPoint position)
+    {
+        [weakSelf updateRevealTransformsForFrontViewPosition:position.x];
+        [weakSelf updateRearViewVisibility];
+    };
+    
+    CGPoint position = [self centerPointForState:toState];
+    PKAnimationCompletionBlock completionHandler = [self animationCompletionHandlerWithCompletion:completion];
+    
+    if (self.animationTiming == PKRevealControllerAnimationTimingSpring)
+    {
+        [self.interactiveAnimator animateToPosition:position
+                                           velocity:velocity
+                                             spring:PKRevealCoreSpringMake(self.springMass, self.springStiffness, self.springDamping)
+                                         completion:completionHandler];
+    }
+    else
+    {
+        [self.interactiveAnimator animateToPosition:position
+                                           velocity:velocity
+                                           duration:self.animationDuration
+                                         completion:completionHandler];
+    }
+}
+
+/*
+ * The reveal transforms are a function of the front view's position. Their keyframes are split where that
+ * function changes slope and timed like the front view's keyframes, and all of them are added in the same
+ * transaction, such that they share the front view animation's clock without a per-frame callback.
+ */
+- (void)animateRevealTransformsFromFrontViewPosition:(CGFloat)fromX toState:(PKRevealControllerState)toState
+{
+    [self removeRevealTransformAnimations];
+    
+    if (self.animationType == PKRevealControllerAnimationTypeStatic)
+    {
+        return;
+    }
+    
+    const PKRevealCoreGeometry *geometry = &[self geometry]->core;
+    PKRevealCoreRevealEffect effect = [self revealEffect];
+    PKRevealCoreWaypoints waypoints = PKRevealCorePlanRoute(geometry, (PKRevealCoreState)self.state, (PKRevealCoreState)toState);
+    PKRevealCoreRevealKeyframes keyframes = PKRevealCoreRevealKeyframesForRoute(geometry, fromX, &waypoints);
+    
+    NSValue *frontValues[PKRevealCoreRevealKeyframeCapacity];
+    NSValue *leftValues[PKRevealCoreRevealKeyframeCapacity];
+    NSValue *rightValues[PKRevealCoreRevealKeyframeCapacity];
+    NSNumber *keyTimes[PKRevealCoreRevealKeyframeCapacity];
+    
+    for (size_t index = 0; index < keyframes.count; index++)
+    {
+        PKRevealCoreRevealTransform transform = PKRevealCoreRevealTransformForPosition(geometry, effect, keyframes.positions[index]);
+        
+        frontValues[index] = [NSValue valueWithCATransform3D:CATransform3DMakeScale(transform.frontScale, transform.frontScale, 1.0)];
+        leftValues[index] = [NSValue valueWithCATransform3D:CATransform3DMakeTranslation(transform.leftTranslation, 0.0, 0.0)];
+        rightValues[index] = [NSValue valueWithCATransform3D:CATransform3DMakeTranslation(transform.rightTranslation, 0.0, 0.0)];
+        keyTimes[index] = @(keyframes.keyTimes[index]);
+    }
+    
+    NSArray *times = [NSArray arrayWithObjects:keyTimes count:keyframes.count];
+    CAMediaTimingFunction *timingFunction = [self animationTimingCurve].timingFunction;
+    
+    [self addRevealTransformAnimationToLayer:self.frontView.layer
+                                      values:[NSArray arrayWithObjects:frontValues count:keyframes.count]
+                                    keyTimes:times
+                              timingFunction:timingFunction];
+    [self addRevealTransformAnimationToLayer:self.leftView.layer
+                                      values:[NSArray arrayWithObjects:leftValues count:keyframes.count]
+                                    keyTimes:times
+                              timingFunction:timingFunction];
+    [self addRevealTransformAnimationToLayer:self.rightView.layer
+                                      values:[NSArray arrayWithObjects:rightValues count:keyframes.count]
+                                    keyTimes:times
+                              timingFunction:timingFunction];
+}
+
+- (void)addRevealTransformAnimationToLayer:(CALayer *)layer
+                                    values:(NSArray *)values
+                                  keyTimes:(NSArray *)keyTimes
+                            timingFunction:(CAMediaTimingFunction *)timingFunction
+{
+    if (!layer)
+    {
+        return;
+    }
+    
+    CAKeyframeAnimation *animation = [CAKeyframeAnimation animationWithKeyPath:@"transform"];
+    animation.values = values;
+    animation.keyTimes = keyTimes;
+    animation.timingFunction = timingFunction;
+    animation.duration = self.animationDuration;
+    
+    layer.transform = [[values lastObject] CATransform3DValue];
+    [layer addAnimation:animation forKey:kPKRevealControllerRevealTransformAnimationKey];
+}
+
+- (void)removeRevealTransformAnimations
+{
+    [self.frontView.layer removeAnimationForKey:kPKRevealControllerRevealTransformAnimationKey];
+    [self.leftView.layer removeAnimationForKey:kPKRevealControllerRevealTransformAnimationKey];
+    [self.rightView.layer removeAnimationForKey:kPKRevealControllerRevealTransformAnimationKey];
+}
+
+/*
+ * An interrupted transition reports its completion after the next one already started moving the front view,
+ * either synchronously from the interactive animator or late from Core Animation. Only the transition that
+ * started the current movement ends it.
+ */
+- (PKAnimationCompletionBlock)animationCompletionHandlerWithCompletion:(PKDefaultCompletionHandler)completion
+{
+    __weak PKRevealController *weakSelf = self;
+    NSUInteger movingGeneration = _frontViewInteraction.movingGeneration;
+    
+    return ^(BOOL finished)
     {
         if (finished)
         {
             [weakSelf updateRearViewVisibility];
         }
         
-        [weakSelf updateTapGestureRecognizerPrecence];
-        [weakSelf updatePanGestureRecognizerPresence];
+        [weakSelf endFrontViewMovingOfGeneration:movingGeneration];
+        
+        if (finished)
+        {
+            [weakSelf finishTransitionTelemetry];
+        }
         
         [weakSelf pk_performBlock:^
         {
@@ -1151,119 +2015,120 @@ typedef struct
             }
         } onMainThread:YES];
     };
-    
-    [self.animator addSequentialAnimation:animation forKey:kPKRevealControllerFrontViewTranslationAnimationKey];
-    [self.animator startAnimationForKey:kPKRevealControllerFrontViewTranslationAnimationKey];
 }
 
 #pragma mark Helper
 
-- (NSArray *)keyPositionsToState:(PKRevealControllerState)toState
+/// @return The velocity of the running transition in points per second, to be handed off to whatever takes over.
+- (CGFloat)frontViewVelocity
 {
-    NSArray *keyPositions = nil;
-    PKRevealControllerState fromState = self.state;
-    
-    if (fromState == toState)
+    if (self.interactiveAnimator.isAnimating)
     {
-        keyPositions = [self keyPositionsToState:toState viaFrontView:NO];
-    }
-    else
-    {
-        if (fromState == PKRevealControllerShowsLeftViewControllerInPresentationMode)
-        {
-            if (toState == PKRevealControllerShowsLeftViewController ||
-                toState == PKRevealControllerShowsFrontViewController)
-            {
-                keyPositions = [self keyPositionsToState:toState viaFrontView:NO];
-            }
-            else
-            {
-                keyPositions = [self keyPositionsToState:toState viaFrontView:YES];
-            }
-        }
-        else if (fromState == PKRevealControllerShowsLeftViewController)
-        {
-            if (toState == PKRevealControllerShowsLeftViewControllerInPresentationMode ||
-                toState == PKRevealControllerShowsFrontViewController)
-            {
-                keyPositions = [self keyPositionsToState:toState viaFrontView:NO];
-            }
-            else
-            {
-                keyPositions = [self keyPositionsToState:toState viaFrontView:YES];
-            }
-        }
-        else if (fromState == PKRevealControllerShowsFrontViewController)
-        {
-            keyPositions = [self keyPositionsToState:toState viaFrontView:NO];
-        }
-        else if (fromState == PKRevealControllerShowsRightViewController)
-        {
-            if (toState == PKRevealControllerShowsFrontViewController ||
-                toState == PKRevealControllerShowsRightViewControllerInPresentationMode)
-            {
-                keyPositions = [self keyPositionsToState:toState viaFrontView:NO];
-            }
-            else
-            {
-                keyPositions = [self keyPositionsToState:toState viaFrontView:YES];
-            }
-        }
-        else if (fromState == PKRevealControllerShowsRightViewControllerInPresentationMode)
-        {
-            if (toState == PKRevealControllerShowsRightViewController ||
-                toState == PKRevealControllerShowsFrontViewController)
-            {
-                keyPositions = [self keyPositionsToState:toState viaFrontView:NO];
-            }
-            else
-            {
-                keyPositions = [self keyPositionsToState:toState viaFrontView:YES];
-            }
-        }
+        return self.interactiveAnimator.velocity;
     }
     
-    return keyPositions;
+    return PKRevealCoreRouteVelocity(_keyframeTransition.fromX,
+                                     &_keyframeTransition.waypoints,
+                                     self.keyframeTimingCurve.coreCurve,
+                                     _keyframeTransition.duration,
+                                     CACurrentMediaTime() - _keyframeTransition.beginTime);
+}
+
+- (void)stopKeyframeTransition
+{
+    [self.animator stopAnimationForKey:kPKRevealControllerFrontViewTranslationAnimationKey];
+    _keyframeTransition.duration = 0.0;
 }
 
 - (NSArray *)keyPositionsToState:(PKRevealControllerState)toState
-                    viaFrontView:(BOOL)viaFrontView
 {
-    if (viaFrontView)
-    {
-        return @[[NSValue valueWithCGPoint:[self centerPointForState:PKRevealControllerShowsFrontViewController]],
-                 [NSValue valueWithCGPoint:[self centerPointForState:toState]]];
-    }
-    else
+    const PKRevealControllerGeometry *geometry = [self geometry];
+    PKRevealCoreWaypoints waypoints = PKRevealCorePlanRoute(&geometry->core, (PKRevealCoreState)self.state, (PKRevealCoreState)toState);
+    
+    // The keyframe animation takes boxed values. They are the only objects created for the route.
+    NSValue *keyPositions[PKRevealCoreRouteCapacity];
+    
+    for (size_t index = 0; index < waypoints.count; index++)
     {
-        return @[[NSValue valueWithCGPoint:[self centerPointForState:toState]]];
+        keyPositions[index] = [NSValue valueWithCGPoint:CGPointMake(waypoints.positions[index], geometry->midY)];
     }
+    
+    return [NSArray arrayWithObjects:keyPositions count:waypoints.count];
 }
 
-- (PKRevealControllerState)stateForCurrentFrontViewPosition
+- (PKTimingCurve *)animationTimingCurve
 {
-    CGFloat x = self.frontView.layer.position.x;
-    
-    if (x <= [self centerPointForState:PKRevealControllerShowsRightViewControllerInPresentationMode].x)
+    if (self.timingCurve)
     {
-        return PKRevealControllerShowsRightViewControllerInPresentationMode;
+        return self.timingCurve;
     }
-    else if (x < [self centerPointForState:PKRevealControllerShowsFrontViewController].x)
+    
+    switch (self.animationCurve)
     {
-        return PKRevealControllerShowsRightViewController;
+        case UIViewAnimationCurveEaseIn:
+            return [PKTimingCurve easeInCurve];
+            
+        case UIViewAnimationCurveEaseOut:
+            return [PKTimingCurve easeOutCurve];
+            
+        case UIViewAnimationCurveLinear:
+            return [PKTimingCurve linearCurve];
+            
+        default:
+            return [PKTimingCurve easeInEaseOutCurve];
     }
-    else if (x == [self centerPointForState:PKRevealControllerShowsFrontViewController].x)
+}
+
+- (PKRevealCoreRevealEffect)revealEffect
+{
+    switch (self.animationType)
     {
-        return PKRevealControllerShowsFrontViewController;
+        case PKRevealControllerAnimationTypeParallax:
+            return PKRevealCoreRevealEffectMake(self.parallaxRatio, 1.0);
+            
+        case PKRevealControllerAnimationTypeScale:
+            return PKRevealCoreRevealEffectMake(0.0, self.frontViewScale);
+            
+        default:
+            return PKRevealCoreRevealEffectMake(0.0, 1.0);
     }
-    else if (x < [self centerPointForState:PKRevealControllerShowsLeftViewControllerInPresentationMode].x)
+}
+
+- (void)updateRevealTransforms
+{
+    [self updateRevealTransformsForFrontViewPosition:self.frontView.layer.position.x];
+}
+
+- (void)updateRevealTransformsForFrontViewPosition:(CGFloat)x
+{
+    // Static reveals leave the layers untouched, their transforms are reset when the type changes.
+    if (self.animationType == PKRevealControllerAnimationTypeStatic)
     {
-        return PKRevealControllerShowsLeftViewController;
+        return;
     }
-    else
+    
+    [self applyRevealTransformsForFrontViewPosition:x];
+}
+
+- (void)applyRevealTransformsForFrontViewPosition:(CGFloat)x
+{
+    if (!self.frontView)
     {
-        return PKRevealControllerShowsLeftViewControllerInPresentationMode;
+        return;
     }
+    
+    [self removeRevealTransformAnimations];
+    
+    PKRevealCoreRevealTransform transform = PKRevealCoreRevealTransformForPosition(&[self geometry]->core, [self revealEffect], x);
+    
+    self.frontView.layer.transform = CATransform3DMakeScale(transform.frontScale, transform.frontScale, 1.0);
+    self.leftView.layer.transform = CATransform3DMakeTranslation(transform.leftTranslation, 0.0, 0.0);
+    self.rightView.layer.transform = CATransform3DMakeTranslation(transform.rightTranslation, 0.0, 0.0);
+}
+
+- (PKRevealControllerState)stateForCurrentFrontViewPosition
+{
+    return (PKRevealControllerState)PKRevealCoreStateForPosition(&[self geometry]->core, self.frontView.layer.position.x);
 }
 
 - (PKRevealControllerType)type
@@ -1294,15 +2159,17 @@ typedef struct
     }
     else
     {
+        [self.interactiveAnimator interruptAnimation];
+        [self stopKeyframeTransition];
         [self updateRearViewVisibility];
         CGPoint toPoint = [self centerPointForState:toState];
         
         self.frontView.layer.position = toPoint;
         [(CALayer *)[self.frontView.layer presentationLayer] setPosition:toPoint];
+        [self updateRevealTransformsForFrontViewPosition:toPoint.x];
+        [self.progressMonitor update];
         
         [self updateRearViewVisibility];
-        [self updateTapGestureRecognizerPrecence];
-        [self updatePanGestureRecognizerPresence];
         
         [self pk_performBlock:^
          {
@@ -1314,6 +2181,16 @@ typedef struct
     }
 }
 
+- (PKRevealControllerRootView *)rootView
+{
+    if (![self isViewLoaded] || ![self.view isKindOfClass:[PKRevealControllerRootView class]])
+    {
+        return nil;
+    }
+    
+    return (PKRevealControllerRootView *)self.view;
+}
+
 - (CALayer *)frontViewLayer
 {
     return [self.frontView.layer presentationLayer] ?: self.frontView.layer;
@@ -1323,41 +2200,55 @@ typedef struct
 
 - (CGPoint)centerPointForState:(PKRevealControllerState)state
 {
-    CGPoint center = CGPointMake(self.frontView.layer.position.x, self.frontView.layer.position.y);
+    return PKRevealControllerGeometryCenterPoint([self geometry], state);
+}
+
+- (const PKRevealControllerGeometry *)geometry
+{
+    if (!_geometry.isValid)
+    {
+        [self updateGeometry];
+    }
     
-    switch (state)
+    return &_geometry;
+}
+
+- (void)invalidateGeometry
+{
+    _geometry.isValid = NO;
+}
+
+- (void)updateGeometry
+{
+    CGRect bounds = [self isViewLoaded] ? self.view.bounds : CGRectZero;
+    PKRevealCoreDampening dampening = [self overdrawDampeningTable];
+    
+    _geometry.bounds = bounds;
+    _geometry.midY = CGRectGetMidY(bounds);
+    _geometry.core = PKRevealCoreGeometryMake(CGRectGetMidX(bounds),
+                                              PKRevealCoreWidthRangeFromRange(self.leftViewWidthRange),
+                                              PKRevealCoreWidthRangeFromRange(self.rightViewWidthRange),
+                                              [self hasLeftViewController],
+                                              [self hasRightViewController],
+                                              &dampening);
+    _geometry.isValid = YES;
+}
+
+/*
+ * The dampening curve is sampled into a table along with the rest of the geometry, i.e. only when the
+ * bounds, the width ranges or the curve change.
+ */
+- (PKRevealCoreDampening)overdrawDampeningTable
+{
+    if (self.overdrawDampening == PKRevealControllerOverdrawDampeningCustom && self.customOverdrawDampening)
     {
-        case PKRevealControllerShowsFrontViewController:
-        {
-            center.x = CGRectGetMidX(self.view.bounds);
-        }
-            break;
-            
-        case PKRevealControllerShowsLeftViewController:
-        {
-            center.x = CGRectGetMidX(self.view.bounds) + [self leftViewMinWidth];
-        }
-            break;
-            
-        case PKRevealControllerShowsRightViewController:
-        {
-            center.x = CGRectGetMidX(self.view.bounds) - [self rightViewMinWidth];
-        }
-            break;
-            
-        case PKRevealControllerShowsLeftViewControllerInPresentationMode:
-        {
-            center.x = CGRectGetMidX(self.view.bounds) + [self leftViewMaxWidth];
-        }
-            break;
-            
-        case PKRevealControllerShowsRightViewControllerInPresentationMode:
-        {
-            center.x = CGRectGetMidX(self.view.bounds) - [self rightViewMaxWidth];
-        }
+        PKRevealCoreDampening dampening;
+        [self.customOverdrawDampening getBytes:&dampening length:sizeof(dampening)];
+        
+        return dampening;
     }
     
-    return center;
+    return PKRevealCoreDampeningMake((PKRevealCoreDampeningCurve)self.overdrawDampening, PKRevealCoreDampeningDefaultLimit);
 }
 
 - (CGFloat)leftViewMinWidth